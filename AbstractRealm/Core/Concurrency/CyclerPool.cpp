@@ -33,6 +33,13 @@ namespace Core::Concurrency
 
 	void CyclerPool::ActivateUnit()
 	{
+		// Status panel: column 0 belongs to the master cycler, units fill the remaining columns.
+		s16 row = s16(ActiveUnits % 4), col = s16(1 + ActiveUnits / 4);
+
+		if (col >= 4) row = col = Dev::Metric::NoStatusSlot;
+
+		Pool[ActiveUnits].Cycler.BindMetric(Dev::Register_Metric("Thread " + ToString(ActiveUnits + 1) + " Delta", Dev::EMetric::Timer, row, col));
+
 		Pool[ActiveUnits].Thread = OSAL::RequestThread(&Cycler::Initiate, &Pool[ActiveUnits].Cycler);
 
 		ActiveUnits++;
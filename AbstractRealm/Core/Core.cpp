@@ -5,6 +5,15 @@
 
 #include "ImGui_SAL.hpp"
 #include "MasterExecution.hpp"
+#include "IO/AsyncIO.hpp"
+#include "IO/BlockStream.hpp"
+#include "IO/DerivedDataCache.hpp"
+#include "IO/FileWatcher.hpp"
+#include "IO/PackArchive.hpp"
+#include "IO/Streaming.hpp"
+#include "IO/VFS.hpp"
+#include "Dev/Console.hpp"
+#include "Meta/Config/CoreDev_Config.hpp"
 #include "LAL/LAL.hpp"
 
 
@@ -51,6 +60,16 @@ namespace Core
 
 			if (TreeNode("IO"))
 			{
+				IO::AsyncIO_Record_EditorDevDebugUI();
+
+				IO::FileWatcher_Record_EditorDevDebugUI();
+
+				IO::DDC_Record_EditorDevDebugUI();
+
+				IO::Streaming_Record_EditorDevDebugUI();
+
+				IO::VFS_Record_EditorDevDebugUI();
+
 				TreePop();
 			}
 
@@ -67,8 +86,105 @@ namespace Core
 	}
 
 
+	// Content directory watch -> its mount.
+	UnorderedMap<IO::WatchID, IO::MountID> ContentWatches;
+
+	void Rescan_ChangedContent(const DynamicArray<IO::FileChange>& _changes)
+	{
+		DynamicArray<IO::MountID> changed;
+
+		for (auto& change : _changes)
+		{
+			auto found = ContentWatches.find(change.Watch);
+
+			if (found == ContentWatches.end()) continue;
+
+			if (std::find(changed.begin(), changed.end(), found->second) == changed.end()) changed.push_back(found->second);
+		}
+
+		// Once per mount for the whole batch.
+		for (IO::MountID mount : changed) IO::VFS_Rescan(mount);
+	}
+
+	void Cook_ContentPack()
+	{
+		IO::PackBuilder builder;
+
+		try
+		{
+			for (RoCStr directory : Meta::VFS_ContentDirectories)
+			{
+				if (CheckPathExists(directory)) builder.AddDirectory(directory, String(directory) + "/");
+			}
+
+			uDM files = builder.GetEntryCount();
+
+			std::filesystem::create_directories(Path(Meta::VFS_CookedPack).parent_path());
+
+			builder.Build(Meta::VFS_CookedPack);
+
+			Dev::CLog("Core: Cooked " + ToString(files) + " files into " + String(Meta::VFS_CookedPack));
+		}
+		catch (std::exception& _error)
+		{
+			// The loose content is still mounted.
+			Dev::CLog_Error(String("Core: Content cook failed: ") + _error.what());
+		}
+	}
+
+	void Mount_EngineContent()
+	{
+		if (Meta::VFS_CookContentOnLoad) Cook_ContentPack();
+
+		for (RoCStr directory : Meta::VFS_ContentDirectories)
+		{
+			if (!CheckPathExists(directory)) continue;
+
+			IO::MountID mount = IO::VFS_MountDirectory(directory, directory);
+
+			if (!Meta::FileWatcher_WatchContent) continue;
+
+			IO::WatchID watch = IO::FileWatcher_Watch(directory);
+
+			if (watch != IO::InvalidWatch) ContentWatches[watch] = mount;
+		}
+
+		if (!ContentWatches.empty()) IO::FileWatcher_Subscribe(Rescan_ChangedContent);
+
+		if (!CheckPathExists(Meta::VFS_PackDirectory)) return;
+
+		for (auto& entry : std::filesystem::directory_iterator(Meta::VFS_PackDirectory))
+		{
+			if (entry.path().extension() == ".pak") IO::VFS_MountPack("", entry.path(), 1);
+		}
+	}
+
+
 	void Load()
 	{
 		SAL::Imgui::Queue("Dev Debug", Record_EditorDevDebugUI);
+
+		IO::Load_BlockStream();
+
+		IO::Load_AsyncIO();
+
+		IO::Load_FileWatcher();
+
+		Mount_EngineContent();
+	}
+
+	void Unload()
+	{
+		IO::Unload_FileWatcher();
+
+		ContentWatches.clear();
+
+		// Before the IO service, which dispatches the cancelled streaming reads as it unloads.
+		IO::Unload_Streaming();
+
+		IO::Unload_AsyncIO();
+
+		// After the IO workers, their pack reads decode on it.
+		IO::Unload_BlockStream();
 	}
 }
\ No newline at end of file
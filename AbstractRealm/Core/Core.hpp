@@ -9,4 +9,6 @@
 namespace Core
 {
 	void Load();
+
+	void Unload();
 }
@@ -5,6 +5,11 @@
 
 // Engine
 #include "Meta/EngineInfo.hpp"
+#include "Meta/Config/CoreDev_Config.hpp"
+#include "Log.hpp"
+#include "LogFile.hpp"
+#include "LogJournal.hpp"
+#include "Metrics.hpp"
 #include "OSAL/OSAL_Console.hpp"
 #include "OSAL/OSAL_Timing.hpp"
 #include "IO/Basic_FileIO.hpp"
@@ -73,8 +78,9 @@ namespace Dev
 
 		StringStream DevLogStream;
 
-		File_OutputStream DevLogFileOut;
-		File_InputStream  DevLogFileIn ;
+		RotatingLogFile DevLogFile;
+
+		LogJournal DevLogJournal;
 
 		bool AutoUpdateConsole = false;
 	//)
@@ -90,6 +96,7 @@ namespace Dev
 	void Load_DevLogStream_Title  ();
 
 	void WriteTo_Buffer      (int _line,           ConslAttribFlags _flags);
+	void WriteTo_LogFile     (const String& _line);
 	void WriteTo_StatusModule(int _row , int _col, ConslAttribFlags _flags);
 
 
@@ -116,15 +123,9 @@ namespace Dev
 				Table2C::Entry(Args(StatusStart));
 				Table2C::Entry(Args(StatusColumnWidth));
 
-				StringStream dateStream;
-
-				auto dateSnapshot = OSAL::GetExecutionStartDate();
-
-				dateStream << put_time(&dateSnapshot, "%F_%I-%M-%S_%p");
+				Table2C::Entry("Log File", DevLogFile.GetPath().generic_string());
 
-				String logstr = String(DevLogPath) + String("/") + String(DevLogName) + String("__") + dateStream.str() + String(".txt");
-
-				Table2C::Entry("Log File", logstr);
+				Table2C::Entry("Log File Rotations", ToString(DevLogFile.GetRotations()));
 
 				Table2C::EndRecord();
 			}
@@ -168,10 +169,7 @@ namespace Dev
 
 		uDM lineLength = dateSig.str().size() + _info.size();
 
-		DevLogFileOut 
-			<< dateSig.str()
-			<< _info 
-			<< endl;
+		WriteTo_LogFile(dateSig.str() + _info);
 
 		if (lineLength > uDM(ConsoleWidth))
 		{
@@ -206,7 +204,7 @@ namespace Dev
 
 				String sub = _info.substr(0, ConsoleWidth);
 
-				DevLogFileOut << sub << endl;
+				WriteTo_LogFile(sub);
 
 				WriteTo_Buffer
 				(
@@ -274,11 +272,7 @@ namespace Dev
 
 		uDM lineLength = dateSig.str().size() + _info.size();
 
-		DevLogFileOut
-			<< dateSig.str()
-			<< "\n"
-			<< _info
-			<< endl;
+		WriteTo_LogFile(dateSig.str() + "\n" + _info);
 
 		if (lineLength > uDM(ConsoleWidth))
 		{
@@ -313,7 +307,7 @@ namespace Dev
 
 				String sub = _info.substr(0, ConsoleWidth);
 
-				DevLogFileOut << sub << endl;
+				WriteTo_LogFile(sub);
 
 				WriteTo_Buffer
 				(
@@ -523,6 +517,8 @@ namespace Dev
 	{
 		// Read from File up to buffer allows
 
+		Metrics_UpdateStatus();
+
 		// Status Update
 		for  (uDM y = 0; y < 4; y++)
 		{
@@ -599,8 +595,14 @@ namespace Dev
 	{
 		CLog("Unloading dev console (there will be no logs after this)");
 
-		DevLogFileOut.close(); 
-		DevLogFileIn .close(); 
+		DevLogFile.Close();
+
+		Log::CloseFiles();
+
+		DevLogJournal.Close();
+
+		// Rotated segments still being compressed are finished first.
+		LogFile_ShutdownWorker();
 	}
 
 
@@ -608,43 +610,56 @@ namespace Dev
 
 	void Load_DevLog_IOFileStream()
 	{
-		StringStream dateStream;
-
-		auto dateSnapshot = OSAL::GetExecutionStartDate();
-
-		dateStream << put_time(&dateSnapshot, "%F_%I-%M-%S_%p");
-
 		Path path = DevLogPath;
 
 		if (!CheckPathExists(path))
 		{
 			Create_Directories(path);
 		}
-		
-		using namespace Core::IO;
-
-		bool openResult = OpenFile
-		(
-			DevLogFileOut,
-			OpenFlags(EOpenFlag::ForOutput),
-			Path(String(DevLogPath) + String("/") + String(DevLogName) + String("__") + dateStream.str() + String(".txt"))
-		);
 
-		if (!openResult)
+		if constexpr (Meta::LogToFile)
 		{
-			throw RuntimeError("Failed to create a dev log file...");
-		}
+			// Old sessions are swept on the log file worker, not here.
+			LogFile_QueueRetention();
 
-		openResult = OpenFile
-		(
-			DevLogFileIn,
-			OpenFlags(EOpenFlag::ForInput),
-			Path(String(DevLogPath) + String("/") + String(DevLogName) + String("__") + dateStream.str() + String(".txt"))
-		);
+			String baseName = Meta::LogToFile_Mode == Meta::ELogToFileMode::Full ?
+				String("Global") : String(DevLogName) + String("__") + LogFile_SessionStamp();
+
+			if (!DevLogFile.Open(LogFile_SessionDirectory(), baseName))
+			{
+				throw RuntimeError("Failed to create a dev log file...");
+			}
+		}
 
-		if (!openResult)
+		if constexpr (Meta::LogToJournal)
 		{
-			throw RuntimeError("Failed to open a dev log file...");
+			using namespace Core::IO;
+
+			Path journalPath   = String(DevLogPath) + String("/") + String(DevLogName) + String(".journal"         );
+			Path previousPath  = String(DevLogPath) + String("/") + String(DevLogName) + String(".Previous.journal");
+			Path recoveredPath = String(DevLogPath) + String("/") + String(DevLogName) + String(".Previous.log"    );
+
+			if (CheckPathExists(journalPath))
+			{
+				Remove(previousPath);
+				Rename(journalPath, previousPath);
+
+				// The tail of the previous session as plain text, what it logged up to a crash.
+				// Empty when it shut down in order, a tail recovered from an earlier crash is not kept past it.
+				String tail = LogJournal::Recover(previousPath);
+
+				Remove(recoveredPath);
+
+				File_OutputStream recovered;
+
+				if (!tail.empty() && OpenFile(recovered, OpenFlags(EOpenFlag::ForOutput, EOpenFlag::DiscardStreamContents), recoveredPath))
+				{
+					recovered.write(tail.data(), std::streamsize(tail.size()));
+				}
+			}
+
+			// The journal is a safety net, the session can run without it.
+			DevLogJournal.Open(journalPath, Meta::LogJournal_Capacity);
 		}
 	}
 
@@ -729,7 +744,7 @@ namespace Dev
 
 		DevLogStream << setfill('-') << setw(ConsoleWidth) << '-';
 
-		DevLogFileOut << setfill('-') << setw(ConsoleWidth) << '-' << endl;
+		WriteTo_LogFile(DevLogStream.str());
 
 		WriteTo_Buffer
 		(
@@ -756,15 +771,7 @@ namespace Dev
 
 			<< setfill(' ') << setw(ConsoleWidth - DevLogStream.str().size()) << ' ';
 
-		DevLogFileOut 
-			<< "Abstract Realm: MVP Build - "
-			<< EEngineVersion::Major << "."
-			<< EEngineVersion::Minor << "."
-			<< EEngineVersion::Patch << "    "
-
-			<< "Dev Log: " << put_time(&OSAL::GetExecutionStartDate(), "%F %I:%M:%S %p") 
-
-			<< setfill(' ') << setw(ConsoleWidth - DevLogStream.str().size()) << ' ' << endl; 
+		WriteTo_LogFile(DevLogStream.str());
 
 		WriteTo_Buffer
 		(
@@ -782,7 +789,7 @@ namespace Dev
 
 		DevLogStream << setfill('-') << setw(ConsoleWidth) << '-';
 
-		DevLogFileOut << setfill('-') << setw(ConsoleWidth) << '-' << endl;
+		WriteTo_LogFile(DevLogStream.str());
 
 		WriteTo_Buffer
 		(
@@ -811,6 +818,16 @@ namespace Dev
 		}
 	}
 
+	void WriteTo_LogFile(const String& _line)
+	{
+		DevLogJournal.Append(_line);
+
+		DevLogFile.Write(_line);
+
+		// The journal keeps the tail if the process dies, otherwise every line has to reach the OS right away.
+		if (!DevLogJournal.IsOpen()) DevLogFile.Flush();
+	}
+
 	void WriteTo_StatusModule(int _row, int _col, ConslAttribFlags _flags)
 	{
 		auto str = StatusStreams[_row][_col].str();
@@ -8,6 +8,7 @@
 #include "Console.hpp"
 #include "ImGui_SAL.hpp"
 #include "Log.hpp"
+#include "Metrics.hpp"
 
 
 
@@ -24,6 +25,8 @@ namespace Dev
 		if (CollapsingHeader("Dev"))
 		{
 			Console_Record_EditorDevDebugUI();
+
+			Metrics_Record_EditorDevDebugUI();
 		}
 	}
 
@@ -5,6 +5,7 @@
 #include "Console.hpp"
 #include "EngineInfo.hpp"
 #include "ImGui_SAL.hpp"
+#include "Meta/Config/CoreDev_Config.hpp"
 #include "OSAL/OSAL_Timing.hpp"
 
 
@@ -17,14 +18,49 @@ namespace Dev
 
 	DynamicArray< UPtr<Log::RecordEntry>> Log::records;
 
+	StaticArray<Log::SubRecords, SeverityCount> Log::severityIndex;
 
-	Log::RecordEntry::RecordEntry(Severity _severity, String _category, String _message) :
-		index(indexCounter++), 
-		date(OSAL::GetTime_Local() ), 
-		severity(_severity), 
-		category(_category), 
+	UnorderedMap<String, Log::SubRecords> Log::termIndex;
+
+	UnorderedMap<String, Log::ViewFilter> Log::viewFilters;
+
+	UnorderedMap<String, UPtr<RotatingLogFile>> Log::subLogFiles;
+
+	bool Log::subLogFilesClosed = false;
+
+	Mutex Log::threadBuffersLock;
+
+	DynamicArray< SPtr<Log::ThreadBuffer> > Log::threadBuffers;
+
+	ThreadID Log::drainThread;
+
+
+	Log::RecordEntry::RecordEntry(Severity _severity, String _category, String _message, SysTimePoint _time, SteadyTimePoint _timestamp) :
+		index(indexCounter++),
+		timestamp(_timestamp),
+		date(),
+		severity(_severity),
+		category(_category),
 		message(_message)
-	{}
+	{
+		const Time timeSnap = SystemClock::to_time_t(_time);
+
+		OSAL::TimeLocal(&date, &timeSnap);
+
+		StringStream stream;
+
+		stream << index << " [" << put_time(&date, "%F %I:%M:%S %p") << "]  " << nameOf(severity) << ": ";
+
+		categoryStart = uDM(stream.tellp());
+
+		stream << category << ": ";
+
+		messageStart = uDM(stream.tellp());
+
+		stream << message;
+
+		line = stream.str();
+	}
 
 
 	Log::Log()
@@ -58,43 +94,80 @@ namespace Dev
 
 	void Log::Record(Severity _severity, String _message) const
 	{
-		records.push_back(MakeUPtr<RecordEntry>(_severity, name, _message));
+		Submit({ SteadyClock::now(), SystemClock::now(), _severity, name, move(_message), subRecordsRef });
+	}
+
+	void Log::GlobalRecord(Severity _severity, String _message)
+	{
+		Submit({ SteadyClock::now(), SystemClock::now(), _severity, "Global", move(_message), nullptr });
+	}
+
+	void Log::BindDrainThread()
+	{
+		drainThread = GetThreadID();
+	}
+
+	void Log::Drain()
+	{
+		if (GetThreadID() != drainThread) return;
 
-		subRecordsRef->push_back(records.back().get());
+		DynamicArray<PendingEntry> merged;
 
-		switch (_severity)
 		{
-			case Severity::Info:
+			ScopedLock registryGuard(threadBuffersLock);
+
+			for (auto buffer = threadBuffers.begin(); buffer != threadBuffers.end();)
 			{
-				CLog(name + ": " + _message);
+				uDM mergeStart = merged.size();
 
-			} break;
+				bool release;
 
-			case Severity::Error:
-			{
-				CLog_Error(name + ": " + _message);
+				{
+					ScopedLock bufferGuard((*buffer)->lock);
 
-			} break;
-		}
-	}
+					merged.insert(merged.end(), std::make_move_iterator((*buffer)->entries.begin()), std::make_move_iterator((*buffer)->entries.end()));
 
-	void Log::GlobalRecord(Severity _severity, String _message)
-	{
-		records.push_back(MakeUPtr<RecordEntry>(_severity, "Global", _message));
+					(*buffer)->entries.clear();
+
+					release = (*buffer)->retired;
+				}
+
+				// Every buffer is already in timestamp order, so each one only needs to be merged in.
+				std::inplace_merge
+				(
+					merged.begin(), merged.begin() + mergeStart, merged.end(),
 
-		switch (_severity)
+					[](const PendingEntry& _a, const PendingEntry& _b) { return _a.timestamp < _b.timestamp; }
+				);
+
+				buffer = release ? threadBuffers.erase(buffer) : buffer + 1;
+			}
+		}
+
+		for (auto& entry : merged)
 		{
-			case Severity::Info:
+			AddRecord(entry);
+
+			switch (entry.severity)
 			{
-				CLog(_message);
+				case Severity::Info:
+				{
+					if (entry.subRecords != nullptr)
+						CLog(entry.category + ": " + entry.message);
+					else
+						CLog(entry.message);
 
-			} break;
+				} break;
 
-			case Severity::Error:
-			{
-				CLog_Error(_message);
+				case Severity::Error:
+				{
+					if (entry.subRecords != nullptr)
+						CLog_Error(entry.category + ": " + entry.message);
+					else
+						CLog_Error(entry.message);
 
-			} break;
+				} break;
+			}
 		}
 	}
 
@@ -109,36 +182,14 @@ namespace Dev
 		using namespace SAL::Imgui;
 		using namespace LAL;
 
-		#define Args(_Entry) NameOf(_Entry).str(), _Entry
 
+		Drain();
 
 		if (ImGui::BeginTabBar("Log Tabs"))
 		{
-			ImVec2 scrolling_Size = ImVec2(0, ImGui::GetFrameHeightWithSpacing() * 10);
-
-			static StringStream dateSig; 
-			
 			if (ImGui::BeginTabItem("Global"))
 			{
-				BeginChild("Global Log", ImVec2(), true, ImGuiWindowFlags_HorizontalScrollbar);
-				
-				for (auto& record : records)
-				{
-					dateSig.str(String());
-
-					dateSig << "[" << put_time(&record->date, "%F %I:%M:%S %p") << "] ";
-
-					Text(String
-					(
-						ToString(record->index) + " " +
-						dateSig.str() + " " +
-						nameOf(record->severity).data()) + ": " + 
-						record->category + ": " + 
-						record->message
-					);
-				}
-
-				EndChild();
+				Record_LogView("Global Log", viewFilters["Global"], nullptr);
 
 				ImGui::EndTabItem();
 			}
@@ -147,30 +198,292 @@ namespace Dev
 			{
 				if (ImGui::BeginTabItem(sublog.first.c_str()))
 				{
-					BeginChild("Global Log", ImVec2(), true, ImGuiWindowFlags_HorizontalScrollbar);
+					Record_LogView(sublog.first.c_str(), viewFilters[sublog.first], getPtr(sublog.second));
 
-					for (auto& record : sublog.second)
-					{
-						dateSig.str(String());
+					ImGui::EndTabItem();
+				}
+			}
 
-						dateSig << "[" << put_time(&record->date, "%F %I:%M:%S %p") << "] ";
+			ImGui::EndTabBar();
+		}
+	}
 
-						Text(String
-						(
-							 ToString(record->index) + " " +
-							 dateSig.str() + " " +
-							 nameOf(record->severity).data()) + ": " + 
-							 record->message
-						);
-					}
 
-					EndChild();
+	void Log::CloseFiles()
+	{
+		for (auto& file : subLogFiles) file.second->Close();
 
-					ImGui::EndTabItem();
+		subLogFilesClosed = true;
+	}
+
+
+	// Protected
+
+	Log::ThreadBuffer& Log::LocalBuffer()
+	{
+		// Registered on the first record of a thread, retired (not destroyed) when the thread exits
+		// so that the drain still gets its last entries.
+		struct Registration
+		{
+			Registration() : buffer(MakeSPtr<ThreadBuffer>())
+			{
+				ScopedLock registryGuard(threadBuffersLock);
+
+				threadBuffers.push_back(buffer);
+			}
+
+			~Registration()
+			{
+				ScopedLock bufferGuard(buffer->lock);
+
+				buffer->retired = true;
+			}
+
+			SPtr<ThreadBuffer> buffer;
+		};
+
+		thread_local Registration registration;
+
+		return *registration.buffer;
+	}
+
+	void Log::Submit(PendingEntry&& _entry)
+	{
+		ThreadBuffer& buffer = LocalBuffer();
+
+		{
+			ScopedLock bufferGuard(buffer.lock);
+
+			buffer.entries.push_back(move(_entry));
+		}
+
+		Drain();
+	}
+
+	void Log::AddRecord(const PendingEntry& _entry)
+	{
+		uDM recordIndex = records.size();
+
+		records.push_back(MakeUPtr<RecordEntry>(_entry.severity, _entry.category, _entry.message, _entry.time, _entry.timestamp));
+
+		if (_entry.subRecords != nullptr) _entry.subRecords->push_back(recordIndex);
+
+		severityIndex[uDM(_entry.severity)].push_back(recordIndex);
+
+		IndexTerms(_entry.message, recordIndex);
+
+		if constexpr (Meta::LogToFile && Meta::LogToFile_Mode == Meta::ELogToFileMode::Full)
+		{
+			if (_entry.subRecords == nullptr || subLogFilesClosed) return;
+
+			UPtr<RotatingLogFile>& file = subLogFiles[_entry.category];
+
+			if (file == nullptr)
+			{
+				file = MakeUPtr<RotatingLogFile>();
+
+				file->Open(LogFile_SessionDirectory(), _entry.category);
+			}
+
+			file->Write(records.back()->line);
+		}
+	}
+
+	void Log::IndexTerms(const String& _message, uDM _recordIndex)
+	{
+		for (auto& term : Tokenize(_message))
+		{
+			SubRecords& postings = termIndex[term];
+
+			// A term repeated within the same message is only posted once.
+			if (postings.empty() || postings.back() != _recordIndex)
+			{
+				postings.push_back(_recordIndex);
+			}
+		}
+	}
+
+	DynamicArray<String> Log::Tokenize(const String& _text)
+	{
+		DynamicArray<String> terms;
+
+		String term;
+
+		for (char character : _text)
+		{
+			if (std::isalnum(u8(character)))
+			{
+				term.push_back(char(std::tolower(u8(character))));
+			}
+			else if (!term.empty())
+			{
+				terms.push_back(move(term));
+
+				term.clear();
+			}
+		}
+
+		if (!term.empty()) terms.push_back(move(term));
+
+		return terms;
+	}
+
+	void Log::UpdateFilter(ViewFilter& _filter, ptr<const SubRecords> _categoryRecords)
+	{
+		String search(_filter.search.data());
+
+		if (search != _filter.appliedSearch || _filter.severities != _filter.appliedSeverities)
+		{
+			_filter.appliedSearch     = search;
+			_filter.appliedSeverities = _filter.severities;
+			_filter.terms             = Tokenize(search);
+
+			_filter.matches.clear();
+
+			_filter.scanned = 0;
+		}
+
+		bool allSeverities = true;
+
+		for (bool severity : _filter.appliedSeverities) allSeverities &= severity;
+
+		_filter.filtered = !_filter.terms.empty() || !allSeverities;
+
+		if (!_filter.filtered || _filter.scanned == records.size()) return;
+
+		uDM from = _filter.scanned;
+
+		_filter.scanned = records.size();
+
+		// Resolve the postings of every term, the smallest one drives the scan.
+		DynamicArray< ptr<const SubRecords> > termPostings;
+
+		ptr<const SubRecords> candidates = _categoryRecords;
+
+		for (auto& term : _filter.terms)
+		{
+			auto found = termIndex.find(term);
+
+			// A term that was never recorded cannot match anything (yet).
+			if (found == termIndex.end()) return;
+
+			termPostings.push_back(getPtr(found->second));
+
+			if (candidates == nullptr || found->second.size() < candidates->size())
+			{
+				candidates = getPtr(found->second);
+			}
+		}
+
+		// Severity only filter: merge the tails of the selected severity postings.
+		if (candidates == nullptr)
+		{
+			uDM newStart = _filter.matches.size();
+
+			for (uDM severity = 0; severity < SeverityCount; severity++)
+			{
+				if (!_filter.appliedSeverities[severity]) continue;
+
+				const SubRecords& postings = severityIndex[severity];
+
+				_filter.matches.insert(_filter.matches.end(), std::lower_bound(postings.begin(), postings.end(), from), postings.end());
+			}
+
+			std::sort(_filter.matches.begin() + newStart, _filter.matches.end());
+
+			return;
+		}
+
+		auto Contains = [](ptr<const SubRecords> _postings, uDM _recordIndex)
+		{
+			return std::binary_search(_postings->begin(), _postings->end(), _recordIndex);
+		};
+
+		for (auto candidate = std::lower_bound(candidates->begin(), candidates->end(), from); candidate != candidates->end(); candidate++)
+		{
+			uDM recordIndex = *candidate;
+
+			if (!_filter.appliedSeverities[uDM(records[recordIndex]->severity)]) continue;
+
+			if (_categoryRecords != nullptr && candidates != _categoryRecords && !Contains(_categoryRecords, recordIndex)) continue;
+
+			bool hasAllTerms = true;
+
+			for (auto postings : termPostings)
+			{
+				if (postings != candidates && !Contains(postings, recordIndex))
+				{
+					hasAllTerms = false;
+
+					break;
 				}
 			}
 
-			ImGui::EndTabBar();
+			if (hasAllTerms) _filter.matches.push_back(recordIndex);
 		}
 	}
-}
\ No newline at end of file
+
+	void Log::Record_LogView(RoCStr _viewID, ViewFilter& _filter, ptr<const SubRecords> _categoryRecords)
+	{
+		using namespace SAL::Imgui;
+
+		ImGui::PushID(_viewID);
+
+		ImGui::InputTextWithHint("##Search", "Search terms", _filter.search.data(), _filter.search.size());
+
+		for (uDM severity = 0; severity < SeverityCount; severity++)
+		{
+			ImGui::SameLine();
+
+			ImGui::Checkbox(nameOf(Severity(severity)).data(), getPtr(_filter.severities[severity]));
+		}
+
+		UpdateFilter(_filter, _categoryRecords);
+
+		uDM count =
+			_filter.filtered            ? _filter.matches.size()  :
+			_categoryRecords != nullptr ? _categoryRecords->size() :
+			                              records.size()           ;
+
+		BeginChild(_viewID, ImVec2(), true, ImGuiWindowFlags_HorizontalScrollbar);
+
+		// Only the visible rows are submitted.
+		ImGuiListClipper clipper;
+
+		clipper.Begin(int(count));
+
+		while (clipper.Step())
+		{
+			for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
+			{
+				uDM recordIndex =
+					_filter.filtered            ? _filter.matches   [row] :
+					_categoryRecords != nullptr ? (*_categoryRecords)[row] :
+					                              uDM(row)                 ;
+
+				const RecordEntry& record = *records[recordIndex];
+
+				RoCStr line = record.line.data();
+
+				if (_categoryRecords == nullptr)
+				{
+					ImGui::TextUnformatted(line, line + record.line.size());
+				}
+				else
+				{
+					ImGui::TextUnformatted(line, line + record.categoryStart);
+
+					ImGui::SameLine(0.0f, 0.0f);
+
+					ImGui::TextUnformatted(line + record.messageStart, line + record.line.size());
+				}
+			}
+		}
+
+		clipper.End();
+
+		EndChild();
+
+		ImGui::PopID();
+	}
+}
@@ -2,6 +2,7 @@
 
 
 #include "LAL/LAL.hpp"
+#include "LogFile.hpp"
 //#include "OSAL/Timing.hpp"
 
 
@@ -18,6 +19,8 @@ namespace Dev
 		Error
 	};
 
+	constexpr uDM SeverityCount = uDM(Severity::Error) + 1;
+
 
 	// Add Editor Log Output
 
@@ -27,15 +30,23 @@ namespace Dev
 
 		struct RecordEntry
 		{
-			RecordEntry(Severity _severity, String _category, String _message);
+			RecordEntry(Severity _severity, String _category, String _message, SysTimePoint _time, SteadyTimePoint _timestamp);
 
 			static uDM indexCounter;
 
-			uDM          index;
-			CalendarDate date;
-			Severity     severity;
-			String       category;
-			String       message;
+			uDM             index;
+			SteadyTimePoint timestamp;
+			CalendarDate    date;
+			Severity        severity;
+			String          category;
+			String          message;
+
+			// Formatted once on record: "<index> [<date>] <severity>: <category>: <message>"
+			String line;
+
+			// Offsets into line. Sub-log views skip the category: [0, categoryStart) + [messageStart, end).
+			uDM categoryStart;
+			uDM messageStart;
 		};
 
 		Log();
@@ -44,24 +55,119 @@ namespace Dev
 
 		void Init(String _name);
 
+		/*
+		Can be called from any thread.
+
+		The entry goes into an append-only buffer owned by the calling thread, it only reaches
+		the records (and the console/file) when the drain thread merges the buffers.
+		Calls from the drain thread drain right away.
+		*/
 		void Record(Severity _severity, String _message) const;
 
+		/*
+		The calling thread becomes the only thread allowed to drain (the one running the UI and console).
+		*/
+		static void BindDrainThread();
+
+		/*
+		Moves the pending entries of every thread into the records, ordered by their steady clock timestamp.
+		Does nothing when not called from the drain thread.
+		*/
+		static void Drain();
+
 		static void Queue_DebugUI();
 
 		static void GlobalRecord(Severity _severity, String message);
 
 		static void Record_EditorDevDebugUI();
 
+		/*
+		Closes the per sub-log files (Full log to file mode), records drained afterwards are no longer written to them.
+		*/
+		static void CloseFiles();
+
 	protected:
 
-		using SubRecords = DynamicArray< ptr<RecordEntry>>;
+		// Posting list: ascending indices into records.
+		using SubRecords = DynamicArray<uDM>;
+
+		/*
+		Per tab view state for the debug UI.
+
+		The match list is only rebuilt when the query changes, otherwise only records
+		appended since the last frame are tested.
+		*/
+		struct ViewFilter
+		{
+			StaticArray<char, 128> search = {};
+
+			StaticArray<bool, SeverityCount> severities = { true, true, true, true };
+
+			String                           appliedSearch;
+			StaticArray<bool, SeverityCount> appliedSeverities = { true, true, true, true };
+
+			DynamicArray<String> terms;
+
+			DynamicArray<uDM> matches;
+
+			uDM  scanned  = 0;
+			bool filtered = false;
+		};
+
+		struct PendingEntry
+		{
+			SteadyTimePoint timestamp;
+			SysTimePoint    time;
+			Severity        severity;
+			String          category;
+			String          message;
+			ptr<SubRecords> subRecords;   // Null for global records.
+		};
+
+		struct ThreadBuffer
+		{
+			Mutex lock;   // Only ever shared between the owning thread and the drain, so it is practically uncontended.
+
+			DynamicArray<PendingEntry> entries;
+
+			bool retired = false;   // Owning thread exited, released once drained.
+		};
+
+		static ThreadBuffer& LocalBuffer();
+
+		static void Submit(PendingEntry&& _entry);
+
+		static void AddRecord(const PendingEntry& _entry);
+
+		static void IndexTerms(const String& _message, uDM _recordIndex);
+
+		static DynamicArray<String> Tokenize(const String& _text);
+
+		static void UpdateFilter(ViewFilter& _filter, ptr<const SubRecords> _categoryRecords);
+
+		static void Record_LogView(RoCStr _viewID, ViewFilter& _filter, ptr<const SubRecords> _categoryRecords);
 
 		String name;
 
 		ptr<SubRecords> subRecordsRef;
 
-		static UnorderedMap<String, SubRecords> subLogs; 
+		static UnorderedMap<String, SubRecords> subLogs;
 
 		static DynamicArray< UPtr<RecordEntry> > records;
+
+		// Inverted index
+		static StaticArray<SubRecords, SeverityCount> severityIndex;
+		static UnorderedMap<String, SubRecords>       termIndex;
+
+		static UnorderedMap<String, ViewFilter> viewFilters;
+
+		// Sub-log files, opened on the first record of a sub-log.
+		static UnorderedMap<String, UPtr<RotatingLogFile>> subLogFiles;
+		static bool                                         subLogFilesClosed;
+
+		// Per thread buffers
+		static Mutex                              threadBuffersLock;
+		static DynamicArray< SPtr<ThreadBuffer> > threadBuffers;
+		static ThreadID                           drainThread;
 	};
 }
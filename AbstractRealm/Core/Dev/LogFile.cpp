@@ -0,0 +1,314 @@
+// Parent Header
+#include "LogFile.hpp"
+
+
+
+// Engine
+#include "Console.hpp"
+#include "Meta/Config/CoreDev_Config.hpp"
+#include "IO/Basic_FileIO.hpp"
+#include "IO/Compression.hpp"
+#include "OSAL/OSAL_Timing.hpp"
+
+
+
+namespace Dev
+{
+	StaticData()
+
+		Mutex             WorkerLock  ;
+		ConditionVariable WorkerSignal;
+		Thread            WorkerThread;
+
+		Queue< Function<void()> > WorkerJobs;
+
+		bool WorkerExit = false;
+
+
+
+	// Forwards
+
+	void Queue_WorkerJob(Function<void()> _job);
+
+	void CompressLogFile(const Path& _file);
+
+
+
+	// RotatingLogFile
+
+	RotatingLogFile::~RotatingLogFile()
+	{
+		Close();
+	}
+
+	bool RotatingLogFile::Open(const Path& _directory, const String& _baseName)
+	{
+		Close();
+
+		if (!CheckPathExists(_directory))
+		{
+			Create_Directories(_directory);
+		}
+
+		directory  = _directory;
+		baseName   = _baseName;
+		activePath = _directory / (_baseName + ".txt");
+		rotations  = 0;
+
+		using namespace Core::IO;
+
+		if (!OpenFile(file, OpenFlags(EOpenFlag::ForOutput), activePath)) return false;
+
+		written  = 0;
+		openedAt = SteadyClock::now();
+
+		return true;
+	}
+
+	void RotatingLogFile::Close()
+	{
+		if (IsOpen()) file.close();
+	}
+
+	void RotatingLogFile::Write(StringView _line)
+	{
+		if (!IsOpen()) return;
+
+		bool full    = written > 0 && written + _line.size() + 1 > Meta::LogFile_MaxSize;
+		bool expired = SteadyClock::now() - openedAt >= Meta::LogFile_MaxAge;
+
+		if (full || expired) Rotate();
+
+		file.write(_line.data(), _line.size());
+
+		file.put('\n');
+
+		written += _line.size() + 1;
+	}
+
+	void RotatingLogFile::Flush()
+	{
+		if (IsOpen()) file.flush();
+	}
+
+	void RotatingLogFile::Rotate()
+	{
+		if (!IsOpen()) return;
+
+		file.close();
+
+		rotations++;
+
+		Path segment = SegmentPath(rotations);
+
+		// If the rename fails the segment is overwritten below, which still bounds the disk use.
+		if (Rename(activePath, segment))
+		{
+			Path expired = rotations > Meta::LogFile_KeepSegments ? SegmentPath(rotations - Meta::LogFile_KeepSegments) : Path();
+
+			Queue_WorkerJob
+			(
+				[segment, expired]()
+				{
+					if constexpr (Meta::LogFile_Compress) CompressLogFile(segment);
+
+					if (!expired.empty())
+					{
+						Remove(expired);
+						Remove(Path(expired) += ".lz4");
+					}
+				}
+			);
+		}
+
+		using namespace Core::IO;
+
+		OpenFile(file, OpenFlags(EOpenFlag::ForOutput), activePath);
+
+		written  = 0;
+		openedAt = SteadyClock::now();
+	}
+
+
+	// Protected
+
+	Path RotatingLogFile::SegmentPath(uDM _rotation) const
+	{
+		return directory / (baseName + "." + ToString(_rotation) + ".txt");
+	}
+
+
+
+	// Public
+
+	Path LogFile_SessionDirectory()
+	{
+		if constexpr (Meta::LogToFile_Mode == Meta::ELogToFileMode::Full)
+		{
+			return Path(DevLogPath) / (String(DevLogName) + "__" + LogFile_SessionStamp());
+		}
+		else
+		{
+			return Path(DevLogPath);
+		}
+	}
+
+	String LogFile_SessionStamp()
+	{
+		StringStream dateStream;
+
+		dateStream << put_time(&OSAL::GetExecutionStartDate(), "%F_%I-%M-%S_%p");
+
+		return dateStream.str();
+	}
+
+	void LogFile_QueueRetention()
+	{
+		Queue_WorkerJob
+		(
+			[directory = Path(DevLogPath), stamp = LogFile_SessionStamp()]()
+			{
+				using namespace std::filesystem;
+
+				const auto cutoff = file_time_type::clock::now() - std::chrono::hours(24 * Meta::LogFile_KeepDays);
+
+				std::error_code error;
+
+				DynamicArray<Path> expired, uncompressed, directories;
+
+				for (recursive_directory_iterator entry(directory, error), end; !error && entry != end; entry.increment(error))
+				{
+					const Path& path = entry->path();
+
+					if (entry->is_directory(error))
+					{
+						directories.push_back(path);
+
+						continue;
+					}
+
+					// Never touch the files of the running session.
+					if (path.generic_string().find(stamp) != String::npos) continue;
+
+					Path extension = path.extension();
+
+					if (extension != ".txt" && extension != ".lz4") continue;
+
+					if (entry->last_write_time(error) < cutoff)
+					{
+						expired.push_back(path);
+					}
+					else if (extension == ".txt")
+					{
+						uncompressed.push_back(path);
+					}
+				}
+
+				for (auto& path : expired) Remove(path);
+
+				if constexpr (Meta::LogFile_Compress)
+				{
+					for (auto& path : uncompressed) CompressLogFile(path);
+				}
+
+				// Session directories (Full mode) emptied by the sweep, deepest first.
+				for (auto path = directories.rbegin(); path != directories.rend(); path++)
+				{
+					if (is_empty(*path, error)) Remove(*path);
+				}
+			}
+		);
+	}
+
+	void LogFile_ShutdownWorker()
+	{
+		{
+			ScopedLock workerGuard(WorkerLock);
+
+			WorkerExit = true;
+		}
+
+		WorkerSignal.notify_one();
+
+		if (WorkerThread.joinable()) WorkerThread.join();
+
+		WorkerExit = false;
+	}
+
+
+
+	// Private
+
+	void Queue_WorkerJob(Function<void()> _job)
+	{
+		{
+			ScopedLock workerGuard(WorkerLock);
+
+			WorkerJobs.push(move(_job));
+
+			if (!WorkerThread.joinable())
+			{
+				WorkerThread = Thread
+				(
+					[]()
+					{
+						UniqueLock workerGuard(WorkerLock);
+
+						while (true)
+						{
+							WorkerSignal.wait(workerGuard, []() { return WorkerExit || !WorkerJobs.empty(); });
+
+							// Pending work is finished before exiting.
+							if (WorkerJobs.empty()) return;
+
+							Function<void()> job = move(WorkerJobs.front());
+
+							WorkerJobs.pop();
+
+							workerGuard.unlock();
+
+							job();
+
+							workerGuard.lock();
+						}
+					}
+				);
+			}
+		}
+
+		WorkerSignal.notify_one();
+	}
+
+	void CompressLogFile(const Path& _file)
+	{
+		using namespace Core::IO;
+
+		Path compressedPath = Path(_file) += ".lz4";
+		Path partialPath    = Path(_file) += ".lz4.partial";
+
+		// A log that cannot be read or written is left as is, the worker must not take the engine down.
+		try
+		{
+			FileBuffer contents = BufferFile(_file);
+
+			DynamicArray<u8> frame = LZ4_CompressFrame(RCast<const u8>(contents.data()), contents.size());
+
+			File_OutputStream output;
+
+			if (!OpenFile(output, OpenFlags(EOpenFlag::ForOutput, EOpenFlag::BinaryMode), partialPath)) return;
+
+			output.write(RCast<const char>(frame.data()), frame.size());
+
+			output.close();
+
+			if (!output) return;
+
+			// Only replace the plain segment once the compressed one is complete.
+			if (Rename(partialPath, compressedPath)) Remove(_file);
+		}
+		catch (const std::exception&)
+		{
+			Remove(partialPath);
+		}
+	}
+}
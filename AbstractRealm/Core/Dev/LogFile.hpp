@@ -0,0 +1,95 @@
+/*
+Log File
+
+A log file sink that rotates by size and age.
+
+The active segment is always <Directory>/<BaseName>.txt, a rotation renames it to <BaseName>.<N>.txt and starts a new one.
+Rotated segments are handed to a background worker that LZ4 compresses them (<BaseName>.<N>.txt.lz4, readable with lz4 -d)
+and enforces the retention limits of CoreDev_Config, so the logging thread only pays for a rename.
+*/
+
+
+
+#pragma once
+
+
+
+#include "LAL/LAL.hpp"
+
+
+
+namespace Dev
+{
+	using namespace LAL;
+
+
+	class RotatingLogFile
+	{
+	public:
+
+		RotatingLogFile() {}
+
+		~RotatingLogFile();
+
+		/*
+		Opens (truncates) the active segment, creating _directory if needed.
+		*/
+		bool Open(const Path& _directory, const String& _baseName);
+
+		void Close();
+
+		bool IsOpen() const { return file.is_open(); }
+
+		void Write(StringView _line);
+
+		void Flush();
+
+		/*
+		Closes the active segment, queues it for compression and starts a new one.
+		*/
+		void Rotate();
+
+		const Path& GetPath() const { return activePath; }
+
+		uDM GetRotations() const { return rotations; }
+
+	protected:
+
+		Path SegmentPath(uDM _rotation) const;
+
+		File_OutputStream file;
+
+		Path   directory ;
+		String baseName  ;
+		Path   activePath;
+
+		uDM             written   = 0;
+		uDM             rotations = 0;
+		SteadyTimePoint openedAt     ;
+	};
+
+
+	/*
+	The directory the log files of this session are written to.
+
+	GlobalOnly: The dev log directory.
+	Full      : A directory for the session named by the execution start date.
+	*/
+	Path LogFile_SessionDirectory();
+
+	/*
+	The stamp (execution start date) that names the files of this session.
+	*/
+	String LogFile_SessionStamp();
+
+	/*
+	Queues a sweep of the dev log directory on the worker: files past LogFile_KeepDays are removed,
+	plain log files of previous sessions are compressed.
+	*/
+	void LogFile_QueueRetention();
+
+	/*
+	Finishes the queued work and joins the worker. Must be called after every log file was closed.
+	*/
+	void LogFile_ShutdownWorker();
+}
@@ -0,0 +1,140 @@
+// Parent
+#include "LogJournal.hpp"
+
+
+
+#include <atomic>
+#include <cstring>
+
+
+
+namespace Dev
+{
+	// Public
+
+	LogJournal::~LogJournal()
+	{
+		Close();
+	}
+
+	bool LogJournal::Open(const Path& _path, uDM _capacity)
+	{
+		Close();
+
+		if (!OSAL::MapFile(_path, OSAL::EMapAccess::ReadWrite, sizeof(Header) + _capacity, mapping))
+		{
+			return false;
+		}
+
+		header   = RCast<Header>(mapping.Address);
+		ring     = RCast<char>(mapping.Address) + sizeof(Header);
+		capacity = _capacity;
+
+		header->Magic    = Magic    ;
+		header->Version  = Version  ;
+		header->Capacity = capacity ;
+		header->Cursor   = 0        ;
+		header->Entries  = 0        ;
+		header->Clean    = 0        ;
+
+		return true;
+	}
+
+	void LogJournal::Close()
+	{
+		if (!IsOpen()) return;
+
+		// Nothing is appended after this, the mark is never observed ahead of the last line.
+		std::atomic_thread_fence(std::memory_order_release);
+
+		header->Clean = 1;
+
+		OSAL::FlushMapping(mapping, 0, mapping.Size);
+
+		OSAL::UnmapFile(mapping);
+
+		header   = nullptr;
+		ring     = nullptr;
+		capacity = 0;
+	}
+
+	void LogJournal::Append(StringView _line)
+	{
+		if (!IsOpen()) return;
+
+		// Anything longer than the ring would only overwrite itself.
+		uDM size = std::min<uDM>(_line.size(), uDM(capacity - 1));
+
+		u64 cursor = header->Cursor;
+
+		Write(cursor       , _line.data(), size);
+		Write(cursor + size, "\n"        , 1   );
+
+		// The cursor must never be observed ahead of the bytes it covers.
+		std::atomic_thread_fence(std::memory_order_release);
+
+		header->Cursor   = cursor + size + 1;
+		header->Entries += 1;
+	}
+
+	String LogJournal::Recover(const Path& _path)
+	{
+		OSAL::FileMapping previous;
+
+		if (!OSAL::MapFile(_path, OSAL::EMapAccess::ReadOnly, 0, previous)) return String();
+
+		String result;
+
+		if (previous.Size >= sizeof(Header))
+		{
+			const Header& previousHeader = *RCast<Header>(previous.Address);
+
+			RoCStr previousRing = RCast<char>(previous.Address) + sizeof(Header);
+
+			bool valid =
+				previousHeader.Magic    == Magic                                &&
+				previousHeader.Version  == Version                              &&
+				previousHeader.Capacity >  0                                    &&
+				previousHeader.Capacity <= previous.Size - sizeof(Header)       &&
+				previousHeader.Clean    == 0                                    ;
+
+			if (valid)
+			{
+				u64 written = std::min(previousHeader.Cursor, previousHeader.Capacity);
+				u64 start   = (previousHeader.Cursor - written) % previousHeader.Capacity;
+				u64 first   = std::min(written, previousHeader.Capacity - start);
+
+				result.reserve(uDM(written));
+
+				result.append(previousRing + start, uDM(first          ));
+				result.append(previousRing        , uDM(written - first));
+
+				// Once wrapped, the oldest line is most likely partially overwritten.
+				if (previousHeader.Cursor > previousHeader.Capacity)
+				{
+					result.erase(0, result.find('\n') + 1);
+				}
+			}
+		}
+
+		OSAL::UnmapFile(previous);
+
+		return result;
+	}
+
+
+	// Protected
+
+	void LogJournal::Write(u64 _position, RoCStr _data, uDM _size)
+	{
+		uDM offset = uDM(_position % capacity);
+		uDM first  = std::min(_size, uDM(capacity) - offset);
+
+		memcpy(ring + offset, _data, first);
+
+		if (first < _size)
+		{
+			memcpy(ring, _data + first, _size - first);
+		}
+	}
+}
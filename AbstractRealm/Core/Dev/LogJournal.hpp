@@ -0,0 +1,79 @@
+/*
+Log Journal
+
+A crash safe log tail kept in a memory mapped file ring.
+
+Lines are copied straight into the mapped pages and the header's cursor is bumped after the copy.
+The pages belong to the OS page cache, so the tail survives a hard crash of the process without any per line flushing.
+
+Layout: [Header][Ring of Capacity bytes]
+The ring holds newline separated text, Cursor is the total number of bytes ever written (Cursor % Capacity is the write position).
+
+Close marks the journal clean, a journal found without the mark was left by a session that did not shut down in order.
+*/
+
+
+
+#pragma once
+
+
+
+#include "LAL/LAL.hpp"
+#include "OSAL/OSAL_FileMapping.hpp"
+
+
+
+namespace Dev
+{
+	using namespace LAL;
+
+
+	class LogJournal
+	{
+	public:
+
+		POD Header
+		{
+			u32 Magic;
+			u32 Version;
+			u64 Capacity;
+			u64 Cursor;
+			u64 Entries;
+			u64 Clean;     // Set by Close, after the last line.
+		};
+
+		static constexpr u32 Magic   = 0x4A4C5241;   // "ARLJ"
+		static constexpr u32 Version = 2;
+
+		LogJournal() {}
+
+		~LogJournal();
+
+		bool Open(const Path& _path, uDM _capacity);
+
+		/*
+		Marks the journal clean, called on orderly shutdown.
+		*/
+		void Close();
+
+		bool IsOpen() const { return header != nullptr; }
+
+		void Append(StringView _line);
+
+		/*
+		Reads a journal left behind by a previous session and returns its contents oldest first.
+		Returns an empty string if the file is not a valid journal, or the session closed it clean: there is nothing to recover.
+		*/
+		static String Recover(const Path& _path);
+
+	protected:
+
+		void Write(u64 _position, RoCStr _data, uDM _size);
+
+		OSAL::FileMapping mapping;
+
+		ptr<Header> header   = nullptr;
+		ptr<char>   ring     = nullptr;
+		u64         capacity = 0;
+	};
+}
@@ -0,0 +1,147 @@
+// Parent Header
+#include "Metrics.hpp"
+
+
+
+// Engine
+#include "Console.hpp"
+#include "ImGui_SAL.hpp"
+
+#include <cstring>
+
+
+
+namespace Dev
+{
+	StaticData()
+
+		constexpr uDM MaxMetrics = 128;
+
+		// Fixed storage so that readers never see a metric move.
+		StaticArray<Metric, MaxMetrics> Metrics;
+
+		Atomic<uDM> MetricsRegistered = 0;
+
+		Mutex RegistrationLock;
+
+
+
+	// Metric
+
+	f64 Metric::Get() const
+	{
+		u64 bits = value.load(std::memory_order_relaxed);
+
+		if (type == EMetric::Counter) return f64(bits);
+
+		f64 result;
+
+		memcpy(&result, &bits, sizeof(result));
+
+		return result;
+	}
+
+	String Metric::Format() const
+	{
+		switch (type)
+		{
+			case EMetric::Counter:
+			{
+				return ToString(value.load(std::memory_order_relaxed));
+			}
+			case EMetric::Timer:
+			{
+				return ToString(Get() * 1000.0) + " ms";
+			}
+			default:
+			{
+				return ToString(Get());
+			}
+		}
+	}
+
+	u64 Metric::ToBits(f64 _value)
+	{
+		u64 bits;
+
+		memcpy(&bits, &_value, sizeof(bits));
+
+		return bits;
+	}
+
+
+
+	// Public
+
+	ptr<Metric> Register_Metric(const String& _name, EMetric _type, s16 _statusRow, s16 _statusCol)
+	{
+		ScopedLock registrationGuard(RegistrationLock);
+
+		uDM count = MetricsRegistered.load(std::memory_order_relaxed);
+
+		for (uDM index = 0; index < count; index++)
+		{
+			if (Metrics[index].name == _name) return getPtr(Metrics[index]);
+		}
+
+		if (count == MaxMetrics)
+		{
+			throw RuntimeError("Register_Metric: Out of metric slots, registering: " + _name);
+		}
+
+		Metric& metric = Metrics[count];
+
+		metric.name      = _name     ;
+		metric.type      = _type     ;
+		metric.statusRow = _statusRow;
+		metric.statusCol = _statusCol;
+
+		// Publish only after the metric is fully written.
+		MetricsRegistered.store(count + 1, std::memory_order_release);
+
+		return getPtr(metric);
+	}
+
+	void Metrics_UpdateStatus()
+	{
+		uDM count = MetricsRegistered.load(std::memory_order_acquire);
+
+		for (uDM index = 0; index < count; index++)
+		{
+			const Metric& metric = Metrics[index];
+
+			if (!metric.HasStatusSlot()) continue;
+
+			CLog_Status(metric.GetName() + ": " + metric.Format(), metric.GetStatusRow(), metric.GetStatusCol());
+		}
+	}
+
+	void Metrics_ForEach(const Function<void(const Metric&)>& _visitor)
+	{
+		uDM count = MetricsRegistered.load(std::memory_order_acquire);
+
+		for (uDM index = 0; index < count; index++) _visitor(Metrics[index]);
+	}
+
+	void Metrics_Record_EditorDevDebugUI()
+	{
+		using namespace SAL::Imgui;
+
+		if (TreeNode("Metrics"))
+		{
+			if (Table2C::Record())
+			{
+				uDM count = MetricsRegistered.load(std::memory_order_acquire);
+
+				for (uDM index = 0; index < count; index++)
+				{
+					Table2C::Entry(Metrics[index].GetName(), Metrics[index].Format());
+				}
+
+				Table2C::EndRecord();
+			}
+
+			TreePop();
+		}
+	}
+}
@@ -0,0 +1,96 @@
+/*
+Metrics
+
+Typed runtime metrics registered once by name.
+
+Producers only do an atomic store (or add) on the hot path, formatting is left to whoever
+renders them (the console's status panel or the dev debug UI) at their own rate.
+*/
+
+
+
+#pragma once
+
+
+
+#include "LAL/LAL.hpp"
+
+
+
+namespace Dev
+{
+	using namespace LAL;
+
+
+	enum class EMetric
+	{
+		Counter,   // Monotonic count.
+		Gauge  ,   // Latest value.
+		Timer      // Latest duration sample, in seconds.
+	};
+
+
+	class Metric
+	{
+	public:
+
+		static constexpr s16 NoStatusSlot = -1;
+
+		Metric() {}
+
+		void Increment(u64 _amount = 1) { value.fetch_add(_amount, std::memory_order_relaxed); }
+
+		void Set(f64 _value) { value.store(ToBits(_value), std::memory_order_relaxed); }
+
+		void Record(Duration64 _sample) { Set(_sample.count()); }
+
+		f64 Get() const;
+
+		String Format() const;
+
+		const String& GetName() const { return name; }
+
+		EMetric GetType() const { return type; }
+
+		bool HasStatusSlot() const { return statusRow != NoStatusSlot; }
+
+		s16 GetStatusRow() const { return statusRow; }
+		s16 GetStatusCol() const { return statusCol; }
+
+	protected:
+
+		friend ptr<Metric> Register_Metric(const String& _name, EMetric _type, s16 _statusRow, s16 _statusCol);
+
+		static u64 ToBits(f64 _value);
+
+		String  name;
+		EMetric type = EMetric::Gauge;
+
+		s16 statusRow = NoStatusSlot;
+		s16 statusCol = NoStatusSlot;
+
+		// Counters hold the count, gauges and timers hold the bits of an f64.
+		Atomic<u64> value = 0;
+	};
+
+
+	/*
+	Returns the metric registered under _name, registering it on the first call.
+
+	The returned pointer stays valid for the lifetime of the process.
+	A status slot binds the metric to a cell of the console's status panel.
+	*/
+	ptr<Metric> Register_Metric(const String& _name, EMetric _type, s16 _statusRow = Metric::NoStatusSlot, s16 _statusCol = Metric::NoStatusSlot);
+
+	/*
+	Writes every metric bound to a status slot into the console's status panel.
+	*/
+	void Metrics_UpdateStatus();
+
+	/*
+	Visits every registered metric, in registration order.
+	*/
+	void Metrics_ForEach(const Function<void(const Metric&)>& _visitor);
+
+	void Metrics_Record_EditorDevDebugUI();
+}
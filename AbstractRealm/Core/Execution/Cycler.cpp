@@ -9,6 +9,7 @@ namespace Core::Execution
 
 	Cycler::Cycler() : 
 		executer     (nullptr), 
+		deltaMetric  (nullptr),
 		cycles       (1),
 		deltaTime    (), 
 		averageDelta (1),
@@ -33,6 +34,11 @@ namespace Core::Execution
 		executer = _executerToBind;
 	}
 
+	void Cycler::BindMetric(ptr<Dev::Metric> _deltaMetric)
+	{
+		deltaMetric = _deltaMetric;
+	}
+
 	Duration64 Cycler::GetAverageDelta() const 
 	{ 
 		return averageDelta; 
@@ -99,6 +105,8 @@ namespace Core::Execution
 			// https://android.developreference.com/article/24557849/Calculate+rolling+++moving+average+in+C%2B%2B
 			(averageDelta * alpha) + (deltaTime * (1.0L - alpha));
 
+		if (deltaMetric != nullptr) deltaMetric->Record(deltaTime);
+
 		cycles++;
 	}
 
@@ -5,6 +5,7 @@
 // Engine
 #include "LAL/LAL.hpp"
 #include "Execution/Executer.hpp"
+#include "Dev/Metrics.hpp"
 
 
 
@@ -41,6 +42,9 @@ namespace Core::Execution
 
 		void BindExecuter(ptr<AExecuter> _executerToBind);
 
+		// The cycle's delta time gets published to the metric every cycle.
+		void BindMetric(ptr<Dev::Metric> _deltaMetric);
+
 		Duration64 GetAverageDelta() const;   // { return averageDelta; }
 		f64        GetCycle       () const;   // { return cycles      ; }
 		Duration64 GetDeltaTime   () const;   // { return deltaTime   ; }
@@ -59,6 +63,8 @@ namespace Core::Execution
 
 		ptr<AExecuter> executer;
 
+		ptr<Dev::Metric> deltaMetric;
+
 		f64 cycles;
 
 		Duration64 deltaTime, averageDelta, interval, deltaInterval;
@@ -14,10 +14,62 @@
 #include "ImGui_SAL.hpp"
 #include "PAL/PAL.hpp"
 #include "Core.hpp"
+#include "Dev/Log.hpp"
+#include "Dev/Console.hpp"
+#include "Dev/Metrics.hpp"
+#include "IO/Serialization.hpp"
 #include "Renderer/Renderer.hpp"
 
 
 
+namespace Core::Execution
+{
+	using namespace LAL;
+
+
+
+	struct MetricSample
+	{
+		String Name ;
+		f64    Value;
+	};
+
+	/*
+	What the engine was doing when it went down, dumped as JSON next to the dev log.
+	*/
+	struct EngineStateSnapshot
+	{
+		u32    VersionMajor;
+		u32    VersionMinor;
+		u32    VersionPatch;
+		String Error       ;
+
+		f64 MasterCycle       ;
+		f64 MasterDelta       ;
+		f64 MasterAverageDelta;
+
+		DynamicArray<MetricSample> Metrics;
+	};
+}
+
+ReflectType(Core::Execution::MetricSample, 1)
+	ReflectField(Name )
+	ReflectField(Value)
+ReflectEnd()
+
+ReflectType(Core::Execution::EngineStateSnapshot, 1)
+	ReflectField(VersionMajor      )
+	ReflectField(VersionMinor      )
+	ReflectField(VersionPatch      )
+	ReflectField(Error             )
+	ReflectField(MasterCycle       )
+	ReflectField(MasterDelta       )
+	ReflectField(MasterAverageDelta)
+	ReflectField(Metrics           )
+ReflectEnd()
+
+
+
 namespace Core::Execution
 {
 	// Usings
@@ -59,6 +111,8 @@ namespace Core::Execution
 		Dev::CLog_Error("Core-Execution: " + _info);
 	}
 
+	void Dump_EngineState(const String& _error);
+
 	
 
 	// Public
@@ -67,6 +121,9 @@ namespace Core::Execution
 	{
 		Meta::LoadModule();
 
+		// Logs from every thread are merged on this one.
+		Dev::Log::BindDrainThread();
+
 		try
 		{
 			if (UseDebug())
@@ -106,6 +163,8 @@ namespace Core::Execution
 
 			Renderer::Unload();	
 
+			Core::Unload();
+
 			OSAL::Unload();
 
 			if (UseDebug())
@@ -119,11 +178,52 @@ namespace Core::Execution
 		{
 			CLog_Error(e.what());
 
+			if (Dump_EngineStateJson_OnCrash) Dump_EngineState(e.what());
+
 			Dev::Console_UpdateBuffer();
 		}
 
 		return OSAL::ExitValT(EExitCode::Success);
 	}
+
+
+
+	// Private
+
+	void Dump_EngineState(const String& _error)
+	{
+		EngineStateSnapshot snapshot;
+
+		snapshot.VersionMajor = EEngineVersion::Major;
+		snapshot.VersionMinor = EEngineVersion::Minor;
+		snapshot.VersionPatch = EEngineVersion::Patch;
+		snapshot.Error        = _error;
+
+		const Cycler& master = Get_MasterCycler();
+
+		snapshot.MasterCycle        = master.GetCycle       ();
+		snapshot.MasterDelta        = master.GetDeltaTime   ().count();
+		snapshot.MasterAverageDelta = master.GetAverageDelta().count();
+
+		Dev::Metrics_ForEach([&snapshot](const Dev::Metric& _metric)
+		{
+			snapshot.Metrics.push_back({ _metric.GetName(), _metric.Get() });
+		});
+
+		Path file = Path(Dev::DevLogPath) / "EngineState.json";
+
+		try
+		{
+			IO::Save_Json(file, snapshot);
+
+			CLog("Engine state dumped to " + file.generic_string());
+		}
+		catch (std::exception& _dumpError)
+		{
+			// Already going down, the original error is what matters.
+			CLog_Error(String("Engine state dump failed: ") + _dumpError.what());
+		}
+	}
 }
 
 
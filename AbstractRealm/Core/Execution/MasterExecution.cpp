@@ -5,6 +5,10 @@
 // Engine
 #include "Cycler.hpp"
 #include "Concurrency/CyclerPool.hpp"
+#include "Dev/Log.hpp"
+#include "IO/AsyncIO.hpp"
+#include "IO/FileWatcher.hpp"
+#include "IO/Streaming.hpp"
 #include "Meta/EngineInfo.hpp"
 #include "Renderer/Renderer.hpp"
 
@@ -22,6 +26,10 @@ namespace Core::Execution
 
 	Cycler MasterCycler;
 
+	// Status panel column 0.
+	ptr<Dev::Metric> RenderDeltaMetric  = nullptr;
+	ptr<Dev::Metric> ConsoleDeltaMetric = nullptr;
+
 
 	void MainCycle();
 
@@ -37,6 +45,11 @@ namespace Core::Execution
 
 		MasterCycler.BindExecuter(MasterExecuter);
 
+		MasterCycler.BindMetric(Dev::Register_Metric("Master Delta", Dev::EMetric::Timer, 0, 0));
+
+		RenderDeltaMetric  = Dev::Register_Metric("Render Delta" , Dev::EMetric::Timer, 1, 0);
+		ConsoleDeltaMetric = Dev::Register_Metric("Console Delta", Dev::EMetric::Timer, 2, 0);
+
 		//MasterCycler.AssignInterval(Duration64(1.0 / 1036.0));
 
 		//std::chrono::seconds sec(1);
@@ -54,34 +67,27 @@ namespace Core::Execution
 
 		OSAL::PollEvents();
 
+		// Async reads complete on the master cycler.
+		IO::AsyncIO_DispatchCompletions();
+
+		// As are the debounced file changes (hot reload).
+		IO::FileWatcher_DispatchEvents();
+
+		// With this cycle's completions in, rank and issue the streamed reads.
+		IO::Streaming_Update();
+
 		unbound Duration64 consoleUpdateDelta(0), consoleUpdateInterval(1.0 / 30.0);
 		unbound Duration64 renderPresentDelta(0);
 
 		if (consoleUpdateDelta >= consoleUpdateInterval)
 		{
+			// Pick up what the cycler pool threads logged since the last update.
+			Dev::Log::Drain();
 
-			Dev::CLog_Status("Master    Delta: " + ToString(MasterCycler.GetDeltaTime().count()), 0, 0);
-			Dev::CLog_Status("Render    Delta: " + ToString(renderPresentDelta.count()), 1, 0);
-
-			if (Concurrency::CyclerPool::GetNumUnits() > 0)
-			{
-				for (u16 row = 1, col = 0, cycleIndex = 0; cycleIndex < CyclerPool::GetNumUnits(); cycleIndex++)
-				{
-					Dev::CLog_Status("Thread 1  Delta: " + ToString(CyclerPool::GetCycler(cycleIndex).GetDeltaTime().count()), row++, col);
-
-					if (row == 4)
-					{
-						row = 0; col++;
-					}
-
-					if (col == 4) break;
-				}
-			}
+			ConsoleDeltaMetric->Record(consoleUpdateDelta);
 
 			Dev::Console_UpdateBuffer();
 
-			Dev::CLog_Status("Console   Delta: " + ToString(consoleUpdateDelta.count()), 2, 0);
-
 			consoleUpdateDelta = Duration64(0);
 		}
 		else
@@ -91,6 +97,8 @@ namespace Core::Execution
 
 		if (renderPresentDelta >= Renderer::Get_PresentInterval())
 		{
+			RenderDeltaMetric->Record(renderPresentDelta);
+
 			switch (GPU_API())
 			{
 				case Meta::EGPUPlatformAPI::BGFX:
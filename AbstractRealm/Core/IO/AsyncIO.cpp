@@ -0,0 +1,510 @@
+// Parent Header
+#include "AsyncIO.hpp"
+
+
+
+// Engine
+#include "Meta/Config/CoreDev_Config.hpp"
+#include "Dev/Metrics.hpp"
+#include "ImGui_SAL.hpp"
+#include "OSAL/OSAL_ReadRing.hpp"
+
+
+
+namespace Core::IO
+{
+	// Private
+
+	constexpr uDM PriorityCount = uDM(EIOPriority::Low) + 1;
+
+	// Largest single read submitted to the ring, the rest of a larger one is submitted as it completes.
+	constexpr uDM RingReadChunk = uDM(1) << 30;
+
+	/*
+	A read submitted to the OS read ring, completed by the reaper.
+	*/
+	struct RingRead
+	{
+		ReadRequest        Request;
+		ReadResult         Result ;
+		OSAL::ReadRingFile File   ;
+
+		uDM Done = 0;   // Bytes read so far.
+	};
+
+	StaticData()
+
+		Mutex             RequestLock  ;
+		ConditionVariable RequestSignal;
+
+		// One FIFO per priority, the workers always take from the most urgent non-empty one.
+		StaticArray<Deque<IORequestID>, PriorityCount> RequestQueues;
+
+		UnorderedMap<IORequestID, ReadRequest> Pending;
+
+		IORequestID NextID = 1;
+
+		uDM Reading = 0;
+
+		bool Exit = false;
+
+		DynamicArray<Thread> Workers;
+
+		Mutex                                                  CompletionLock;
+		DynamicArray< std::pair<ReadResult, Function<void(ReadResult&)>> > Completions;
+
+		ptr<Dev::Metric> BytesReadMetric = nullptr;
+		ptr<Dev::Metric> ReadsMetric     = nullptr;
+
+		// Open when the OS has one, the workers submit to it and the reaper completes.
+		OSAL::ReadRing Ring;
+
+		Mutex                               RingLock ;   // One submitter at a time, guards the reads.
+		UnorderedMap<IORequestID, RingRead> RingReads;
+
+		bool RingExit = false;
+
+		Thread Reaper;
+
+
+
+	// Forwards
+
+	void Worker();
+
+	void Complete(ReadResult&& _result, Function<void(ReadResult&)>&& _callback);
+
+	void ReadRange(const ReadRequest& _request, ReadResult& _result);
+
+	void ReadSource(const ReadRequest& _request, ReadResult& _result);
+
+	bool SubmitToRing(IORequestID _id, ReadRequest& _request);
+
+	void ReapRing();
+
+
+
+	// Public
+
+	void Load_AsyncIO(u32 _workers)
+	{
+		if (!Workers.empty()) return;
+
+		BytesReadMetric = Dev::Register_Metric("IO Bytes Read", Dev::EMetric::Counter);
+		ReadsMetric     = Dev::Register_Metric("IO Reads"     , Dev::EMetric::Counter);
+
+		if (_workers == 0) _workers = Meta::AsyncIO_Workers;
+
+		Exit = false;
+
+		if (Meta::AsyncIO_UseReadRing && OSAL::OpenReadRing(Meta::AsyncIO_ReadRingDepth, Ring))
+		{
+			RingExit = false;
+
+			Reaper = Thread(ReapRing);
+		}
+
+		for (u32 index = 0; index < _workers; index++)
+		{
+			Workers.push_back(Thread(Worker));
+		}
+	}
+
+	void Unload_AsyncIO()
+	{
+		DynamicArray<IORequestID> queued;
+
+		{
+			ScopedLock requestGuard(RequestLock);
+
+			for (auto& queue : RequestQueues) queued.insert(queued.end(), queue.begin(), queue.end());
+		}
+
+		for (IORequestID id : queued) AsyncIO_Cancel(id);
+
+		{
+			ScopedLock requestGuard(RequestLock);
+
+			Exit = true;
+		}
+
+		RequestSignal.notify_all();
+
+		for (auto& worker : Workers) worker.join();
+
+		Workers.clear();
+
+		// Nothing submits anymore, the reaper finishes the reads on the ring and leaves.
+		if (Reaper.joinable())
+		{
+			{
+				ScopedLock ringGuard(RingLock);
+
+				RingExit = true;
+
+				OSAL::WakeReadRing(Ring);
+			}
+
+			Reaper.join();
+
+			OSAL::CloseReadRing(Ring);
+		}
+
+		AsyncIO_DispatchCompletions();
+	}
+
+	IORequestID AsyncIO_Read(ReadRequest&& _request)
+	{
+		DynamicArray<ReadRequest> batch;
+
+		batch.push_back(move(_request));
+
+		return AsyncIO_Submit(move(batch)).front();
+	}
+
+	DynamicArray<IORequestID> AsyncIO_Submit(DynamicArray<ReadRequest>&& _requests)
+	{
+		DynamicArray<IORequestID> ids;
+
+		ids.reserve(_requests.size());
+
+		{
+			ScopedLock requestGuard(RequestLock);
+
+			for (auto& request : _requests)
+			{
+				IORequestID id = NextID++;
+
+				RequestQueues[uDM(request.Priority)].push_back(id);
+
+				Pending.emplace(id, move(request));
+
+				ids.push_back(id);
+			}
+		}
+
+		RequestSignal.notify_all();
+
+		return ids;
+	}
+
+	bool AsyncIO_Cancel(IORequestID _id)
+	{
+		ReadRequest request;
+
+		{
+			ScopedLock requestGuard(RequestLock);
+
+			auto found = Pending.find(_id);
+
+			if (found == Pending.end()) return false;
+
+			request = move(found->second);
+
+			Pending.erase(found);
+
+			auto& queue = RequestQueues[uDM(request.Priority)];
+
+			queue.erase(std::find(queue.begin(), queue.end(), _id));
+		}
+
+		Complete({ _id, request.File, EIOStatus::Cancelled, {}, String() }, move(request.OnComplete));
+
+		return true;
+	}
+
+	uDM AsyncIO_DispatchCompletions()
+	{
+		DynamicArray< std::pair<ReadResult, Function<void(ReadResult&)>> > finished;
+
+		{
+			ScopedLock completionGuard(CompletionLock);
+
+			finished.swap(Completions);
+		}
+
+		for (auto& completion : finished)
+		{
+			if (completion.second) completion.second(completion.first);
+		}
+
+		return finished.size();
+	}
+
+	uDM AsyncIO_InFlight()
+	{
+		ScopedLock requestGuard(RequestLock);
+
+		return Pending.size() + Reading;
+	}
+
+	void AsyncIO_Record_EditorDevDebugUI()
+	{
+		using namespace SAL::Imgui;
+
+		if (Table2C::Record())
+		{
+			Table2C::Entry("Async IO Workers", ToString(Workers.size()));
+			Table2C::Entry("Reads In Flight" , ToString(AsyncIO_InFlight()));
+			Table2C::Entry("Read Ring"       , Ring.Depth != 0 ? "Depth " + ToString(Ring.Depth) : String("Off"));
+
+			Table2C::EndRecord();
+		}
+	}
+
+
+
+	// Private
+
+	void Worker()
+	{
+		UniqueLock requestGuard(RequestLock);
+
+		while (true)
+		{
+			RequestSignal.wait(requestGuard, []() { return Exit || !Pending.empty(); });
+
+			if (Exit && Pending.empty()) return;
+
+			IORequestID id = 0;
+
+			// Cancelling takes the id off its queue, every queued id is pending.
+			for (auto& queue : RequestQueues)
+			{
+				if (queue.empty()) continue;
+
+				id = queue.front();
+
+				queue.pop_front();
+
+				break;
+			}
+
+			if (id == 0) continue;
+
+			ReadRequest request = move(Pending.at(id));
+
+			Pending.erase(id);
+
+			Reading++;
+
+			requestGuard.unlock();
+
+			// Completed by the reaper, which also takes it off Reading.
+			if (!request.Source && Ring.Depth != 0 && SubmitToRing(id, request))
+			{
+				requestGuard.lock();
+
+				continue;
+			}
+
+			ReadResult result { id, request.File, EIOStatus::Completed, {}, String() };
+
+			if (request.Source) ReadSource(request, result);
+			else                ReadRange (request, result);
+
+			Complete(move(result), move(request.OnComplete));
+
+			requestGuard.lock();
+
+			Reading--;
+		}
+	}
+
+	void Complete(ReadResult&& _result, Function<void(ReadResult&)>&& _callback)
+	{
+		ScopedLock completionGuard(CompletionLock);
+
+		Completions.emplace_back(move(_result), move(_callback));
+	}
+
+	void ReadRange(const ReadRequest& _request, ReadResult& _result)
+	{
+		File_InputStream file(_request.File, std::ios::binary | std::ios::ate);
+
+		if (!file.is_open())
+		{
+			_result.Status = EIOStatus::Failed;
+			_result.Error  = "Failed to open file at: " + _request.File.generic_string();
+
+			return;
+		}
+
+		uDM fileSize = uDM(file.tellg());
+
+		if (_request.Offset > fileSize)
+		{
+			_result.Status = EIOStatus::Failed;
+			_result.Error  = "Read offset past the end of: " + _request.File.generic_string();
+
+			return;
+		}
+
+		uDM size = _request.Size == 0 ? fileSize - _request.Offset : std::min(_request.Size, fileSize - _request.Offset);
+
+		_result.Data.resize(size);
+
+		file.seekg(std::streamoff(_request.Offset));
+
+		file.read(RCast<char>(_result.Data.data()), std::streamsize(size));
+
+		if (uDM(file.gcount()) != size)
+		{
+			_result.Status = EIOStatus::Failed;
+			_result.Error  = "Short read of: " + _request.File.generic_string();
+
+			_result.Data.clear();
+
+			return;
+		}
+
+		BytesReadMetric->Increment(size);
+		ReadsMetric    ->Increment();
+	}
+
+	void ReadSource(const ReadRequest& _request, ReadResult& _result)
+	{
+		try
+		{
+			_request.Source(_result);
+		}
+		catch (RuntimeError& _error)
+		{
+			_result.Status = EIOStatus::Failed;
+			_result.Error  = _error.what();
+
+			_result.Data.clear();
+
+			return;
+		}
+
+		BytesReadMetric->Increment(_result.Data.size());
+		ReadsMetric    ->Increment();
+	}
+
+	bool SubmitToRing(IORequestID _id, ReadRequest& _request)
+	{
+		RingRead read;
+
+		// Failures to open or a bad range are reported by the blocking read.
+		if (!OSAL::OpenRingFile(_request.File, read.File)) return false;
+
+		uDM fileSize = uDM(read.File.Size);
+
+		uDM size = _request.Offset > fileSize ? 0 : _request.Size == 0 ? fileSize - _request.Offset : std::min(_request.Size, fileSize - _request.Offset);
+
+		if (size == 0)
+		{
+			OSAL::CloseRingFile(read.File);
+
+			return false;
+		}
+
+		read.Result = { _id, _request.File, EIOStatus::Completed, {}, String() };
+
+		read.Result.Data.resize(size);
+
+		ScopedLock ringGuard(RingLock);
+
+		if (RingReads.size() >= Ring.Depth)
+		{
+			OSAL::CloseRingFile(read.File);
+
+			return false;
+		}
+
+		// Nodes are stable, the ring writes into the result's data in place.
+		RingRead& submitted = RingReads.emplace(_id, move(read)).first->second;
+
+		submitted.Request = move(_request);
+
+		bool queued = OSAL::SubmitRead
+		(
+			Ring, submitted.File,
+			submitted.Request.Offset, submitted.Result.Data.data(), u32(std::min(size, RingReadChunk)),
+			_id
+		);
+
+		if (!queued)
+		{
+			_request = move(submitted.Request);
+
+			OSAL::CloseRingFile(submitted.File);
+
+			RingReads.erase(_id);
+		}
+
+		return queued;
+	}
+
+	void ReapRing()
+	{
+		DynamicArray<OSAL::ReadRingCompletion> completions;
+
+		while (true)
+		{
+			completions.clear();
+
+			OSAL::ReapReads(Ring, completions, true);
+
+			for (auto& completion : completions)
+			{
+				if (completion.Tag == OSAL::ReadRing_WakeTag) continue;
+
+				RingRead read;
+
+				{
+					ScopedLock ringGuard(RingLock);
+
+					RingRead& inFlight = RingReads.at(completion.Tag);
+
+					uDM size = inFlight.Result.Data.size();
+
+					if (completion.Result > 0) inFlight.Done += uDM(completion.Result);
+
+					// Reads may complete short, the rest is submitted from where it stopped.
+					if (completion.Result > 0 && inFlight.Done < size)
+					{
+						bool queued = OSAL::SubmitRead
+						(
+							Ring, inFlight.File,
+							inFlight.Request.Offset + inFlight.Done, inFlight.Result.Data.data() + inFlight.Done, u32(std::min(size - inFlight.Done, RingReadChunk)),
+							completion.Tag
+						);
+
+						if (queued) continue;
+					}
+
+					read = move(inFlight);
+
+					RingReads.erase(completion.Tag);
+				}
+
+				OSAL::CloseRingFile(read.File);
+
+				if (read.Done != read.Result.Data.size())
+				{
+					read.Result.Status = EIOStatus::Failed;
+					read.Result.Error  = (completion.Result < 0 ? "Failed reading: " : "Short read of: ") + read.Request.File.generic_string();
+
+					read.Result.Data.clear();
+				}
+				else
+				{
+					BytesReadMetric->Increment(read.Done);
+					ReadsMetric    ->Increment();
+				}
+
+				Complete(move(read.Result), move(read.Request.OnComplete));
+
+				ScopedLock requestGuard(RequestLock);
+
+				Reading--;
+			}
+
+			ScopedLock ringGuard(RingLock);
+
+			if (RingExit && RingReads.empty()) return;
+		}
+	}
+}
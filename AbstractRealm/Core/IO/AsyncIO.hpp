@@ -0,0 +1,123 @@
+/*
+	Async IO
+
+	Asynchronous file reads serviced by a pool of IO worker threads.
+
+	Requests are queued by priority (then submission order) and any number of them can be in flight.
+	Completions are not run on the workers: they are queued until the owning cycler pumps them with
+	AsyncIO_DispatchCompletions (the master cycler does so every cycle), so callbacks run on a known thread
+	and can touch engine state without locking.
+
+	Where the OS has a read ring (io_uring on Linux) plain file reads are submitted to it, the workers only
+	open and submit them and a reaper thread completes them. Elsewhere, on a full ring, or for reads with a
+	Source, the workers read with blocking calls.
+*/
+
+
+
+#pragma once
+
+
+
+// Engine
+#include "LAL/LAL.hpp"
+
+
+
+namespace Core::IO
+{
+	using namespace LAL;
+
+
+
+	// Enums
+
+	enum class EIOPriority : u8
+	{
+		Critical,   // Blocking the current frame.
+		High    ,
+		Normal  ,
+		Low         // Prefetch / speculative.
+	};
+
+	enum class EIOStatus : u8
+	{
+		Completed,
+		Failed   ,
+		Cancelled
+	};
+
+
+
+	// Structs
+
+	using IORequestID = u64;
+
+	struct ReadResult
+	{
+		IORequestID      ID;
+		Path             File;
+		EIOStatus        Status;
+		DynamicArray<u8> Data;
+		String           Error;
+	};
+
+	struct ReadRequest
+	{
+		Path File;
+
+		uDM Offset = 0;
+		uDM Size   = 0;   // 0 reads to the end of the file.
+
+		EIOPriority Priority = EIOPriority::Normal;
+
+		/*
+		When set, run on the worker to fill the result's data instead of reading File (packed or other virtual content).
+		File is then only reported. A RuntimeError it throws fails the read.
+		*/
+		Function<void(ReadResult&)> Source;
+
+		Function<void(ReadResult&)> OnComplete;
+	};
+
+
+
+	// Functions
+
+	/*
+	Starts the IO workers, _workers of 0 uses Meta::AsyncIO_Workers.
+	*/
+	void Load_AsyncIO(u32 _workers = 0);
+
+	/*
+	Cancels the queued reads, waits for the ones in flight and dispatches every completion left.
+	*/
+	void Unload_AsyncIO();
+
+	IORequestID AsyncIO_Read(ReadRequest&& _request);
+
+	/*
+	Queues a batch of reads with a single wake up of the workers.
+	Returns the ids in the order of _requests.
+	*/
+	DynamicArray<IORequestID> AsyncIO_Submit(DynamicArray<ReadRequest>&& _requests);
+
+	/*
+	Cancels a read that has not been picked up by a worker yet.
+	Its completion is still dispatched, with the Cancelled status.
+	*/
+	bool AsyncIO_Cancel(IORequestID _id);
+
+	/*
+	Runs the callbacks of the finished reads on the calling thread.
+	Returns the number of completions dispatched.
+	*/
+	uDM AsyncIO_DispatchCompletions();
+
+	/*
+	Reads queued or being read.
+	*/
+	uDM AsyncIO_InFlight();
+
+	void AsyncIO_Record_EditorDevDebugUI();
+}
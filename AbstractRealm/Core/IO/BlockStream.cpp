@@ -0,0 +1,390 @@
+// Parent Header
+#include "BlockStream.hpp"
+
+
+
+// Engine
+#include "Compression.hpp"
+#include "Meta/Config/CoreDev_Config.hpp"
+
+#include <cstring>
+#include <exception>
+
+
+
+namespace Core::IO
+{
+	// Private
+
+	/*
+	A parallel loop, shared with the helpers that take part in it.
+	A helper that only starts once every index is taken leaves without touching the job, which lives on the caller's stack.
+	*/
+	struct ParallelLoop
+	{
+		Function<void(uDM)> Job;
+
+		uDM Count = 0;
+
+		Atomic<uDM>  Next   = 0;
+		Atomic<bool> Failed = false;
+
+		Mutex             Lock;
+		ConditionVariable Done;
+
+		uDM                Finished = 0;   // Indices run (or skipped after a failure), under Lock.
+		std::exception_ptr Failure;
+	};
+
+	StaticData()
+
+		Mutex             DecodeLock  ;
+		ConditionVariable DecodeSignal;
+
+		Deque< Function<void()> > DecodeJobs;
+
+		DynamicArray<Thread> DecodeWorkers;
+
+		bool DecodeExit = false;
+
+
+
+	// Forwards
+
+	void DecodeWorker();
+
+	void RunLoop(ParallelLoop& _loop);
+
+
+
+	/*
+	Runs _job for every index in [0, _count) across up to _workers threads: the calling one and the decode workers.
+	Indices are handed out one at a time, so uneven blocks still balance. The first exception is rethrown on the caller.
+	Without the decode workers loaded, the caller runs every index.
+	*/
+	template<typename JobType>
+	sInternal void ParallelFor(uDM _count, u32 _workers, JobType&& _job)
+	{
+		if (_count == 0) return;
+
+		if (_workers == 0) _workers = std::max(1U, Thread::hardware_concurrency());
+
+		SPtr<ParallelLoop> loop = MakeSPtr<ParallelLoop>();
+
+		loop->Job   = [&_job](uDM _index) { _job(_index); };
+		loop->Count = _count;
+
+		{
+			ScopedLock decodeGuard(DecodeLock);
+
+			uDM helpers = std::min<uDM>({ uDM(_workers) - 1, _count - 1, DecodeWorkers.size() });
+
+			for (uDM helper = 0; helper < helpers; helper++) DecodeJobs.push_back([loop]() { RunLoop(*loop); });
+		}
+
+		DecodeSignal.notify_all();
+
+		RunLoop(*loop);
+
+		UniqueLock loopGuard(loop->Lock);
+
+		loop->Done.wait(loopGuard, [&loop]() { return loop->Finished == loop->Count; });
+
+		if (loop->Failure) std::rethrow_exception(loop->Failure);
+	}
+
+
+
+	// Functions
+
+	void Load_BlockStream(u32 _workers)
+	{
+		ScopedLock decodeGuard(DecodeLock);
+
+		if (!DecodeWorkers.empty()) return;
+
+		if (_workers == 0) _workers = Meta::BlockStream_Workers;
+
+		// The calling thread always takes part.
+		if (_workers == 0) _workers = std::max(1U, Thread::hardware_concurrency()) - 1;
+
+		DecodeExit = false;
+
+		for (u32 index = 0; index < _workers; index++)
+		{
+			DecodeWorkers.push_back(Thread(DecodeWorker));
+		}
+	}
+
+	void Unload_BlockStream()
+	{
+		DynamicArray<Thread> workers;
+
+		{
+			ScopedLock decodeGuard(DecodeLock);
+
+			DecodeExit = true;
+
+			workers.swap(DecodeWorkers);
+		}
+
+		DecodeSignal.notify_all();
+
+		for (auto& worker : workers) worker.join();
+	}
+
+	DynamicArray<u8> BlockStream_Compress(ptr<const u8> _source, uDM _size, uDM _blockSize)
+	{
+		_blockSize = std::clamp(_blockSize, BlockStream_MinBlockSize, BlockStream_MaxBlockSize);
+
+		uDM blockCount = (_size + _blockSize - 1) / _blockSize;
+		uDM indexEnd   = sizeof(BlockStreamHeader) + blockCount * sizeof(BlockStreamBlock);
+
+		// Every block gets a worst case slot first, the stream is compacted once they are all done.
+		uDM slotSize = LZ4_CompressBound(_blockSize);
+
+		DynamicArray<u8>  scratch(blockCount * slotSize);
+		DynamicArray<uDM> storedSizes(blockCount);
+
+		ParallelFor
+		(
+			blockCount, 0,
+
+			[&](uDM _block)
+			{
+				uDM offset = _block * _blockSize;
+				uDM length = std::min(_blockSize, _size - offset);
+
+				ptr<u8> slot = scratch.data() + _block * slotSize;
+
+				uDM compressed = LZ4_CompressBlock(_source + offset, length, slot, slotSize);
+
+				if (compressed == 0 || compressed >= length)
+				{
+					memcpy(slot, _source + offset, length);
+
+					storedSizes[_block] = length;
+				}
+				else
+				{
+					storedSizes[_block] = compressed;
+				}
+			}
+		);
+
+		BlockStreamHeader header;
+
+		header.Magic      = BlockStreamMagic;
+		header.Version    = BlockStreamVersion;
+		header.BlockSize  = u32(_blockSize);
+		header.BlockCount = u32(blockCount);
+		header.Size       = _size;
+
+		DynamicArray<BlockStreamBlock> index(blockCount);
+
+		uDM streamSize = indexEnd;
+
+		for (uDM block = 0; block < blockCount; block++)
+		{
+			uDM length = std::min(_blockSize, _size - block * _blockSize);
+
+			index[block].Offset     = streamSize;
+			index[block].StoredSize = u32(storedSizes[block]);
+			index[block].Raw        = storedSizes[block] == length ? 1 : 0;
+
+			streamSize += storedSizes[block];
+		}
+
+		DynamicArray<u8> stream(streamSize);
+
+		memcpy(stream.data(), &header, sizeof(header));
+
+		if (blockCount > 0) memcpy(stream.data() + sizeof(header), index.data(), blockCount * sizeof(BlockStreamBlock));
+
+		for (uDM block = 0; block < blockCount; block++)
+		{
+			memcpy(stream.data() + index[block].Offset, scratch.data() + block * slotSize, storedSizes[block]);
+		}
+
+		return stream;
+	}
+
+
+
+	// BlockStreamReader
+
+	BlockStreamReader::BlockStreamReader(ptr<const u8> _stream, uDM _size) :
+		stream(_stream)
+	{
+		if (_size < sizeof(header)) throw RuntimeError("BlockStream: Truncated header.");
+
+		memcpy(&header, _stream, sizeof(header));
+
+		if (header.Magic != BlockStreamMagic || header.Version != BlockStreamVersion)
+		{
+			throw RuntimeError("BlockStream: Not a block stream.");
+		}
+
+		// The compressor clamps to the range, anything else bounds nothing a reader allocates from Size.
+		if (header.BlockSize < BlockStream_MinBlockSize || header.BlockSize > BlockStream_MaxBlockSize)
+		{
+			throw RuntimeError("BlockStream: Block size out of range.");
+		}
+
+		// Rounded up without adding to Size, a corrupt one near the limit would wrap.
+		if (header.Size / header.BlockSize + (header.Size % header.BlockSize != 0 ? 1 : 0) != header.BlockCount)
+		{
+			throw RuntimeError("BlockStream: Block count does not match the size.");
+		}
+
+		// Checked against the bytes present before the table size is computed, it cannot overflow.
+		if (header.BlockCount > (_size - sizeof(header)) / sizeof(BlockStreamBlock)) throw RuntimeError("BlockStream: Truncated block index.");
+
+		uDM indexEnd = sizeof(header) + uDM(header.BlockCount) * sizeof(BlockStreamBlock);
+
+		blocks = RCast<const BlockStreamBlock>(_stream + sizeof(header));
+
+		for (uDM block = 0; block < header.BlockCount; block++)
+		{
+			if (blocks[block].Offset < indexEnd || blocks[block].StoredSize > _size || blocks[block].Offset > _size - blocks[block].StoredSize)
+			{
+				throw RuntimeError("BlockStream: Block outside of the stream.");
+			}
+		}
+	}
+
+	uDM BlockStreamReader::DecompressBlock(uDM _block, ptr<u8> _destination) const
+	{
+		const BlockStreamBlock& block = blocks[_block];
+
+		uDM length = BlockLength(_block);
+
+		if (block.Raw)
+		{
+			if (block.StoredSize != length) throw RuntimeError("BlockStream: Raw block size mismatch.");
+
+			memcpy(_destination, stream + block.Offset, length);
+
+			return length;
+		}
+
+		if (LZ4_DecompressBlock(stream + block.Offset, block.StoredSize, _destination, length) != length)
+		{
+			throw RuntimeError("BlockStream: Block decompressed to the wrong size.");
+		}
+
+		return length;
+	}
+
+	void BlockStreamReader::DecompressRange(uDM _offset, uDM _size, ptr<u8> _destination) const
+	{
+		if (_size > GetSize() || _offset > GetSize() - _size) throw RuntimeError("BlockStream: Range past the end of the stream.");
+
+		if (_size == 0) return;
+
+		uDM blockSize = GetBlockSize();
+		uDM first     = _offset / blockSize;
+		uDM last      = (_offset + _size - 1) / blockSize;
+
+		DynamicArray<u8> partial;
+
+		for (uDM block = first; block <= last; block++)
+		{
+			uDM blockStart = block * blockSize;
+			uDM length     = BlockLength(block);
+
+			uDM from = std::max(_offset, blockStart);
+			uDM to   = std::min(_offset + _size, blockStart + length);
+
+			// Whole blocks go straight to the destination, only the edges need a scratch block.
+			if (from == blockStart && to == blockStart + length)
+			{
+				DecompressBlock(block, _destination + (from - _offset));
+			}
+			else
+			{
+				partial.resize(length);
+
+				DecompressBlock(block, partial.data());
+
+				memcpy(_destination + (from - _offset), partial.data() + (from - blockStart), to - from);
+			}
+		}
+	}
+
+	void BlockStreamReader::DecompressAll(ptr<u8> _destination, uDM _capacity, u32 _workers) const
+	{
+		if (_capacity < GetSize()) throw RuntimeError("BlockStream: Destination too small.");
+
+		ParallelFor
+		(
+			GetBlockCount(), _workers,
+
+			[this, _destination](uDM _block)
+			{
+				DecompressBlock(_block, _destination + _block * GetBlockSize());
+			}
+		);
+	}
+
+
+	// Protected
+
+	uDM BlockStreamReader::BlockLength(uDM _block) const
+	{
+		uDM offset = _block * GetBlockSize();
+
+		return std::min(GetBlockSize(), GetSize() - offset);
+	}
+
+
+
+	// Private
+
+	void DecodeWorker()
+	{
+		UniqueLock decodeGuard(DecodeLock);
+
+		while (true)
+		{
+			DecodeSignal.wait(decodeGuard, []() { return DecodeExit || !DecodeJobs.empty(); });
+
+			// Jobs left are run first, their callers are waiting on them.
+			if (DecodeJobs.empty()) return;
+
+			Function<void()> job = move(DecodeJobs.front());
+
+			DecodeJobs.pop_front();
+
+			decodeGuard.unlock();
+
+			job();
+
+			decodeGuard.lock();
+		}
+	}
+
+	void RunLoop(ParallelLoop& _loop)
+	{
+		for (uDM index = _loop.Next++; index < _loop.Count; index = _loop.Next++)
+		{
+			if (!_loop.Failed)
+			{
+				try
+				{
+					_loop.Job(index);
+				}
+				catch (...)
+				{
+					ScopedLock loopGuard(_loop.Lock);
+
+					if (!_loop.Failed.exchange(true)) _loop.Failure = std::current_exception();
+				}
+			}
+
+			ScopedLock loopGuard(_loop.Lock);
+
+			if (++_loop.Finished == _loop.Count) _loop.Done.notify_all();
+		}
+	}
+}
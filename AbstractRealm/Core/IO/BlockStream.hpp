@@ -0,0 +1,127 @@
+/*
+	Block Stream
+
+	A chunked compressed format for large assets.
+
+	Layout: [Header][Block index][Blocks]
+
+	The data is cut into fixed size blocks (64 - 256 KB) that are LZ4 compressed independently, the index gives the
+	position of every block. Any block (or range) can be decoded on its own, and a whole stream is decoded in parallel
+	with every block written straight to its final place in the destination.
+*/
+
+
+
+#pragma once
+
+
+
+// Engine
+#include "LAL/LAL.hpp"
+
+
+
+namespace Core::IO
+{
+	using namespace LAL;
+
+
+
+	// Structs
+
+	POD BlockStreamHeader
+	{
+		u32 Magic;
+		u32 Version;
+		u32 BlockSize;
+		u32 BlockCount;
+		u64 Size;        // Decompressed size.
+	};
+
+	POD BlockStreamBlock
+	{
+		u64 Offset;       // From the start of the stream.
+		u32 StoredSize;
+		u32 Raw;          // Stored uncompressed (it did not compress).
+	};
+
+
+
+	// Compile-Time
+
+	constexpr u32 BlockStreamMagic   = 0x53425241;   // "ARBS"
+	constexpr u32 BlockStreamVersion = 1;
+
+	constexpr uDM BlockStream_MinBlockSize     = 64  * 1024;
+	constexpr uDM BlockStream_MaxBlockSize     = 256 * 1024;
+	constexpr uDM BlockStream_DefaultBlockSize = 128 * 1024;
+
+
+
+	// Functions
+
+	/*
+	Starts the persistent workers that parallel compression and decoding run on, _workers of 0 uses Meta::BlockStream_Workers.
+	Until they are loaded (tools, early startup) the calling thread does all the work.
+	*/
+	void Load_BlockStream(u32 _workers = 0);
+
+	/*
+	Waits for the parallel work in progress and stops the workers.
+	*/
+	void Unload_BlockStream();
+
+	/*
+	Compresses _source into a block stream, the blocks are compressed in parallel.
+	_blockSize is clamped to [BlockStream_MinBlockSize, BlockStream_MaxBlockSize].
+	*/
+	DynamicArray<u8> BlockStream_Compress(ptr<const u8> _source, uDM _size, uDM _blockSize = BlockStream_DefaultBlockSize);
+
+
+
+	// Classes
+
+	/*
+	Decodes a block stream that is already in memory (a mapped file or a pack blob), it does not own the data.
+	*/
+	class BlockStreamReader
+	{
+	public:
+
+		BlockStreamReader() {}
+
+		/*
+		Validates the header and the index, throws on a malformed stream.
+		*/
+		BlockStreamReader(ptr<const u8> _stream, uDM _size);
+
+		uDM GetSize      () const { return uDM(header.Size);       }
+		uDM GetBlockSize () const { return uDM(header.BlockSize);  }
+		uDM GetBlockCount() const { return uDM(header.BlockCount); }
+
+		/*
+		Decodes a single block to _destination, which needs room for the block's decompressed size.
+		*/
+		uDM DecompressBlock(uDM _block, ptr<u8> _destination) const;
+
+		/*
+		Decodes the blocks covering [_offset, _offset + _size) and copies out exactly that range.
+		*/
+		void DecompressRange(uDM _offset, uDM _size, ptr<u8> _destination) const;
+
+		/*
+		Decodes the whole stream into _destination (at least GetSize() bytes) across up to _workers threads.
+		_workers of 0 uses every hardware thread, the calling thread always takes part and the others come from the
+		block stream workers.
+		*/
+		void DecompressAll(ptr<u8> _destination, uDM _capacity, u32 _workers = 0) const;
+
+	protected:
+
+		uDM BlockLength(uDM _block) const;
+
+		ptr<const u8>               stream = nullptr;
+		BlockStreamHeader           header = {};
+		ptr<const BlockStreamBlock> blocks = nullptr;
+	};
+}
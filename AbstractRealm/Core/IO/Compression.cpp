@@ -0,0 +1,494 @@
+// Parent Header
+#include "Compression.hpp"
+
+
+
+#include <cstring>
+
+
+
+namespace Core::IO
+{
+	// Private
+
+	StaticData()
+
+		constexpr uDM LZ4_MinMatch     = 4 ;
+		constexpr uDM LZ4_LastLiterals = 5 ;   // The last 5 bytes are always literals.
+		constexpr uDM LZ4_MatchLimit   = 12;   // The last match must start at least 12 bytes before the end.
+		constexpr uDM LZ4_MaxOffset    = 65535;
+
+		constexpr u32 LZ4_HashLog = 16;
+
+		constexpr u32 XXH_Prime1 = 2654435761U;
+		constexpr u32 XXH_Prime2 = 2246822519U;
+		constexpr u32 XXH_Prime3 = 3266489917U;
+		constexpr u32 XXH_Prime4 =  668265263U;
+		constexpr u32 XXH_Prime5 =  374761393U;
+
+		constexpr u64 XXH64_Prime1 = 11400714785074694791ULL;
+		constexpr u64 XXH64_Prime2 = 14029467366897019727ULL;
+		constexpr u64 XXH64_Prime3 =  1609587929392839161ULL;
+		constexpr u64 XXH64_Prime4 =  9650029242287828579ULL;
+		constexpr u64 XXH64_Prime5 =  2870177450012600261ULL;
+
+
+	sInternal u32 Read32(ptr<const u8> _data)
+	{
+		u32 value;
+
+		memcpy(&value, _data, sizeof(value));
+
+		return value;
+	}
+
+	sInternal u32 ReadLE32(ptr<const u8> _data)
+	{
+		return u32(_data[0]) | u32(_data[1]) << 8 | u32(_data[2]) << 16 | u32(_data[3]) << 24;
+	}
+
+	sInternal u64 ReadLE64(ptr<const u8> _data)
+	{
+		return u64(ReadLE32(_data)) | u64(ReadLE32(_data + 4)) << 32;
+	}
+
+	sInternal void WriteLE32(DynamicArray<u8>& _buffer, u32 _value)
+	{
+		_buffer.push_back(u8(_value      ));
+		_buffer.push_back(u8(_value >>  8));
+		_buffer.push_back(u8(_value >> 16));
+		_buffer.push_back(u8(_value >> 24));
+	}
+
+	sInternal u32 RotateLeft(u32 _value, u32 _count)
+	{
+		return (_value << _count) | (_value >> (32 - _count));
+	}
+
+	sInternal u64 RotateLeft64(u64 _value, u32 _count)
+	{
+		return (_value << _count) | (_value >> (64 - _count));
+	}
+
+	sInternal u64 XXH64_Round(u64 _accumulator, u64 _input)
+	{
+		return RotateLeft64(_accumulator + _input * XXH64_Prime2, 31) * XXH64_Prime1;
+	}
+
+	sInternal u64 XXH64_Merge(u64 _hash, u64 _accumulator)
+	{
+		return (_hash ^ XXH64_Round(0, _accumulator)) * XXH64_Prime1 + XXH64_Prime4;
+	}
+
+	sInternal ptr<u8> WriteLength(ptr<u8> _output, uDM _length)
+	{
+		for (; _length >= 255; _length -= 255) *_output++ = 255;
+
+		*_output++ = u8(_length);
+
+		return _output;
+	}
+
+	sInternal ptr<u8> WriteSequence(ptr<u8> _output, ptr<const u8> _literals, uDM _literalLength, uDM _offset, uDM _matchLength)
+	{
+		ptr<u8> token = _output++;
+
+		*token = u8((_literalLength >= 15 ? 15 : _literalLength) << 4);
+
+		if (_literalLength >= 15) _output = WriteLength(_output, _literalLength - 15);
+
+		memcpy(_output, _literals, _literalLength);
+
+		_output += _literalLength;
+
+		// The last sequence only carries literals.
+		if (_matchLength == 0) return _output;
+
+		*_output++ = u8(_offset     );
+		*_output++ = u8(_offset >> 8);
+
+		uDM matchCode = _matchLength - LZ4_MinMatch;
+
+		*token |= u8(matchCode >= 15 ? 15 : matchCode);
+
+		if (matchCode >= 15) _output = WriteLength(_output, matchCode - 15);
+
+		return _output;
+	}
+
+	sInternal uDM ReadLength(ptr<const u8>& _input, ptr<const u8> _end)
+	{
+		uDM length = 0;
+
+		u8 byte;
+
+		do
+		{
+			if (_input >= _end) throw RuntimeError("LZ4: Truncated length.");
+
+			byte = *_input++;
+
+			length += byte;
+		}
+		while (byte == 255);
+
+		return length;
+	}
+
+
+
+	// Public
+
+	uDM LZ4_CompressBlock(ptr<const u8> _source, uDM _size, ptr<u8> _destination, uDM _capacity)
+	{
+		if (_capacity < LZ4_CompressBound(_size)) return 0;
+
+		ptr<u8> output = _destination;
+
+		ptr<const u8> anchor = _source;
+		ptr<const u8> end    = _source + _size;
+
+		if (_size > LZ4_MatchLimit)
+		{
+			// Greedy single probe hash chain (positions of the last occurrence of each 4 byte hash).
+			DynamicArray<u32> table(uDM(1) << LZ4_HashLog, 0);
+
+			ptr<const u8> input      = _source;
+			ptr<const u8> matchStart = end - LZ4_MatchLimit;
+			ptr<const u8> matchEnd   = end - LZ4_LastLiterals;
+
+			while (input < matchStart)
+			{
+				u32 sequence = Read32(input);
+				u32 hash     = (sequence * XXH_Prime1) >> (32 - LZ4_HashLog);
+
+				ptr<const u8> reference = _source + table[hash];
+
+				table[hash] = u32(input - _source);
+
+				if (reference >= input || uDM(input - reference) > LZ4_MaxOffset || Read32(reference) != sequence)
+				{
+					input++;
+
+					continue;
+				}
+
+				// Extend backwards over literals that also match.
+				while (input > anchor && reference > _source && input[-1] == reference[-1])
+				{
+					input--; reference--;
+				}
+
+				ptr<const u8> matchCursor = input     + LZ4_MinMatch;
+				ptr<const u8> refCursor   = reference + LZ4_MinMatch;
+
+				while (matchCursor < matchEnd && *matchCursor == *refCursor)
+				{
+					matchCursor++; refCursor++;
+				}
+
+				output = WriteSequence(output, anchor, uDM(input - anchor), uDM(input - reference), uDM(matchCursor - input));
+
+				input  = matchCursor;
+				anchor = input;
+			}
+		}
+
+		output = WriteSequence(output, anchor, uDM(end - anchor), 0, 0);
+
+		return uDM(output - _destination);
+	}
+
+	uDM LZ4_DecompressBlock(ptr<const u8> _source, uDM _size, ptr<u8> _destination, uDM _capacity)
+	{
+		ptr<const u8> input    = _source;
+		ptr<const u8> inputEnd = _source + _size;
+
+		ptr<u8> output    = _destination;
+		ptr<u8> outputEnd = _destination + _capacity;
+
+		while (input < inputEnd)
+		{
+			u8 token = *input++;
+
+			uDM literalLength = token >> 4;
+
+			if (literalLength == 15) literalLength += ReadLength(input, inputEnd);
+
+			if (uDM(inputEnd - input) < literalLength || uDM(outputEnd - output) < literalLength)
+			{
+				throw RuntimeError("LZ4: Literals exceed the block.");
+			}
+
+			memcpy(output, input, literalLength);
+
+			input  += literalLength;
+			output += literalLength;
+
+			if (input == inputEnd) break;
+
+			if (inputEnd - input < 2) throw RuntimeError("LZ4: Truncated offset.");
+
+			uDM offset = uDM(input[0]) | uDM(input[1]) << 8;
+
+			input += 2;
+
+			if (offset == 0 || offset > uDM(output - _destination)) throw RuntimeError("LZ4: Invalid match offset.");
+
+			uDM matchLength = token & 15;
+
+			if (matchLength == 15) matchLength += ReadLength(input, inputEnd);
+
+			matchLength += LZ4_MinMatch;
+
+			if (uDM(outputEnd - output) < matchLength) throw RuntimeError("LZ4: Match exceeds the output.");
+
+			ptr<const u8> match = output - offset;
+
+			// Overlapping copies repeat the pattern, so those go byte by byte.
+			if (offset >= matchLength)
+			{
+				memcpy(output, match, matchLength);
+
+				output += matchLength;
+			}
+			else
+			{
+				for (uDM index = 0; index < matchLength; index++) *output++ = *match++;
+			}
+		}
+
+		return uDM(output - _destination);
+	}
+
+	DynamicArray<u8> LZ4_CompressFrame(ptr<const u8> _source, uDM _size)
+	{
+		DynamicArray<u8> frame;
+
+		frame.reserve(LZ4_CompressBound(_size) + 32);
+
+		WriteLE32(frame, LZ4_FrameMagic);
+
+		// FLG: Version 01, independent blocks, no checksums, no content size.
+		// BD : Block maximum size 4 MB.
+		u8 descriptor[2] = { 0x60, 0x70 };
+
+		frame.push_back(descriptor[0]);
+		frame.push_back(descriptor[1]);
+		frame.push_back(u8(XXH32(descriptor, sizeof(descriptor), 0) >> 8));
+
+		DynamicArray<u8> block(LZ4_CompressBound(LZ4_FrameBlockSize));
+
+		for (uDM offset = 0; offset < _size; offset += LZ4_FrameBlockSize)
+		{
+			uDM blockSize      = std::min(LZ4_FrameBlockSize, _size - offset);
+			uDM compressedSize = LZ4_CompressBlock(_source + offset, blockSize, block.data(), block.size());
+
+			// Incompressible blocks are stored raw (high bit of the size set).
+			if (compressedSize >= blockSize)
+			{
+				WriteLE32(frame, u32(blockSize) | 0x80000000U);
+
+				frame.insert(frame.end(), _source + offset, _source + offset + blockSize);
+			}
+			else
+			{
+				WriteLE32(frame, u32(compressedSize));
+
+				frame.insert(frame.end(), block.data(), block.data() + compressedSize);
+			}
+		}
+
+		WriteLE32(frame, 0);   // End mark
+
+		return frame;
+	}
+
+	DynamicArray<u8> LZ4_DecompressFrame(ptr<const u8> _source, uDM _size)
+	{
+		ptr<const u8> input    = _source;
+		ptr<const u8> inputEnd = _source + _size;
+
+		if (_size < 7 || ReadLE32(input) != LZ4_FrameMagic) throw RuntimeError("LZ4: Not an LZ4 frame.");
+
+		input += 4;
+
+		u8 flags      = input[0];
+		u8 blockDesc  = input[1];
+
+		if ((flags >> 6) != 1) throw RuntimeError("LZ4: Unsupported frame version.");
+
+		bool blockChecksum   = flags & 0x10;
+		bool contentSize     = flags & 0x08;
+		bool contentChecksum = flags & 0x04;
+		bool dictionaryID    = flags & 0x01;
+
+		uDM descriptorSize = 2 + (contentSize ? 8 : 0) + (dictionaryID ? 4 : 0);
+
+		if (uDM(inputEnd - input) < descriptorSize + 1) throw RuntimeError("LZ4: Truncated frame header.");
+
+		if (u8(XXH32(input, descriptorSize, 0) >> 8) != input[descriptorSize]) throw RuntimeError("LZ4: Frame header checksum mismatch.");
+
+		input += descriptorSize + 1;
+
+		uDM blockMaxSize = uDM(1) << (8 + 2 * ((blockDesc >> 4) & 0x7));
+
+		DynamicArray<u8> result;
+
+		while (true)
+		{
+			if (inputEnd - input < 4) throw RuntimeError("LZ4: Truncated block header.");
+
+			u32 blockSize = ReadLE32(input);
+
+			input += 4;
+
+			if (blockSize == 0) break;
+
+			bool raw = blockSize & 0x80000000U;
+
+			blockSize &= 0x7FFFFFFFU;
+
+			if (uDM(inputEnd - input) < blockSize + (blockChecksum ? 4 : 0)) throw RuntimeError("LZ4: Truncated block.");
+
+			uDM written = result.size();
+
+			if (raw)
+			{
+				result.insert(result.end(), input, input + blockSize);
+			}
+			else
+			{
+				result.resize(written + blockMaxSize);
+
+				uDM decompressed = LZ4_DecompressBlock(input, blockSize, result.data() + written, blockMaxSize);
+
+				result.resize(written + decompressed);
+			}
+
+			input += blockSize + (blockChecksum ? 4 : 0);
+		}
+
+		if (contentChecksum && inputEnd - input >= 4)
+		{
+			if (ReadLE32(input) != XXH32(result.data(), result.size(), 0)) throw RuntimeError("LZ4: Content checksum mismatch.");
+		}
+
+		return result;
+	}
+
+	u32 XXH32(ptr<const u8> _data, uDM _size, u32 _seed)
+	{
+		ptr<const u8> input = _data;
+		ptr<const u8> end   = _data + _size;
+
+		u32 hash;
+
+		if (_size >= 16)
+		{
+			u32 accumulators[4] =
+			{
+				_seed + XXH_Prime1 + XXH_Prime2,
+				_seed + XXH_Prime2             ,
+				_seed                          ,
+				_seed - XXH_Prime1
+			};
+
+			for (; end - input >= 16; input += 16)
+			{
+				for (uDM lane = 0; lane < 4; lane++)
+				{
+					accumulators[lane] = RotateLeft(accumulators[lane] + ReadLE32(input + lane * 4) * XXH_Prime2, 13) * XXH_Prime1;
+				}
+			}
+
+			hash =
+				RotateLeft(accumulators[0], 1 ) + RotateLeft(accumulators[1], 7 ) +
+				RotateLeft(accumulators[2], 12) + RotateLeft(accumulators[3], 18);
+		}
+		else
+		{
+			hash = _seed + XXH_Prime5;
+		}
+
+		hash += u32(_size);
+
+		for (; end - input >= 4; input += 4)
+		{
+			hash = RotateLeft(hash + ReadLE32(input) * XXH_Prime3, 17) * XXH_Prime4;
+		}
+
+		for (; input < end; input++)
+		{
+			hash = RotateLeft(hash + (*input) * XXH_Prime5, 11) * XXH_Prime1;
+		}
+
+		hash ^= hash >> 15; hash *= XXH_Prime2;
+		hash ^= hash >> 13; hash *= XXH_Prime3;
+		hash ^= hash >> 16;
+
+		return hash;
+	}
+
+	u64 XXH64(ptr<const u8> _data, uDM _size, u64 _seed)
+	{
+		ptr<const u8> input = _data;
+		ptr<const u8> end   = _data + _size;
+
+		u64 hash;
+
+		if (_size >= 32)
+		{
+			u64 accumulators[4] =
+			{
+				_seed + XXH64_Prime1 + XXH64_Prime2,
+				_seed + XXH64_Prime2               ,
+				_seed                              ,
+				_seed - XXH64_Prime1
+			};
+
+			for (; end - input >= 32; input += 32)
+			{
+				for (uDM lane = 0; lane < 4; lane++)
+				{
+					accumulators[lane] = XXH64_Round(accumulators[lane], ReadLE64(input + lane * 8));
+				}
+			}
+
+			hash =
+				RotateLeft64(accumulators[0], 1 ) + RotateLeft64(accumulators[1], 7 ) +
+				RotateLeft64(accumulators[2], 12) + RotateLeft64(accumulators[3], 18);
+
+			for (u64 accumulator : accumulators) hash = XXH64_Merge(hash, accumulator);
+		}
+		else
+		{
+			hash = _seed + XXH64_Prime5;
+		}
+
+		hash += u64(_size);
+
+		for (; end - input >= 8; input += 8)
+		{
+			hash = RotateLeft64(hash ^ XXH64_Round(0, ReadLE64(input)), 27) * XXH64_Prime1 + XXH64_Prime4;
+		}
+
+		if (end - input >= 4)
+		{
+			hash = RotateLeft64(hash ^ (u64(ReadLE32(input)) * XXH64_Prime1), 23) * XXH64_Prime2 + XXH64_Prime3;
+
+			input += 4;
+		}
+
+		for (; input < end; input++)
+		{
+			hash = RotateLeft64(hash ^ (u64(*input) * XXH64_Prime5), 11) * XXH64_Prime1;
+		}
+
+		hash ^= hash >> 33; hash *= XXH64_Prime2;
+		hash ^= hash >> 29; hash *= XXH64_Prime3;
+		hash ^= hash >> 32;
+
+		return hash;
+	}
+}
@@ -0,0 +1,66 @@
+/*
+	Compression
+
+	A self contained LZ4 codec (block and frame format).
+
+	The block codec is the raw LZ4 sequence format, independent blocks can be compressed and decompressed in parallel.
+	The frame format output is compatible with the reference lz4 tool (lz4 -d can read it).
+*/
+
+
+
+#pragma once
+
+
+
+// Engine
+#include "LAL/LAL.hpp"
+
+
+
+namespace Core::IO
+{
+	using namespace LAL;
+
+
+
+	// Compile-Time
+
+	constexpr u32 LZ4_FrameMagic = 0x184D2204;
+
+	constexpr uDM LZ4_FrameBlockSize = 4 * 1024 * 1024;   // Block maximum size id 7.
+
+	// No LZ4 block decompresses to more than this many times its size, bounds a size read from a file before allocating it.
+	constexpr u64 LZ4_MaxRatio = 255;
+
+
+
+	// Functions
+
+	constexpr uDM LZ4_CompressBound(uDM _size)
+	{
+		return _size + _size / 255 + 16;
+	}
+
+	/*
+	Compresses _source into _destination, _capacity must be at least LZ4_CompressBound(_size).
+
+	Returns the compressed size, 0 if the destination is too small.
+	*/
+	uDM LZ4_CompressBlock(ptr<const u8> _source, uDM _size, ptr<u8> _destination, uDM _capacity);
+
+	/*
+	Decompresses a block into _destination.
+
+	Returns the decompressed size. Throws on malformed input or if the output would exceed _capacity.
+	*/
+	uDM LZ4_DecompressBlock(ptr<const u8> _source, uDM _size, ptr<u8> _destination, uDM _capacity);
+
+	DynamicArray<u8> LZ4_CompressFrame(ptr<const u8> _source, uDM _size);
+
+	DynamicArray<u8> LZ4_DecompressFrame(ptr<const u8> _source, uDM _size);
+
+	u32 XXH32(ptr<const u8> _data, uDM _size, u32 _seed);
+
+	u64 XXH64(ptr<const u8> _data, uDM _size, u64 _seed);
+}
@@ -0,0 +1,270 @@
+// Parent Header
+#include "DerivedDataCache.hpp"
+
+
+
+// Engine
+#include "Basic_FileIO.hpp"
+#include "Compression.hpp"
+#include "MappedFile.hpp"
+#include "Meta/Config/CoreDev_Config.hpp"
+#include "ImGui_SAL.hpp"
+
+#include <cstring>
+
+
+
+namespace Core::IO
+{
+	// Private
+
+	POD DDC_Header
+	{
+		u32 Magic;
+		u32 Version;
+		u64 Key;
+		u64 Size;
+		u64 StoredSize;
+		u32 Checksum;     // XXH32 of the uncompressed data.
+		u32 Compressed;
+	};
+
+	constexpr u32 DDC_Magic   = 0x44445241;   // "ARDD"
+	constexpr u32 DDC_Version = 1;
+
+	StaticData()
+
+		Atomic<uDM> Hits     ;
+		Atomic<uDM> Misses   ;
+		Atomic<uDM> Corrupt  ;
+		Atomic<uDM> BytesRead;
+
+		Atomic<u32> TemporaryID;
+
+
+
+	// Forwards
+
+	Path EntryPath(const DerivedDataKey& _key);
+
+
+
+	// DerivedDataKey
+
+	DerivedDataKey::DerivedDataKey(StringView _processor, u32 _version) :
+		processor(_processor),
+		hash     (XXH64(RCast<const u8>(_processor.data()), _processor.size(), _version))
+	{}
+
+	DerivedDataKey& DerivedDataKey::Add(ptr<const void> _data, uDM _size)
+	{
+		// Chained through the seed, the size is part of the hash so consecutive inputs cannot run into each other.
+		hash = XXH64(RCast<const u8>(_data), _size, hash);
+
+		return *this;
+	}
+
+	DerivedDataKey& DerivedDataKey::Add(StringView _string)
+	{
+		return Add(_string.data(), _string.size());
+	}
+
+	String DerivedDataKey::ToString() const
+	{
+		constexpr char digits[] = "0123456789abcdef";
+
+		String result(16, '0');
+
+		for (uDM index = 0; index < 16; index++) result[15 - index] = digits[(hash >> (index * 4)) & 0xF];
+
+		return result;
+	}
+
+
+
+	// Public
+
+	bool DDC_Get(const DerivedDataKey& _key, DynamicArray<u8>& _data)
+	{
+		if (!Meta::DDC_Enabled) return false;
+
+		Path path = EntryPath(_key);
+
+		MappedFile entry;
+
+		if (!entry.Open(path, EMapAdvice::Sequential))
+		{
+			Misses++;
+
+			return false;
+		}
+
+		DDC_Header header = {};
+
+		if (entry.Size() >= sizeof(header)) memcpy(&header, entry.Data(), sizeof(header));
+
+		// Magic is only set when the file holds a header. Compared as the bytes after it, a huge StoredSize cannot wrap around.
+		bool valid =
+			header.Magic      == DDC_Magic                      &&
+			header.Version    == DDC_Version                    &&
+			header.Key        == _key.GetHash()                 &&
+			header.StoredSize == entry.Size() - sizeof(header);
+
+		// The data is allocated from the header's size, it cannot be more than what is stored decompresses to.
+		valid = valid && (header.Compressed ? header.Size / LZ4_MaxRatio <= header.StoredSize : header.Size == header.StoredSize);
+
+		if (valid)
+		{
+			ptr<const u8> stored = entry.Data() + sizeof(header);
+
+			_data.resize(uDM(header.Size));
+
+			if (header.Compressed)
+			{
+				try
+				{
+					valid = LZ4_DecompressBlock(stored, uDM(header.StoredSize), _data.data(), _data.size()) == _data.size();
+				}
+				catch (RuntimeError&)
+				{
+					valid = false;
+				}
+			}
+			else
+			{
+				memcpy(_data.data(), stored, _data.size());
+			}
+
+			valid = valid && XXH32(_data.data(), _data.size(), 0) == header.Checksum;
+		}
+
+		if (!valid)
+		{
+			// A torn or foreign entry, it gets cooked and written again.
+			entry.Close();
+
+			std::error_code error;
+
+			std::filesystem::remove(path, error);
+
+			_data.clear();
+
+			Corrupt++;
+			Misses ++;
+
+			return false;
+		}
+
+		Hits++;
+
+		BytesRead += _data.size();
+
+		return true;
+	}
+
+	void DDC_Put(const DerivedDataKey& _key, ptr<const void> _data, uDM _size)
+	{
+		if (!Meta::DDC_Enabled) return;
+
+		ptr<const u8> data = RCast<const u8>(_data);
+
+		DDC_Header header = {};
+
+		header.Magic      = DDC_Magic;
+		header.Version    = DDC_Version;
+		header.Key        = _key.GetHash();
+		header.Size       = _size;
+		header.StoredSize = _size;
+		header.Checksum   = XXH32(data, _size, 0);
+		header.Compressed = 0;
+
+		ptr<const u8> stored = data;
+
+		DynamicArray<u8> compressed;
+
+		if (Meta::DDC_Compress && _size > 0)
+		{
+			compressed.resize(LZ4_CompressBound(_size));
+
+			uDM compressedSize = LZ4_CompressBlock(data, _size, compressed.data(), compressed.size());
+
+			if (compressedSize > 0 && compressedSize <= _size - _size / 8)
+			{
+				stored            = compressed.data();
+				header.StoredSize = compressedSize;
+				header.Compressed = 1;
+			}
+		}
+
+		Path path = EntryPath(_key);
+
+		std::error_code error;
+
+		std::filesystem::create_directories(path.parent_path(), error);
+
+		// Unique per writer, two processes cooking the same entry race harmlessly on the rename.
+		Path temporary = path;
+
+		temporary += "." + LAL::ToString(u32(TemporaryID++)) + "." + LAL::ToString(u64(SteadyClock::now().time_since_epoch().count())) + ".tmp";
+
+		File_OutputStream output;
+
+		if (!OpenFile(output, OpenFlags(EOpenFlag::ForOutput, EOpenFlag::BinaryMode, EOpenFlag::DiscardStreamContents), temporary)) return;
+
+		output.write(RCast<const char>(&header), sizeof(header));
+		output.write(RCast<const char>(stored), std::streamsize(header.StoredSize));
+
+		output.close();
+
+		if (!output)
+		{
+			std::filesystem::remove(temporary, error);
+
+			return;
+		}
+
+		std::filesystem::rename(temporary, path, error);
+
+		if (error) std::filesystem::remove(temporary, error);
+	}
+
+	DynamicArray<u8> DDC_GetOrCook(const DerivedDataKey& _key, const Function<DynamicArray<u8>()>& _cook)
+	{
+		DynamicArray<u8> data;
+
+		if (DDC_Get(_key, data)) return data;
+
+		data = _cook();
+
+		DDC_Put(_key, data.data(), data.size());
+
+		return data;
+	}
+
+	void DDC_Record_EditorDevDebugUI()
+	{
+		using namespace SAL::Imgui;
+
+		if (Table2C::Record())
+		{
+			Table2C::Entry("Derived Data Hits"      , ToString(uDM(Hits     )));
+			Table2C::Entry("Derived Data Misses"    , ToString(uDM(Misses   )));
+			Table2C::Entry("Derived Data Corrupt"   , ToString(uDM(Corrupt  )));
+			Table2C::Entry("Derived Data Bytes Read", ToString(uDM(BytesRead)));
+
+			Table2C::EndRecord();
+		}
+	}
+
+
+
+	// Private
+
+	Path EntryPath(const DerivedDataKey& _key)
+	{
+		String name = _key.ToString();
+
+		// Fanned out by the first byte so no single directory grows too large.
+		return Path(Meta::DDC_Directory) / _key.GetProcessor() / name.substr(0, 2) / (name + ".ddc");
+	}
+}
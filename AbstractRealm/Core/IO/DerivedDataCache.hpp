@@ -0,0 +1,82 @@
+/*
+	Derived Data Cache
+
+	Local disk cache of cooked asset data (compiled shaders, built vertex data, decoded images...).
+
+	Entries are content addressed: the key hashes the processor name and version, the source bytes and any setting
+	that affects the output. A lookup is a single file open with no index to load or keep coherent, and a stale entry
+	can never be hit since changing any input changes the key. Bump a processor's version whenever its output changes.
+*/
+
+
+
+#pragma once
+
+
+
+// Engine
+#include "LAL/LAL.hpp"
+
+
+
+namespace Core::IO
+{
+	using namespace LAL;
+
+
+
+	class DerivedDataKey
+	{
+	public:
+
+		DerivedDataKey(StringView _processor, u32 _version);
+
+		DerivedDataKey& Add(ptr<const void> _data, uDM _size);
+
+		DerivedDataKey& Add(StringView _string);
+
+		template<typename Type>
+		DerivedDataKey& AddValue(const Type& _value)
+		{
+			static_assert(std::is_trivially_copyable_v<Type>, "DerivedDataKey: Only plain values can be hashed directly.");
+
+			return Add(getPtr(_value), sizeof(Type));
+		}
+
+		u64 GetHash() const { return hash; }
+
+		const String& GetProcessor() const { return processor; }
+
+		/*
+		The hash as 16 hex digits.
+		*/
+		String ToString() const;
+
+	protected:
+
+		String processor;
+
+		u64 hash;
+	};
+
+
+
+	// Functions
+
+	/*
+	Returns true and fills _data on a hit. Corrupt entries are removed and reported as misses.
+	*/
+	bool DDC_Get(const DerivedDataKey& _key, DynamicArray<u8>& _data);
+
+	/*
+	Stores an entry. Written to a temporary and renamed, so a reader never sees a partial one.
+	*/
+	void DDC_Put(const DerivedDataKey& _key, ptr<const void> _data, uDM _size);
+
+	/*
+	Returns the cached entry, or runs _cook and stores its result.
+	*/
+	DynamicArray<u8> DDC_GetOrCook(const DerivedDataKey& _key, const Function<DynamicArray<u8>()>& _cook);
+
+	void DDC_Record_EditorDevDebugUI();
+}
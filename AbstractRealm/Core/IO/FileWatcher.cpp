@@ -0,0 +1,341 @@
+// Parent Header
+#include "FileWatcher.hpp"
+
+
+
+// Engine
+#include "Meta/Config/CoreDev_Config.hpp"
+#include "OSAL/OSAL_FileWatch.hpp"
+#include "ImGui_SAL.hpp"
+
+
+
+namespace Core::IO
+{
+	// Private
+
+	struct Watch
+	{
+		OSAL::DirectoryWatch OS;
+
+		bool Broken = false;
+	};
+
+	struct PendingChange
+	{
+		FileChange      Change;
+		SteadyTimePoint LastSeen;
+	};
+
+	StaticData()
+
+		// Held by the worker while it polls, the OS watches are only touched under it.
+		Mutex             WatchLock  ;
+		ConditionVariable WatchSignal;
+
+		// Boxed: the OS writes into the watches asynchronously, they must not move.
+		UnorderedMap<WatchID, UPtr<Watch>> Watches;
+
+		WatchID NextWatchID = 1;
+
+		// Worker only: path -> the coalesced change waiting out its debounce.
+		sInternal UnorderedMap<String, PendingChange> Pending;
+
+		DynamicArray<OSAL::DirectoryChange> Polled;
+
+		sInternal bool Exit = false;
+
+		Thread Worker;
+
+		Mutex                    ReleaseLock;
+		DynamicArray<FileChange> Released;
+
+		DynamicArray< std::pair<SubscriptionID, FileChangeHandler> > Subscribers;
+
+		SubscriptionID NextSubscriptionID = 1;
+
+		uDM Dispatched = 0;
+
+
+
+	// Forwards
+
+	void WorkerLoop();
+
+	void Poll(WatchID _id, Watch& _watch, SteadyTimePoint _now);
+
+	void Coalesce(FileChange&& _change, SteadyTimePoint _now);
+
+	void Release(SteadyTimePoint _now);
+
+
+
+	// Public
+
+	void Load_FileWatcher()
+	{
+		if (Worker.joinable()) return;
+
+		Exit = false;
+
+		Worker = Thread(WorkerLoop);
+	}
+
+	void Unload_FileWatcher()
+	{
+		if (Worker.joinable())
+		{
+			{
+				ScopedLock watchGuard(WatchLock);
+
+				Exit = true;
+			}
+
+			WatchSignal.notify_all();
+
+			Worker.join();
+		}
+
+		ScopedLock watchGuard(WatchLock);
+
+		for (auto& watch : Watches) OSAL::CloseWatch(watch.second->OS);
+
+		Watches.clear();
+		Pending.clear();
+
+		ScopedLock releaseGuard(ReleaseLock);
+
+		Released.clear();
+	}
+
+	WatchID FileWatcher_Watch(const Path& _directory, bool _recursive)
+	{
+		UPtr<Watch> watch = MakeUPtr<Watch>();
+
+		if (!OSAL::WatchDirectory(_directory, _recursive, watch->OS)) return InvalidWatch;
+
+		ScopedLock watchGuard(WatchLock);
+
+		WatchID id = NextWatchID++;
+
+		Watches.emplace(id, move(watch));
+
+		return id;
+	}
+
+	void FileWatcher_Unwatch(WatchID _watch)
+	{
+		{
+			ScopedLock watchGuard(WatchLock);
+
+			auto found = Watches.find(_watch);
+
+			if (found == Watches.end()) return;
+
+			OSAL::CloseWatch(found->second->OS);
+
+			Watches.erase(found);
+
+			for (auto pending = Pending.begin(); pending != Pending.end();)
+			{
+				if (pending->second.Change.Watch == _watch) pending = Pending.erase(pending);
+				else                                        pending++;
+			}
+		}
+
+		ScopedLock releaseGuard(ReleaseLock);
+
+		Released.erase
+		(
+			std::remove_if(Released.begin(), Released.end(), [_watch](const FileChange& _change) { return _change.Watch == _watch; }),
+			Released.end()
+		);
+	}
+
+	SubscriptionID FileWatcher_Subscribe(FileChangeHandler&& _handler)
+	{
+		SubscriptionID id = NextSubscriptionID++;
+
+		Subscribers.emplace_back(id, move(_handler));
+
+		return id;
+	}
+
+	void FileWatcher_Unsubscribe(SubscriptionID _subscription)
+	{
+		Subscribers.erase
+		(
+			std::remove_if
+			(
+				Subscribers.begin(), Subscribers.end(),
+
+				[_subscription](const auto& _subscriber) { return _subscriber.first == _subscription; }
+			),
+			Subscribers.end()
+		);
+	}
+
+	uDM FileWatcher_DispatchEvents()
+	{
+		DynamicArray<FileChange> batch;
+
+		{
+			ScopedLock releaseGuard(ReleaseLock);
+
+			batch.swap(Released);
+		}
+
+		if (batch.empty()) return 0;
+
+		// Copied: a subscriber may subscribe or unsubscribe while handling the batch.
+		auto subscribers = Subscribers;
+
+		for (auto& subscriber : subscribers) subscriber.second(batch);
+
+		Dispatched += batch.size();
+
+		return batch.size();
+	}
+
+	void FileWatcher_Record_EditorDevDebugUI()
+	{
+		using namespace SAL::Imgui;
+
+		uDM watches;
+
+		{
+			ScopedLock watchGuard(WatchLock);
+
+			watches = Watches.size();
+		}
+
+		if (Table2C::Record())
+		{
+			Table2C::Entry("Watched Directories"   , ToString(watches));
+			Table2C::Entry("Watch Subscribers"     , ToString(Subscribers.size()));
+			Table2C::Entry("File Changes Published", ToString(Dispatched));
+
+			Table2C::EndRecord();
+		}
+	}
+
+
+
+	// Private
+
+	void WorkerLoop()
+	{
+		UniqueLock watchGuard(WatchLock);
+
+		while (true)
+		{
+			WatchSignal.wait_for(watchGuard, Meta::FileWatcher_PollInterval, []() { return Exit; });
+
+			if (Exit) return;
+
+			SteadyTimePoint now = SteadyClock::now();
+
+			for (auto& watch : Watches) Poll(watch.first, *watch.second, now);
+
+			Release(now);
+		}
+	}
+
+	void Poll(WatchID _id, Watch& _watch, SteadyTimePoint _now)
+	{
+		if (_watch.Broken) return;
+
+		Polled.clear();
+
+		if (!OSAL::PollDirectoryChanges(_watch.OS, Polled))
+		{
+			// The directory went away, whoever uses it has to take stock once.
+			_watch.Broken = true;
+
+			Polled.push_back({ _watch.OS.Root, OSAL::EDirectoryChange::Overflow });
+		}
+
+		for (auto& change : Polled)
+		{
+			EFileChange fileChange;
+
+			switch (change.Change)
+			{
+				case OSAL::EDirectoryChange::Added   : fileChange = EFileChange::Added   ; break;
+				case OSAL::EDirectoryChange::Removed : fileChange = EFileChange::Removed ; break;
+				case OSAL::EDirectoryChange::Modified: fileChange = EFileChange::Modified; break;
+				default                              : fileChange = EFileChange::Rescan  ; break;
+			}
+
+			Coalesce({ _id, move(change.File), fileChange }, _now);
+		}
+	}
+
+	void Coalesce(FileChange&& _change, SteadyTimePoint _now)
+	{
+		String key = _change.File.generic_string();
+
+		auto found = Pending.find(key);
+
+		if (found == Pending.end())
+		{
+			Pending.emplace(move(key), PendingChange { move(_change), _now });
+
+			return;
+		}
+
+		EFileChange& pending = found->second.Change.Change;
+
+		found->second.LastSeen = _now;
+
+		switch (pending)
+		{
+			case EFileChange::Added:
+			{
+				// Created and deleted again within the debounce (temporaries), nobody needs to hear about it.
+				if (_change.Change == EFileChange::Removed) Pending.erase(found);
+
+			} break;
+
+			case EFileChange::Modified:
+			{
+				if (_change.Change == EFileChange::Removed) pending = EFileChange::Removed;
+
+			} break;
+
+			case EFileChange::Removed:
+			{
+				// Replaced (the usual save through a temporary and rename).
+				if (_change.Change != EFileChange::Removed) pending = EFileChange::Modified;
+
+			} break;
+
+			case EFileChange::Rescan: break;
+		}
+	}
+
+	void Release(SteadyTimePoint _now)
+	{
+		DynamicArray<FileChange> settled;
+
+		for (auto pending = Pending.begin(); pending != Pending.end();)
+		{
+			if (_now - pending->second.LastSeen < Meta::FileWatcher_Debounce)
+			{
+				pending++;
+
+				continue;
+			}
+
+			settled.push_back(move(pending->second.Change));
+
+			pending = Pending.erase(pending);
+		}
+
+		if (settled.empty()) return;
+
+		ScopedLock releaseGuard(ReleaseLock);
+
+		Released.insert(Released.end(), std::make_move_iterator(settled.begin()), std::make_move_iterator(settled.end()));
+	}
+}
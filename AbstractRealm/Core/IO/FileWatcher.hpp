@@ -0,0 +1,89 @@
+/*
+	File Watcher
+
+	Watches directories for changes and publishes them, batched and debounced, to its subscribers.
+
+	A worker thread polls the OS watches. Editors and exporters rarely write a file once (truncate, write, rename,
+	touch the timestamp...), so the changes of a path are coalesced into one and only released once the path has
+	been quiet for Meta::FileWatcher_Debounce. Released changes are queued until the owning cycler pumps them with
+	FileWatcher_DispatchEvents (the master cycler does so every cycle), so subscribers run on a known thread
+	and can reload engine state without locking.
+*/
+
+
+
+#pragma once
+
+
+
+// Engine
+#include "LAL/LAL.hpp"
+
+
+
+namespace Core::IO
+{
+	using namespace LAL;
+
+
+
+	// Enums
+
+	enum class EFileChange : u8
+	{
+		Added   ,
+		Modified,
+		Removed ,
+		Rescan      // The OS dropped changes under File (a watched directory), anything in it may have changed.
+	};
+
+
+
+	// Structs
+
+	using WatchID = u32;
+
+	constexpr WatchID InvalidWatch = 0;
+
+	using SubscriptionID = u32;
+
+	struct FileChange
+	{
+		WatchID     Watch;
+		Path        File;
+		EFileChange Change;
+	};
+
+	using FileChangeHandler = Function<void(const DynamicArray<FileChange>&)>;
+
+
+
+	// Functions
+
+	void Load_FileWatcher();
+
+	void Unload_FileWatcher();
+
+	/*
+	Starts watching _directory. Returns InvalidWatch if the directory cannot be watched.
+	*/
+	WatchID FileWatcher_Watch(const Path& _directory, bool _recursive = true);
+
+	void FileWatcher_Unwatch(WatchID _watch);
+
+	/*
+	Every dispatch hands the subscribers the whole batch of changes released since the last one,
+	in the order they subscribed (the VFS rescans its mounts before the engine reloads from them).
+	*/
+	SubscriptionID FileWatcher_Subscribe(FileChangeHandler&& _handler);
+
+	void FileWatcher_Unsubscribe(SubscriptionID _subscription);
+
+	/*
+	Publishes the debounced changes to the subscribers on the calling thread.
+	Returns the number of changes dispatched.
+	*/
+	uDM FileWatcher_DispatchEvents();
+
+	void FileWatcher_Record_EditorDevDebugUI();
+}
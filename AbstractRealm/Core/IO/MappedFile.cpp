@@ -0,0 +1,77 @@
+// Parent Header
+#include "MappedFile.hpp"
+
+
+
+namespace Core::IO
+{
+	// Public
+
+	MappedFile::MappedFile(const Path& _path, EMapAdvice _advice)
+	{
+		if (!Open(_path, _advice))
+		{
+			throw RuntimeError("MappedFile: Failed to map file at: " + _path.generic_string());
+		}
+	}
+
+	MappedFile::MappedFile(MappedFile&& _other) :
+		mapping(_other.mapping),
+		open   (_other.open   )
+	{
+		_other.mapping = OSAL::FileMapping();
+		_other.open    = false;
+	}
+
+	MappedFile& MappedFile::operator=(MappedFile&& _other)
+	{
+		if (this != getPtr(_other))
+		{
+			Close();
+
+			mapping = _other.mapping;
+			open    = _other.open   ;
+
+			_other.mapping = OSAL::FileMapping();
+			_other.open    = false;
+		}
+
+		return *this;
+	}
+
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+	bool MappedFile::Open(const Path& _path, EMapAdvice _advice)
+	{
+		Close();
+
+		if (!OSAL::MapFile(_path, OSAL::EMapAccess::ReadOnly, 0, mapping)) return false;
+
+		open = true;
+
+		Advise(_advice);
+
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+		if (!open) return;
+
+		OSAL::UnmapFile(mapping);
+
+		open = false;
+	}
+
+	void MappedFile::Advise(EMapAdvice _advice, uDM _offset, uDM _size) const
+	{
+		if (_offset >= mapping.Size) return;
+
+		if (_size == 0 || _size > mapping.Size - _offset) _size = mapping.Size - _offset;
+
+		OSAL::AdviseMapping(mapping, _offset, _size, _advice);
+	}
+}
@@ -0,0 +1,84 @@
+/*
+	Mapped File
+
+	Read-only zero copy access to a file through a memory mapping.
+
+	The view points straight into the OS page cache: nothing is allocated or copied up front,
+	pages are faulted in as they are touched. Prefer this over BufferFile for anything that is only parsed.
+*/
+
+
+
+#pragma once
+
+
+
+// Engine
+#include "LAL/LAL.hpp"
+#include "OSAL/OSAL_FileMapping.hpp"
+
+
+
+namespace Core::IO
+{
+	using namespace LAL;
+
+	using OSAL::EMapAdvice;
+
+
+
+	class MappedFile
+	{
+	public:
+
+		MappedFile() {}
+
+		/*
+		Maps the file, throws if it cannot be opened.
+		*/
+		MappedFile(const Path& _path, EMapAdvice _advice = EMapAdvice::Sequential);
+
+		MappedFile(MappedFile&& _other);
+
+		MappedFile& operator=(MappedFile&& _other);
+
+		MappedFile(const MappedFile&) = delete;
+
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		~MappedFile();
+
+		/*
+		Maps the whole file read-only and applies _advice to it.
+		Empty files open successfully with an empty view.
+		*/
+		bool Open(const Path& _path, EMapAdvice _advice = EMapAdvice::Sequential);
+
+		void Close();
+
+		bool IsOpen() const { return open; }
+
+		/*
+		Hints the expected access pattern of a range to the OS (madvise / PrefetchVirtualMemory).
+		A _size of 0 covers the rest of the file.
+		*/
+		void Advise(EMapAdvice _advice, uDM _offset = 0, uDM _size = 0) const;
+
+		ptr<const u8> Data() const { return RCast<const u8>(mapping.Address); }
+
+		uDM Size() const { return mapping.Size; }
+
+		bool Empty() const { return mapping.Size == 0; }
+
+		StringView View() const { return StringView(RCast<const char>(mapping.Address), mapping.Size); }
+
+		ptr<const u8> begin() const { return Data();          }
+		ptr<const u8> end  () const { return Data() + Size(); }
+
+	protected:
+
+		OSAL::FileMapping mapping;
+
+		bool open = false;
+	};
+}
@@ -0,0 +1,410 @@
+// Parent Header
+#include "PackArchive.hpp"
+
+
+
+// Engine
+#include "Basic_FileIO.hpp"
+#include "BlockStream.hpp"
+#include "Compression.hpp"
+
+#include <cstring>
+
+
+
+namespace Core::IO
+{
+	// Private
+
+	sInternal uDM AlignUp(uDM _value, uDM _alignment)
+	{
+		return (_value + _alignment - 1) / _alignment * _alignment;
+	}
+
+	// _offset + _size within _limit, without overflowing.
+	sInternal bool InRange(u64 _offset, u64 _size, u64 _limit)
+	{
+		return _offset <= _limit && _size <= _limit - _offset;
+	}
+
+	sInternal void WritePadding(File_OutputStream& _output, uDM _from, uDM _to)
+	{
+		static const StaticArray<char, PackAlignment> zeros = {};
+
+		for (uDM remaining = _to - _from; remaining > 0;)
+		{
+			uDM chunk = std::min(remaining, zeros.size());
+
+			_output.write(zeros.data(), std::streamsize(chunk));
+
+			remaining -= chunk;
+		}
+	}
+
+
+
+	// Functions
+
+	String PackNormalizePath(StringView _path)
+	{
+		String normalized;
+
+		normalized.reserve(_path.size());
+
+		for (char character : _path)
+		{
+			normalized.push_back(character == '\\' ? '/' : char(std::tolower(u8(character))));
+		}
+
+		while (normalized.compare(0, 2, "./") == 0) normalized.erase(0, 2);
+
+		return normalized;
+	}
+
+	u64 PackPathHash(StringView _path)
+	{
+		// FNV-1a over the normalized path, without building the normalized string.
+		u64 hash = 14695981039346656037ULL;
+
+		uDM start = 0;
+
+		while (_path.size() - start >= 2 && _path[start] == '.' && (_path[start + 1] == '/' || _path[start + 1] == '\\')) start += 2;
+
+		for (uDM index = start; index < _path.size(); index++)
+		{
+			char character = _path[index];
+
+			character = character == '\\' ? '/' : char(std::tolower(u8(character)));
+
+			hash ^= u8(character);
+			hash *= 1099511628211ULL;
+		}
+
+		return hash;
+	}
+
+
+
+	// PackArchive
+
+	bool PackArchive::Open(const Path& _path)
+	{
+		Close();
+
+		// Lookups and blob reads jump around the file.
+		if (!file.Open(_path, EMapAdvice::Random)) return false;
+
+		PackHeader header;
+
+		if (file.Size() < sizeof(header))
+		{
+			Close();
+
+			return false;
+		}
+
+		memcpy(&header, file.Data(), sizeof(header));
+
+		bool valid =
+			header.Magic   == PackMagic   &&
+			header.Version == PackVersion &&
+			header.TocOffset % alignof(PackEntry) == 0 &&
+			header.TocOffset <= file.Size() &&
+			header.EntryCount <= (file.Size() - header.TocOffset) / sizeof(PackEntry) &&
+			InRange(header.StringsOffset, header.StringsSize, file.Size());
+
+		if (!valid)
+		{
+			Close();
+
+			return false;
+		}
+
+		ptr<const PackEntry> toc = RCast<const PackEntry>(file.Data() + header.TocOffset);
+
+		// Reads and name lookups trust the entries from here on, a truncated or corrupt pack is not mounted.
+		for (uDM index = 0; index < uDM(header.EntryCount); index++)
+		{
+			const PackEntry& entry = toc[index];
+
+			bool entryValid =
+				InRange(entry.DataOffset, entry.StoredSize, file.Size())        &&
+				InRange(entry.NameOffset, entry.NameLength, header.StringsSize) &&
+				entry.Compression <= EPackCompression::LZ4Blocks                &&
+				(entry.Compression != EPackCompression::None || entry.Size <= entry.StoredSize) &&
+				entry.Size / LZ4_MaxRatio <= entry.StoredSize;   // Read allocates Size before decompressing.
+
+			if (!entryValid)
+			{
+				Close();
+
+				return false;
+			}
+		}
+
+		path       = _path;
+		entries    = toc;
+		entryCount = uDM(header.EntryCount);
+		strings    = RCast<const char>(file.Data() + header.StringsOffset);
+
+		// The table of contents is hit by every lookup, keep it resident.
+		file.Advise(EMapAdvice::WillNeed, uDM(header.TocOffset), file.Size() - uDM(header.TocOffset));
+
+		return true;
+	}
+
+	void PackArchive::Close()
+	{
+		file.Close();
+
+		path       = Path();
+		entries    = nullptr;
+		entryCount = 0;
+		strings    = nullptr;
+	}
+
+	ptr<const PackEntry> PackArchive::Find(StringView _path) const
+	{
+		if (!IsOpen()) return nullptr;
+
+		u64 hash = PackPathHash(_path);
+
+		auto range = std::equal_range
+		(
+			entries, entries + entryCount, hash,
+
+			[](const auto& _a, const auto& _b)
+			{
+				if constexpr (std::is_same_v<std::decay_t<decltype(_a)>, u64>)
+					return _a < _b.PathHash;
+				else
+					return _a.PathHash < _b;
+			}
+		);
+
+		if (range.first == range.second) return nullptr;
+
+		// Always by name: a single entry with the hash may still be another path that collides with it.
+		String normalized = PackNormalizePath(_path);
+
+		for (auto entry = range.first; entry != range.second; entry++)
+		{
+			if (GetName(*entry) == normalized) return entry;
+		}
+
+		return nullptr;
+	}
+
+	StringView PackArchive::GetName(const PackEntry& _entry) const
+	{
+		return StringView(strings + _entry.NameOffset, _entry.NameLength);
+	}
+
+	void PackArchive::Read(const PackEntry& _entry, ptr<u8> _destination, uDM _capacity) const
+	{
+		if (_capacity < _entry.Size) throw RuntimeError("PackArchive: Destination too small for: " + String(GetName(_entry)));
+
+		switch (_entry.Compression)
+		{
+			case EPackCompression::None:
+			{
+				memcpy(_destination, GetStored(_entry), uDM(_entry.Size));
+
+				break;
+			}
+			case EPackCompression::LZ4:
+			{
+				uDM size = LZ4_DecompressBlock(GetStored(_entry), uDM(_entry.StoredSize), _destination, uDM(_entry.Size));
+
+				if (size != _entry.Size) throw RuntimeError("PackArchive: Corrupt blob: " + String(GetName(_entry)));
+
+				break;
+			}
+			case EPackCompression::LZ4Blocks:
+			{
+				BlockStreamReader reader(GetStored(_entry), uDM(_entry.StoredSize));
+
+				if (reader.GetSize() != _entry.Size) throw RuntimeError("PackArchive: Corrupt blob: " + String(GetName(_entry)));
+
+				reader.DecompressAll(_destination, _capacity);
+
+				break;
+			}
+		}
+	}
+
+	DynamicArray<u8> PackArchive::Read(const PackEntry& _entry) const
+	{
+		DynamicArray<u8> data(uDM(_entry.Size));
+
+		Read(_entry, data.data(), data.size());
+
+		return data;
+	}
+
+
+
+	// PackBuilder
+
+	void PackBuilder::Add(StringView _path, const Path& _sourceFile, EPackCompression _compression)
+	{
+		pending.push_back({ PackNormalizePath(_path), _sourceFile, {}, _compression });
+	}
+
+	void PackBuilder::Add(StringView _path, DynamicArray<u8>&& _data, EPackCompression _compression)
+	{
+		pending.push_back({ PackNormalizePath(_path), Path(), move(_data), _compression });
+	}
+
+	void PackBuilder::AddDirectory(const Path& _directory, StringView _prefix, EPackCompression _compression)
+	{
+		using namespace std::filesystem;
+
+		for (auto& entry : recursive_directory_iterator(_directory))
+		{
+			if (!entry.is_regular_file()) continue;
+
+			Add(String(_prefix) + relative(entry.path(), _directory).generic_string(), entry.path(), _compression);
+		}
+	}
+
+	void PackBuilder::Build(const Path& _output)
+	{
+		File_OutputStream output;
+
+		if (!OpenFile(output, OpenFlags(EOpenFlag::ForOutput, EOpenFlag::BinaryMode, EOpenFlag::DiscardStreamContents), _output))
+		{
+			throw RuntimeError("PackBuilder: Failed to create: " + _output.generic_string());
+		}
+
+		DynamicArray<PackEntry> toc    ;
+		String                  strings;
+
+		toc.reserve(pending.size());
+
+		PackHeader header = {};
+
+		WritePadding(output, 0, sizeof(header));
+
+		uDM offset = sizeof(header);
+
+		DynamicArray<u8> compressed;
+
+		// Blobs go out in the order they were added (assets added together tend to be loaded together),
+		// one at a time so that only a single source is ever held in memory.
+		for (auto& entry : pending)
+		{
+			DynamicArray<u8> data = move(entry.data);
+
+			if (!entry.source.empty())
+			{
+				FileBuffer source = BufferFile(entry.source);
+
+				data.assign(source.begin(), source.end());
+			}
+
+			ptr<const u8>    stored      = data.data();
+			uDM              storedSize  = data.size();
+			EPackCompression compression = EPackCompression::None;
+
+			if (entry.compression != EPackCompression::None && !data.empty())
+			{
+				EPackCompression candidate = data.size() >= PackBlockStreamSize ? EPackCompression::LZ4Blocks : EPackCompression::LZ4;
+
+				uDM compressedSize = 0;
+
+				if (candidate == EPackCompression::LZ4Blocks)
+				{
+					compressed = BlockStream_Compress(data.data(), data.size());
+
+					compressedSize = compressed.size();
+				}
+				else
+				{
+					compressed.resize(LZ4_CompressBound(data.size()));
+
+					compressedSize = LZ4_CompressBlock(data.data(), data.size(), compressed.data(), compressed.size());
+				}
+
+				if (compressedSize > 0 && compressedSize <= data.size() - data.size() / 8)
+				{
+					stored      = compressed.data();
+					storedSize  = compressedSize;
+					compression = candidate;
+				}
+			}
+
+			uDM aligned = AlignUp(offset, storedSize >= PackLargeBlobSize ? PackLargeAlignment : PackAlignment);
+
+			WritePadding(output, offset, aligned);
+
+			output.write(RCast<const char>(stored), std::streamsize(storedSize));
+
+			PackEntry packEntry = {};
+
+			packEntry.PathHash    = PackPathHash(entry.name);
+			packEntry.DataOffset  = aligned;
+			packEntry.StoredSize  = storedSize;
+			packEntry.Size        = data.size();
+			packEntry.NameOffset  = u32(strings.size());
+			packEntry.NameLength  = u32(entry.name.size());
+			packEntry.Compression = compression;
+
+			toc.push_back(packEntry);
+
+			strings += entry.name;
+
+			offset = aligned + storedSize;
+		}
+
+		auto nameOf = [&strings](const PackEntry& _entry)
+		{
+			return StringView(strings.data() + _entry.NameOffset, _entry.NameLength);
+		};
+
+		// Names break ties, entries sharing a hash are ordered by name so equal names end up adjacent.
+		std::sort
+		(
+			toc.begin(), toc.end(),
+
+			[&nameOf](const PackEntry& _a, const PackEntry& _b)
+			{
+				if (_a.PathHash != _b.PathHash) return _a.PathHash < _b.PathHash;
+
+				return nameOf(_a) < nameOf(_b);
+			}
+		);
+
+		for (uDM index = 1; index < toc.size(); index++)
+		{
+			if (toc[index - 1].PathHash != toc[index].PathHash) continue;
+
+			if (nameOf(toc[index - 1]) == nameOf(toc[index])) throw RuntimeError("PackBuilder: Duplicate entry: " + String(nameOf(toc[index])));
+		}
+
+		uDM tocOffset = AlignUp(offset, alignof(PackEntry));
+
+		WritePadding(output, offset, tocOffset);
+
+		output.write(RCast<const char>(toc.data()), std::streamsize(toc.size() * sizeof(PackEntry)));
+
+		output.write(strings.data(), std::streamsize(strings.size()));
+
+		header.Magic         = PackMagic;
+		header.Version       = PackVersion;
+		header.EntryCount    = toc.size();
+		header.TocOffset     = tocOffset;
+		header.StringsOffset = tocOffset + toc.size() * sizeof(PackEntry);
+		header.StringsSize   = strings.size();
+
+		output.seekp(0);
+
+		output.write(RCast<const char>(&header), sizeof(header));
+
+		output.close();
+
+		if (!output) throw RuntimeError("PackBuilder: Failed writing: " + _output.generic_string());
+
+		pending.clear();
+	}
+}
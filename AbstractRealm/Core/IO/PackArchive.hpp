@@ -0,0 +1,178 @@
+/*
+	Pack Archive
+
+	A single file holding many assets, read through one memory mapping.
+
+	Layout: [Header][Blobs][Table of contents][Path strings]
+
+	Blobs are aligned (4 KB, 64 KB for large ones) so they can be mapped or copied into staging memory as is.
+	The table of contents is sorted by path hash, lookups are a binary search with no file system access.
+	Each blob is stored raw, as a single LZ4 block, or as a block stream (large blobs) that decodes in parallel.
+*/
+
+
+
+#pragma once
+
+
+
+// Engine
+#include "LAL/LAL.hpp"
+#include "MappedFile.hpp"
+
+
+
+namespace Core::IO
+{
+	using namespace LAL;
+
+
+
+	// Enums
+
+	enum class EPackCompression : u8
+	{
+		None     ,
+		LZ4      ,   // Kept only when it saves at least an eighth of the size.
+		LZ4Blocks    // Picked by the builder instead of LZ4 for blobs of PackBlockStreamSize and up.
+	};
+
+
+
+	// Structs
+
+	POD PackHeader
+	{
+		u32 Magic;
+		u32 Version;
+		u64 EntryCount;
+		u64 TocOffset;
+		u64 StringsOffset;
+		u64 StringsSize;
+		u64 Reserved[3];
+	};
+
+	POD PackEntry
+	{
+		u64              PathHash;
+		u64              DataOffset;
+		u64              StoredSize;    // Size in the pack.
+		u64              Size;          // Size once decompressed.
+		u32              NameOffset;    // Into the path strings.
+		u32              NameLength;
+		EPackCompression Compression;
+		u8               Padding[7];
+	};
+
+
+
+	// Compile-Time
+
+	constexpr u32 PackMagic   = 0x4B505241;   // "ARPK"
+	constexpr u32 PackVersion = 1;
+
+	constexpr uDM PackAlignment       = 4  * 1024;
+	constexpr uDM PackLargeAlignment  = 64 * 1024;
+	constexpr uDM PackLargeBlobSize   = 1024 * 1024;   // Blobs this size or larger use the large alignment.
+	constexpr uDM PackBlockStreamSize = 512  * 1024;   // Compressed blobs this size or larger become block streams.
+
+
+
+	// Functions
+
+	/*
+	Hashes a path the way the pack stores it: forward slashes, no leading "./", lower case.
+	*/
+	u64 PackPathHash(StringView _path);
+
+	String PackNormalizePath(StringView _path);
+
+
+
+	// Classes
+
+	class PackArchive
+	{
+	public:
+
+		PackArchive() {}
+
+		bool Open(const Path& _path);
+
+		void Close();
+
+		bool IsOpen() const { return file.IsOpen(); }
+
+		/*
+		Returns the entry of _path, or null if the pack does not contain it.
+		*/
+		ptr<const PackEntry> Find(StringView _path) const;
+
+		StringView GetName(const PackEntry& _entry) const;
+
+		/*
+		The bytes of the blob as stored in the pack (compressed if the entry is).
+		*/
+		ptr<const u8> GetStored(const PackEntry& _entry) const { return file.Data() + _entry.DataOffset; }
+
+		/*
+		Writes the blob into _destination (decompressing if needed), _capacity must be at least _entry.Size.
+		*/
+		void Read(const PackEntry& _entry, ptr<u8> _destination, uDM _capacity) const;
+
+		DynamicArray<u8> Read(const PackEntry& _entry) const;
+
+		uDM GetEntryCount() const { return entryCount; }
+
+		ptr<const PackEntry> GetEntries() const { return entries; }
+
+		const Path& GetPath() const { return path; }
+
+	protected:
+
+		MappedFile file;
+
+		Path path;
+
+		ptr<const PackEntry> entries    = nullptr;
+		uDM                  entryCount = 0;
+		ptr<const char>      strings    = nullptr;
+	};
+
+
+	/*
+	Collects files (or in memory blobs) and writes them out as a pack.
+	*/
+	class PackBuilder
+	{
+	public:
+
+		void Add(StringView _path, const Path& _sourceFile, EPackCompression _compression = EPackCompression::LZ4);
+
+		void Add(StringView _path, DynamicArray<u8>&& _data, EPackCompression _compression = EPackCompression::LZ4);
+
+		/*
+		Adds every file under _directory, named by their path relative to it prefixed with _prefix.
+		*/
+		void AddDirectory(const Path& _directory, StringView _prefix, EPackCompression _compression = EPackCompression::LZ4);
+
+		/*
+		Writes the pack, throws if an entry cannot be read or the output cannot be written.
+		*/
+		void Build(const Path& _output);
+
+		uDM GetEntryCount() const { return pending.size(); }
+
+	protected:
+
+		struct PendingEntry
+		{
+			String           name;
+			Path             source;
+			DynamicArray<u8> data;
+			EPackCompression compression;
+		};
+
+		DynamicArray<PendingEntry> pending;
+	};
+}
@@ -0,0 +1,337 @@
+// Parent Header
+#include "Serialization.hpp"
+
+
+
+// Engine
+#include "Basic_FileIO.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+
+
+namespace Core::IO
+{
+	// Private
+
+	StaticData()
+
+		sInternal Atomic<u32> TemporaryID;
+
+
+
+	// BinaryWriter
+
+	void BinaryWriter::Write(ptr<const void> _data, uDM _size)
+	{
+		if (_size == 0) return;
+
+		uDM offset = buffer.size();
+
+		buffer.resize(offset + _size);
+
+		memcpy(buffer.data() + offset, _data, _size);
+	}
+
+	uDM BinaryWriter::Reserve(uDM _size)
+	{
+		uDM offset = buffer.size();
+
+		buffer.resize(offset + _size);
+
+		return offset;
+	}
+
+	void BinaryWriter::Patch(uDM _offset, ptr<const void> _data, uDM _size)
+	{
+		if (_offset + _size > buffer.size()) throw RuntimeError("BinaryWriter: Patch outside of the written data.");
+
+		memcpy(buffer.data() + _offset, _data, _size);
+	}
+
+
+
+	// BinaryReader
+
+	void BinaryReader::Read(ptr<void> _destination, uDM _size)
+	{
+		if (_size > size - offset) throw RuntimeError("BinaryReader: Read past the end of the data.");
+
+		if (_size == 0) return;
+
+		memcpy(_destination, data + offset, _size);
+
+		offset += _size;
+	}
+
+	void BinaryReader::Seek(uDM _offset)
+	{
+		if (_offset > size) throw RuntimeError("BinaryReader: Seek past the end of the data.");
+
+		offset = _offset;
+	}
+
+
+
+	// JsonWriter
+
+	void JsonWriter::BeginObject()
+	{
+		Separate();
+
+		text += '{';
+
+		scopeHasValues.push_back(false);
+	}
+
+	void JsonWriter::EndObject()
+	{
+		bool hadValues = scopeHasValues.back();
+
+		scopeHasValues.pop_back();
+
+		if (hadValues) Indent();
+
+		text += '}';
+	}
+
+	void JsonWriter::BeginArray()
+	{
+		Separate();
+
+		text += '[';
+
+		scopeHasValues.push_back(false);
+	}
+
+	void JsonWriter::EndArray()
+	{
+		bool hadValues = scopeHasValues.back();
+
+		scopeHasValues.pop_back();
+
+		if (hadValues) Indent();
+
+		text += ']';
+	}
+
+	void JsonWriter::Key(StringView _key)
+	{
+		Separate();
+
+		WriteString(_key);
+
+		text += ": ";
+
+		afterKey = true;
+	}
+
+	void JsonWriter::Value(bool _value)
+	{
+		Separate();
+
+		text += _value ? "true" : "false";
+	}
+
+	void JsonWriter::Value(s64 _value)
+	{
+		Separate();
+
+		text += std::to_string(_value);
+	}
+
+	void JsonWriter::Value(u64 _value)
+	{
+		Separate();
+
+		text += std::to_string(_value);
+	}
+
+	void JsonWriter::Value(f32 _value)
+	{
+		Separate();
+
+		Number(_value, 9);
+	}
+
+	void JsonWriter::Value(f64 _value)
+	{
+		Separate();
+
+		Number(_value, 17);
+	}
+
+	void JsonWriter::Value(StringView _value)
+	{
+		Separate();
+
+		WriteString(_value);
+	}
+
+	void JsonWriter::Bytes(ptr<const void> _data, uDM _size)
+	{
+		constexpr char digits[] = "0123456789abcdef";
+
+		Separate();
+
+		ptr<const u8> bytes = RCast<const u8>(_data);
+
+		text += '"';
+
+		for (uDM index = 0; index < _size; index++)
+		{
+			text += digits[bytes[index] >> 4 ];
+			text += digits[bytes[index] & 0xF];
+		}
+
+		text += '"';
+	}
+
+	void JsonWriter::Separate()
+	{
+		// A value right after its key stays on the key's line.
+		if (afterKey)
+		{
+			afterKey = false;
+
+			return;
+		}
+
+		if (scopeHasValues.empty()) return;
+
+		if (scopeHasValues.back()) text += ',';
+
+		scopeHasValues.back() = true;
+
+		Indent();
+	}
+
+	void JsonWriter::Number(f64 _value, int _digits)
+	{
+		// JSON has no infinities or NaN.
+		if (!std::isfinite(_value))
+		{
+			text += "null";
+
+			return;
+		}
+
+		// Enough digits to read back the exact value.
+		char number[32];
+
+		snprintf(number, sizeof(number), "%.*g", _digits, _value);
+
+		text += number;
+	}
+
+	void JsonWriter::Indent()
+	{
+		text += '\n';
+
+		text.append(scopeHasValues.size(), '\t');
+	}
+
+	void JsonWriter::WriteString(StringView _string)
+	{
+		constexpr char digits[] = "0123456789abcdef";
+
+		text += '"';
+
+		for (char character : _string)
+		{
+			switch (character)
+			{
+				case '"' : text += "\\\""; break;
+				case '\\': text += "\\\\"; break;
+				case '\n': text += "\\n" ; break;
+				case '\r': text += "\\r" ; break;
+				case '\t': text += "\\t" ; break;
+
+				default:
+				{
+					if (u8(character) < 0x20)
+					{
+						text += "\\u00";
+						text += digits[u8(character) >> 4 ];
+						text += digits[u8(character) & 0xF];
+					}
+					else
+					{
+						text += character;
+					}
+				}
+			}
+		}
+
+		text += '"';
+	}
+
+
+
+	// Functions
+
+	void Serialize(BinaryWriter& _writer, const String& _value)
+	{
+		_writer.WriteValue(u64(_value.size()));
+
+		_writer.Write(_value.data(), _value.size());
+	}
+
+	void Deserialize(BinaryReader& _reader, String& _value)
+	{
+		u64 length;
+
+		_reader.ReadValue(length);
+
+		if (length > _reader.Remaining()) throw RuntimeError("Deserialize: Truncated string.");
+
+		_value.resize(uDM(length));
+
+		_reader.Read(_value.data(), _value.size());
+	}
+
+	void SerializeJson(JsonWriter& _writer, const String& _value)
+	{
+		_writer.Value(StringView(_value));
+	}
+
+	void Serialization_WriteFile(const Path& _file, ptr<const void> _data, uDM _size)
+	{
+		std::error_code error;
+
+		if (_file.has_parent_path()) std::filesystem::create_directories(_file.parent_path(), error);
+
+		Path temporary = _file;
+
+		temporary += "." + LAL::ToString(u32(TemporaryID++)) + ".tmp";
+
+		File_OutputStream output;
+
+		if (!OpenFile(output, OpenFlags(EOpenFlag::ForOutput, EOpenFlag::BinaryMode, EOpenFlag::DiscardStreamContents), temporary))
+		{
+			throw RuntimeError("Serialization: Could not open " + temporary.generic_string());
+		}
+
+		output.write(RCast<const char>(_data), std::streamsize(_size));
+
+		output.close();
+
+		if (!output)
+		{
+			std::filesystem::remove(temporary, error);
+
+			throw RuntimeError("Serialization: Could not write " + temporary.generic_string());
+		}
+
+		std::filesystem::rename(temporary, _file, error);
+
+		if (error)
+		{
+			std::filesystem::remove(temporary, error);
+
+			throw RuntimeError("Serialization: Could not replace " + _file.generic_string());
+		}
+	}
+}
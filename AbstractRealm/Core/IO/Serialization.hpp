@@ -0,0 +1,655 @@
+/*
+	Serialization
+
+	Reflection driven binary serialization, with a JSON writer for debugging.
+
+	A type is made serializable by listing its fields once, at global scope:
+
+		ReflectType(Game::Inventory, 2)
+			ReflectField(Items)
+			ReflectField(Gold)
+			ReflectFieldSince(Capacity, 2)   // Added in version 2, left as is when loading version 1 data.
+		ReflectEnd()
+
+	Reflected types are written as their schema version, their byte size, then their fields in order. Fields newer than
+	the stored version are skipped on load, and the byte size lets older code skip fields appended by newer versions.
+
+	Plain types that are not reflected (arithmetic, enums, trivially copyable structs like vertices) are written
+	as their raw bytes, and arrays of them as a single copy, so bulk data goes at memory bandwidth.
+	The binary format is native endian and meant for saves, snapshots and caches on the same platform.
+*/
+
+
+
+#pragma once
+
+
+
+// Engine
+#include "LAL/LAL.hpp"
+#include "MappedFile.hpp"
+
+
+
+namespace Core::IO
+{
+	using namespace LAL;
+
+
+
+	// Reflection
+
+	template<typename Type>
+	struct Reflection
+	{
+		static constexpr bool Defined = false;
+	};
+
+	template<typename Type>
+	constexpr bool IsReflected() { return Reflection<RawType<Type>>::Defined; }
+
+	/*
+	Serialized as raw bytes: trivially copyable and without a field list of its own.
+	*/
+	template<typename Type>
+	constexpr bool IsRawSerializable() { return std::is_trivially_copyable_v<Type> && !IsReflected<Type>() && !IsPointer<Type>(); }
+
+
+
+	// Binary
+
+	class BinaryWriter
+	{
+	public:
+
+		void Write(ptr<const void> _data, uDM _size);
+
+		template<typename Type>
+		void WriteValue(const Type& _value) { Write(getPtr(_value), sizeof(Type)); }
+
+		/*
+		Appends _size bytes to fill in later with Patch, returns their offset.
+		*/
+		uDM Reserve(uDM _size);
+
+		void Patch(uDM _offset, ptr<const void> _data, uDM _size);
+
+		uDM Size() const { return buffer.size(); }
+
+		const DynamicArray<u8>& GetBuffer() const { return buffer; }
+
+		DynamicArray<u8> TakeBuffer() { return move(buffer); }
+
+	protected:
+
+		DynamicArray<u8> buffer;
+	};
+
+	class BinaryReader
+	{
+	public:
+
+		BinaryReader(ptr<const u8> _data, uDM _size) : data(_data), size(_size) {}
+
+		/*
+		Throws if the data runs out.
+		*/
+		void Read(ptr<void> _destination, uDM _size);
+
+		template<typename Type>
+		void ReadValue(Type& _value) { Read(getPtr(_value), sizeof(Type)); }
+
+		uDM Tell() const { return offset; }
+
+		void Seek(uDM _offset);
+
+		uDM Remaining() const { return size - offset; }
+
+	protected:
+
+		ptr<const u8> data;
+		uDM           size;
+		uDM           offset = 0;
+	};
+
+
+
+	// JSON
+
+	class JsonWriter
+	{
+	public:
+
+		void BeginObject();
+		void EndObject  ();
+
+		void BeginArray();
+		void EndArray  ();
+
+		void Key(StringView _key);
+
+		void Value(bool       _value);
+		void Value(s64        _value);
+		void Value(u64        _value);
+		void Value(f32        _value);
+		void Value(f64        _value);
+		void Value(StringView _value);
+
+		/*
+		Opaque data, written as a hex string.
+		*/
+		void Bytes(ptr<const void> _data, uDM _size);
+
+		const String& GetText() const { return text; }
+
+	protected:
+
+		void Separate();
+
+		void Number(f64 _value, int _digits);
+
+		void Indent();
+
+		void WriteString(StringView _string);
+
+		String text;
+
+		DynamicArray<bool> scopeHasValues;
+
+		bool afterKey = false;
+	};
+
+
+
+	// Functions (declared first so the container overloads find each other)
+
+	template<typename Type>
+	void Serialize(BinaryWriter& _writer, const Type& _value);
+
+	void Serialize(BinaryWriter& _writer, const String& _value);
+
+	template<typename Type>
+	void Serialize(BinaryWriter& _writer, const DynamicArray<Type>& _value);
+
+	template<typename Type, uDM Size>
+	void Serialize(BinaryWriter& _writer, const StaticArray<Type, Size>& _value);
+
+	template<typename TypeA, typename TypeB>
+	void Serialize(BinaryWriter& _writer, const std::pair<TypeA, TypeB>& _value);
+
+	template<typename KeyType, typename ValueType>
+	void Serialize(BinaryWriter& _writer, const UnorderedMap<KeyType, ValueType>& _value);
+
+	template<typename Type>
+	void Deserialize(BinaryReader& _reader, Type& _value);
+
+	void Deserialize(BinaryReader& _reader, String& _value);
+
+	template<typename Type>
+	void Deserialize(BinaryReader& _reader, DynamicArray<Type>& _value);
+
+	template<typename Type, uDM Size>
+	void Deserialize(BinaryReader& _reader, StaticArray<Type, Size>& _value);
+
+	template<typename TypeA, typename TypeB>
+	void Deserialize(BinaryReader& _reader, std::pair<TypeA, TypeB>& _value);
+
+	template<typename KeyType, typename ValueType>
+	void Deserialize(BinaryReader& _reader, UnorderedMap<KeyType, ValueType>& _value);
+
+	template<typename Type>
+	void SerializeJson(JsonWriter& _writer, const Type& _value);
+
+	void SerializeJson(JsonWriter& _writer, const String& _value);
+
+	template<typename Type>
+	void SerializeJson(JsonWriter& _writer, const DynamicArray<Type>& _value);
+
+	template<typename Type, uDM Size>
+	void SerializeJson(JsonWriter& _writer, const StaticArray<Type, Size>& _value);
+
+	template<typename TypeA, typename TypeB>
+	void SerializeJson(JsonWriter& _writer, const std::pair<TypeA, TypeB>& _value);
+
+	template<typename KeyType, typename ValueType>
+	void SerializeJson(JsonWriter& _writer, const UnorderedMap<KeyType, ValueType>& _value);
+
+	/*
+	Writes _size bytes to _file through a temporary, so an interrupted save never replaces a good file.
+	Throws on failure.
+	*/
+	void Serialization_WriteFile(const Path& _file, ptr<const void> _data, uDM _size);
+
+
+
+	// Binary file format
+
+	constexpr u32 SerializedMagic   = 0x5A535241;   // "ARSZ"
+	constexpr u32 SerializedVersion = 1;
+
+
+
+	// Convenience
+
+	template<typename Type>
+	DynamicArray<u8> ToBinary(const Type& _value)
+	{
+		BinaryWriter writer;
+
+		Serialize(writer, _value);
+
+		return writer.TakeBuffer();
+	}
+
+	template<typename Type>
+	void FromBinary(ptr<const u8> _data, uDM _size, Type& _value)
+	{
+		BinaryReader reader(_data, _size);
+
+		Deserialize(reader, _value);
+	}
+
+	template<typename Type>
+	String ToJson(const Type& _value)
+	{
+		JsonWriter writer;
+
+		SerializeJson(writer, _value);
+
+		return writer.GetText();
+	}
+
+	template<typename Type>
+	void Save_Binary(const Path& _file, const Type& _value)
+	{
+		BinaryWriter writer;
+
+		writer.WriteValue(SerializedMagic  );
+		writer.WriteValue(SerializedVersion);
+
+		Serialize(writer, _value);
+
+		Serialization_WriteFile(_file, writer.GetBuffer().data(), writer.Size());
+	}
+
+	template<typename Type>
+	void Load_Binary(const Path& _file, Type& _value)
+	{
+		MappedFile file(_file, EMapAdvice::Sequential);
+
+		BinaryReader reader(file.Data(), file.Size());
+
+		u32 magic = 0, version = 0;
+
+		reader.ReadValue(magic  );
+		reader.ReadValue(version);
+
+		if (magic != SerializedMagic || version != SerializedVersion)
+		{
+			throw RuntimeError("Load_Binary: Not a serialized file: " + _file.generic_string());
+		}
+
+		Deserialize(reader, _value);
+	}
+
+	template<typename Type>
+	void Save_Json(const Path& _file, const Type& _value)
+	{
+		String text = ToJson(_value);
+
+		Serialization_WriteFile(_file, text.data(), text.size());
+	}
+
+
+
+	// Field visitors
+
+	struct FieldWriter
+	{
+		BinaryWriter& Writer;
+
+		template<typename FieldType>
+		void operator()(RoCStr _name, const FieldType& _field, u32 _since) { Serialize(Writer, _field); }
+	};
+
+	struct FieldReader
+	{
+		BinaryReader& Reader;
+		u32           Version;   // Of the stored data.
+
+		template<typename FieldType>
+		void operator()(RoCStr _name, FieldType& _field, u32 _since)
+		{
+			if (_since <= Version) Deserialize(Reader, _field);
+		}
+	};
+
+	struct FieldJsonWriter
+	{
+		JsonWriter& Writer;
+
+		template<typename FieldType>
+		void operator()(RoCStr _name, const FieldType& _field, u32 _since)
+		{
+			Writer.Key(_name);
+
+			SerializeJson(Writer, _field);
+		}
+	};
+
+
+
+	// Binary
+
+	template<typename Type>
+	void Serialize(BinaryWriter& _writer, const Type& _value)
+	{
+		static_assert(!IsPointer<Type>(), "Serialize: Pointers cannot be serialized.");
+
+		if constexpr (IsReflected<Type>())
+		{
+			_writer.WriteValue(u32(Reflection<Type>::Version));
+
+			uDM sizeOffset = _writer.Reserve(sizeof(u64));
+
+			FieldWriter visitor { _writer };
+
+			Reflection<Type>::Visit(_value, visitor);
+
+			u64 size = _writer.Size() - sizeOffset - sizeof(u64);
+
+			_writer.Patch(sizeOffset, getPtr(size), sizeof(size));
+		}
+		else
+		{
+			static_assert(IsRawSerializable<Type>(), "Serialize: Type has no reflection and is not trivially copyable.");
+
+			_writer.WriteValue(_value);
+		}
+	}
+
+	template<typename Type>
+	void Serialize(BinaryWriter& _writer, const DynamicArray<Type>& _value)
+	{
+		_writer.WriteValue(u64(_value.size()));
+
+		if constexpr (IsRawSerializable<Type>() && !IsSameTypeCV<Type, bool>())
+		{
+			_writer.Write(_value.data(), _value.size() * sizeof(Type));
+		}
+		else
+		{
+			for (const Type& element : _value) Serialize(_writer, element);
+		}
+	}
+
+	template<typename Type, uDM Size>
+	void Serialize(BinaryWriter& _writer, const StaticArray<Type, Size>& _value)
+	{
+		if constexpr (IsRawSerializable<Type>())
+		{
+			_writer.Write(_value.data(), Size * sizeof(Type));
+		}
+		else
+		{
+			for (const Type& element : _value) Serialize(_writer, element);
+		}
+	}
+
+	template<typename TypeA, typename TypeB>
+	void Serialize(BinaryWriter& _writer, const std::pair<TypeA, TypeB>& _value)
+	{
+		Serialize(_writer, _value.first );
+		Serialize(_writer, _value.second);
+	}
+
+	template<typename KeyType, typename ValueType>
+	void Serialize(BinaryWriter& _writer, const UnorderedMap<KeyType, ValueType>& _value)
+	{
+		_writer.WriteValue(u64(_value.size()));
+
+		for (auto& entry : _value)
+		{
+			Serialize(_writer, entry.first );
+			Serialize(_writer, entry.second);
+		}
+	}
+
+	template<typename Type>
+	void Deserialize(BinaryReader& _reader, Type& _value)
+	{
+		static_assert(!IsPointer<Type>(), "Deserialize: Pointers cannot be serialized.");
+
+		if constexpr (IsReflected<Type>())
+		{
+			u32 version;
+			u64 size   ;
+
+			_reader.ReadValue(version);
+			_reader.ReadValue(size   );
+
+			if (size > _reader.Remaining()) throw RuntimeError("Deserialize: Truncated record.");
+
+			uDM end = _reader.Tell() + uDM(size);
+
+			FieldReader visitor { _reader, version };
+
+			Reflection<Type>::Visit(_value, visitor);
+
+			if (_reader.Tell() > end) throw RuntimeError("Deserialize: Record overran its size.");
+
+			// Fields appended by a newer version are skipped.
+			_reader.Seek(end);
+		}
+		else
+		{
+			static_assert(IsRawSerializable<Type>(), "Deserialize: Type has no reflection and is not trivially copyable.");
+
+			_reader.ReadValue(_value);
+		}
+	}
+
+	template<typename Type>
+	void Deserialize(BinaryReader& _reader, DynamicArray<Type>& _value)
+	{
+		u64 count;
+
+		_reader.ReadValue(count);
+
+		if constexpr (IsRawSerializable<Type>() && !IsSameTypeCV<Type, bool>())
+		{
+			if (count > _reader.Remaining() / sizeof(Type)) throw RuntimeError("Deserialize: Truncated array.");
+
+			_value.resize(uDM(count));
+
+			_reader.Read(_value.data(), _value.size() * sizeof(Type));
+		}
+		else
+		{
+			// Every element takes at least a byte, a corrupt count fails here rather than in the allocation.
+			if (count > _reader.Remaining()) throw RuntimeError("Deserialize: Truncated array.");
+
+			_value.clear();
+
+			_value.resize(uDM(count));
+
+			for (uDM index = 0; index < _value.size(); index++)
+			{
+				Type element;
+
+				Deserialize(_reader, element);
+
+				_value[index] = move(element);
+			}
+		}
+	}
+
+	template<typename Type, uDM Size>
+	void Deserialize(BinaryReader& _reader, StaticArray<Type, Size>& _value)
+	{
+		if constexpr (IsRawSerializable<Type>())
+		{
+			_reader.Read(_value.data(), Size * sizeof(Type));
+		}
+		else
+		{
+			for (Type& element : _value) Deserialize(_reader, element);
+		}
+	}
+
+	template<typename TypeA, typename TypeB>
+	void Deserialize(BinaryReader& _reader, std::pair<TypeA, TypeB>& _value)
+	{
+		Deserialize(_reader, _value.first );
+		Deserialize(_reader, _value.second);
+	}
+
+	template<typename KeyType, typename ValueType>
+	void Deserialize(BinaryReader& _reader, UnorderedMap<KeyType, ValueType>& _value)
+	{
+		u64 count;
+
+		_reader.ReadValue(count);
+
+		if (count > _reader.Remaining()) throw RuntimeError("Deserialize: Truncated map.");
+
+		_value.clear();
+
+		_value.reserve(uDM(count));
+
+		for (u64 index = 0; index < count; index++)
+		{
+			KeyType   key  ;
+			ValueType value;
+
+			Deserialize(_reader, key  );
+			Deserialize(_reader, value);
+
+			_value.emplace(move(key), move(value));
+		}
+	}
+
+
+
+	// JSON
+
+	template<typename Type>
+	void SerializeJson(JsonWriter& _writer, const Type& _value)
+	{
+		if constexpr (IsReflected<Type>())
+		{
+			_writer.BeginObject();
+
+			FieldJsonWriter visitor { _writer };
+
+			Reflection<Type>::Visit(_value, visitor);
+
+			_writer.EndObject();
+		}
+		else if constexpr (IsSameTypeCV<Type, bool>())
+		{
+			_writer.Value(_value);
+		}
+		else if constexpr (IsSameTypeCV<Type, f32>())
+		{
+			_writer.Value(_value);
+		}
+		else if constexpr (std::is_floating_point_v<Type>)
+		{
+			_writer.Value(f64(_value));
+		}
+		else if constexpr (std::is_integral_v<Type>)
+		{
+			if constexpr (IsSigned<Type>()) _writer.Value(s64(_value));
+			else                            _writer.Value(u64(_value));
+		}
+		else if constexpr (IsEnum<Type>())
+		{
+			StringView name = nameOf(_value);
+
+			if (!name.empty()) _writer.Value(name);
+			else               _writer.Value(s64(_value));
+		}
+		else
+		{
+			static_assert(IsRawSerializable<Type>(), "SerializeJson: Type has no reflection and is not trivially copyable.");
+
+			_writer.Bytes(getPtr(_value), sizeof(Type));
+		}
+	}
+
+	template<typename Type>
+	void SerializeJson(JsonWriter& _writer, const DynamicArray<Type>& _value)
+	{
+		_writer.BeginArray();
+
+		for (const Type& element : _value) SerializeJson(_writer, element);
+
+		_writer.EndArray();
+	}
+
+	template<typename Type, uDM Size>
+	void SerializeJson(JsonWriter& _writer, const StaticArray<Type, Size>& _value)
+	{
+		_writer.BeginArray();
+
+		for (const Type& element : _value) SerializeJson(_writer, element);
+
+		_writer.EndArray();
+	}
+
+	template<typename TypeA, typename TypeB>
+	void SerializeJson(JsonWriter& _writer, const std::pair<TypeA, TypeB>& _value)
+	{
+		_writer.BeginArray();
+
+		SerializeJson(_writer, _value.first );
+		SerializeJson(_writer, _value.second);
+
+		_writer.EndArray();
+	}
+
+	template<typename KeyType, typename ValueType>
+	void SerializeJson(JsonWriter& _writer, const UnorderedMap<KeyType, ValueType>& _value)
+	{
+		_writer.BeginArray();
+
+		for (auto& entry : _value)
+		{
+			_writer.BeginObject();
+
+			_writer.Key("Key"  ); SerializeJson(_writer, entry.first );
+			_writer.Key("Value"); SerializeJson(_writer, entry.second);
+
+			_writer.EndObject();
+		}
+
+		_writer.EndArray();
+	}
+}
+
+
+
+// Field list macros (used at global scope).
+
+#define ReflectType(__TYPE, __VERSION)                                 \
+template<>                                                             \
+struct Core::IO::Reflection<__TYPE>                                    \
+{                                                                      \
+	static constexpr bool        Defined = true     ;                  \
+	static constexpr LAL::u32    Version = __VERSION;                  \
+	static constexpr LAL::RoCStr Name    = #__TYPE  ;                  \
+                                                                       \
+	template<typename ObjectType, typename VisitorType>                \
+	static void Visit(ObjectType& _object, VisitorType& _visitor)      \
+	{
+
+#define ReflectFieldSince(__MEMBER, __SINCE) \
+		_visitor(#__MEMBER, _object.__MEMBER, LAL::u32(__SINCE));
+
+#define ReflectField(__MEMBER) \
+		ReflectFieldSince(__MEMBER, 1)
+
+#define ReflectEnd() \
+	}                \
+};
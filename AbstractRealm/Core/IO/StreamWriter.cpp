@@ -0,0 +1,242 @@
+// Parent Header
+#include "StreamWriter.hpp"
+
+
+
+// Engine
+#include "Meta/Config/CoreDev_Config.hpp"
+
+#include <cstring>
+#include <new>
+
+
+
+namespace Core::IO
+{
+	StreamWriter::~StreamWriter()
+	{
+		Close();
+	}
+
+	bool StreamWriter::Open(const Path& _path, uDM _bufferSize, uDM _bufferCount)
+	{
+		Close();
+
+		if (_bufferSize  == 0) _bufferSize  = Meta::StreamWriter_BufferSize ;
+		if (_bufferCount == 0) _bufferCount = Meta::StreamWriter_BufferCount;
+
+		if (!OSAL::OpenOutputFile(_path, file)) return false;
+
+		// Page aligned and page sized, so the buffers stay eligible for unbuffered writes.
+		bufferSize  = (_bufferSize + Meta::StreamWriter_Alignment - 1) / Meta::StreamWriter_Alignment * Meta::StreamWriter_Alignment;
+		bufferCount = std::max<uDM>(_bufferCount, 2);
+
+		memory = RCast<u8>(::operator new(bufferSize * bufferCount, std::align_val_t(Meta::StreamWriter_Alignment)));
+
+		path = _path;
+
+		filled.assign(bufferCount, 0);
+
+		head         = 0;
+		headFill     = 0;
+		tail         = 0;
+		queued       = 0;
+		bytesWritten = 0;
+		stalls       = 0;
+		exit         = false;
+		failed       = false;
+
+		flusher = Thread(&StreamWriter::FlushLoop, this);
+
+		return true;
+	}
+
+	void StreamWriter::Close()
+	{
+		if (!IsOpen()) return;
+
+		if (headFill > 0) Submit();
+
+		{
+			ScopedLock ringGuard(ringLock);
+
+			exit = true;
+		}
+
+		ringSignal.notify_all();
+
+		flusher.join();
+
+		OSAL::CloseOutputFile(file);
+
+		::operator delete(memory, std::align_val_t(Meta::StreamWriter_Alignment));
+
+		memory = nullptr;
+
+		filled.clear();
+	}
+
+	void StreamWriter::Write(ptr<const void> _data, uDM _size)
+	{
+		if (!IsOpen()) throw RuntimeError("StreamWriter: Write to a closed stream.");
+
+		ThrowIfFailed();
+
+		ptr<const u8> source = RCast<const u8>(_data);
+
+		while (_size > 0)
+		{
+			uDM chunk = std::min(bufferSize - headFill, _size);
+
+			memcpy(memory + head * bufferSize + headFill, source, chunk);
+
+			headFill += chunk;
+			source   += chunk;
+			_size    -= chunk;
+
+			if (headFill == bufferSize) Submit();
+		}
+	}
+
+	bool StreamWriter::TryWrite(ptr<const void> _data, uDM _size)
+	{
+		if (!IsOpen() || failed) return false;
+
+		// Fits in the current buffer without submitting it, cannot block.
+		if (_size < bufferSize - headFill)
+		{
+			Write(_data, _size);
+
+			return true;
+		}
+
+		{
+			ScopedLock ringGuard(ringLock);
+
+			// Filling the last free buffer would submit it into a full ring and wait.
+			uDM available = (bufferSize - headFill) + (bufferCount - queued - 1) * bufferSize;
+
+			if (_size >= available) return false;
+		}
+
+		Write(_data, _size);
+
+		return true;
+	}
+
+	void StreamWriter::Flush()
+	{
+		if (!IsOpen()) return;
+
+		if (headFill > 0) Submit();
+
+		{
+			UniqueLock ringGuard(ringLock);
+
+			ringSignal.wait(ringGuard, [this]() { return queued == 0; });
+		}
+
+		ThrowIfFailed();
+	}
+
+	bool StreamWriter::IsBackedUp() const
+	{
+		ScopedLock ringGuard(ringLock);
+
+		return queued * 2 > bufferCount;
+	}
+
+	uDM StreamWriter::GetBytesWritten() const
+	{
+		ScopedLock ringGuard(ringLock);
+
+		return bytesWritten;
+	}
+
+	uDM StreamWriter::GetStalls() const
+	{
+		ScopedLock ringGuard(ringLock);
+
+		return stalls;
+	}
+
+
+
+	// Protected
+
+	void StreamWriter::Submit()
+	{
+		UniqueLock ringGuard(ringLock);
+
+		filled[head] = headFill;
+
+		queued++;
+
+		head     = (head + 1) % bufferCount;
+		headFill = 0;
+
+		ringSignal.notify_all();
+
+		// The next buffer is the oldest one still waiting on the disk.
+		if (queued == bufferCount)
+		{
+			stalls++;
+
+			ringSignal.wait(ringGuard, [this]() { return queued < bufferCount; });
+		}
+	}
+
+	void StreamWriter::FlushLoop()
+	{
+		DynamicArray<OSAL::WriteSpan> spans;
+
+		spans.reserve(bufferCount);
+
+		UniqueLock ringGuard(ringLock);
+
+		while (true)
+		{
+			ringSignal.wait(ringGuard, [this]() { return exit || queued > 0; });
+
+			if (queued == 0) return;
+
+			// Everything waiting goes out in one gathered write.
+			uDM  count   = queued;
+			uDM  first   = tail;
+			bool discard = failed;
+
+			ringGuard.unlock();
+
+			spans.clear();
+
+			uDM bytes = 0;
+
+			for (uDM index = 0; index < count; index++)
+			{
+				uDM buffer = (first + index) % bufferCount;
+
+				spans.push_back({ memory + buffer * bufferSize, filled[buffer] });
+
+				bytes += filled[buffer];
+			}
+
+			// Once a write failed the file is incomplete, the rest is dropped so producers never block on it.
+			bool written = !discard && OSAL::WriteGather(file, spans.data(), spans.size());
+
+			ringGuard.lock();
+
+			if (written) bytesWritten += bytes;
+			else         failed        = true;
+
+			tail    = (tail + count) % bufferCount;
+			queued -= count;
+
+			ringSignal.notify_all();
+		}
+	}
+
+	void StreamWriter::ThrowIfFailed() const
+	{
+		if (failed) throw RuntimeError("StreamWriter: Failed writing: " + path.generic_string());
+	}
+}
@@ -0,0 +1,125 @@
+/*
+	Stream Writer
+
+	High bandwidth sequential file output (frame captures, profiler traces, state dumps).
+
+	Writes are copied into a ring of pre-allocated, page aligned buffers. A full buffer is handed to the
+	writer's flush thread, which gathers every buffer waiting in the ring into a single write. The producer
+	only ever pays for the copy, unless the disk falls behind by the whole ring: Write then blocks until a buffer
+	frees up (back pressure), TryWrite refuses instead so that the caller can drop or defer.
+
+	The ring has a single producer: Write, TryWrite, Flush, Open and Close must all come from one thread at a time.
+	Only the statistics getters and IsBackedUp are safe to call from elsewhere.
+*/
+
+
+
+#pragma once
+
+
+
+// Engine
+#include "LAL/LAL.hpp"
+#include "OSAL/OSAL_FileWrite.hpp"
+
+
+
+namespace Core::IO
+{
+	using namespace LAL;
+
+
+
+	class StreamWriter
+	{
+	public:
+
+		StreamWriter() {}
+
+		StreamWriter(const StreamWriter&) = delete;
+
+		StreamWriter& operator=(const StreamWriter&) = delete;
+
+		~StreamWriter();
+
+		/*
+		Creates (or truncates) the file at _path. 0 uses Meta::StreamWriter_BufferSize / StreamWriter_BufferCount.
+		*/
+		bool Open(const Path& _path, uDM _bufferSize = 0, uDM _bufferCount = 0);
+
+		/*
+		Flushes everything written and closes the file.
+		*/
+		void Close();
+
+		bool IsOpen() const { return flusher.joinable(); }
+
+		/*
+		Blocks while the whole ring is waiting on the disk. Throws if a previous write to the file failed.
+		*/
+		void Write(ptr<const void> _data, uDM _size);
+
+		/*
+		Writes nothing and returns false if it would have to wait on the disk.
+		*/
+		bool TryWrite(ptr<const void> _data, uDM _size);
+
+		/*
+		Hands the partially filled buffer to the flush thread and waits until everything written is on the file.
+		*/
+		void Flush();
+
+		/*
+		More than half the ring is waiting on the disk, producers that can should slow down.
+		*/
+		bool IsBackedUp() const;
+
+		const Path& GetPath() const { return path; }
+
+		uDM GetBytesWritten() const;
+
+		/*
+		Times a Write had to wait for a free buffer.
+		*/
+		uDM GetStalls() const;
+
+	protected:
+
+		void Submit();
+
+		void FlushLoop();
+
+		void ThrowIfFailed() const;
+
+		Path path;
+
+		OSAL::OutputFile file;
+
+		ptr<u8> memory = nullptr;
+
+		uDM bufferSize  = 0;
+		uDM bufferCount = 0;
+
+		// Bytes written into each buffer of the ring.
+		DynamicArray<uDM> filled;
+
+		// Producer side: the buffer being filled and how far.
+		uDM head     = 0;
+		uDM headFill = 0;
+
+		mutable Mutex     ringLock  ;
+		ConditionVariable ringSignal;   // Buffers submitted, or buffers freed.
+
+		uDM tail   = 0;   // Oldest buffer waiting on the disk.
+		uDM queued = 0;   // Buffers waiting on the disk (including the one being written).
+
+		uDM bytesWritten = 0;
+		uDM stalls       = 0;
+
+		bool exit = false;
+
+		Atomic<bool> failed = false;   // Read on every write, without the lock.
+
+		Thread flusher;
+	};
+}
@@ -0,0 +1,417 @@
+// Parent Header
+#include "Streaming.hpp"
+
+
+
+// Engine
+#include "AsyncIO.hpp"
+#include "VFS.hpp"
+#include "Dev/Console.hpp"
+#include "Meta/Config/CoreDev_Config.hpp"
+#include "ImGui_SAL.hpp"
+
+
+
+namespace Core::IO
+{
+	// Private
+
+	struct StreamEntry
+	{
+		StreamAsset  Asset;
+		EStreamState State = EStreamState::Unloaded;
+		uDM          Size  = 0;
+
+		StreamHint Hint;
+		u64        HintCycle = 0;   // Last cycle hinted, 0 if never.
+		u64        LastUsed  = 0;
+
+		bool Prefetch = false;
+		bool Required = false;
+
+		IORequestID Read = 0;
+	};
+
+	StaticData()
+
+		// Only touched on the master cycler: reads complete there too.
+		UnorderedMap<StreamAssetID, StreamEntry> Assets;
+
+		StreamAssetID NextAssetID = 1;
+
+		u64 Cycle = 1;
+
+		uDM Budget        = Meta::Streaming_Budget;
+		uDM ResidentBytes = 0;
+		uDM LoadingBytes  = 0;
+		uDM Loading       = 0;
+
+		uDM Loads     = 0;
+		uDM Evictions = 0;
+		uDM Failures  = 0;
+
+
+
+	// Forwards
+
+	f32 Score(const StreamEntry& _entry);
+
+	void Issue(StreamAssetID _id, StreamEntry& _entry);
+
+	void OnRead(StreamAssetID _id, ReadResult& _result);
+
+	void Complete(StreamAssetID _id, StreamEntry& _entry, DynamicArray<u8>&& _data);
+
+	void Evict(StreamAssetID _id, StreamEntry& _entry);
+
+
+
+	// Public
+
+	StreamAssetID Streaming_Register(StreamAsset&& _asset)
+	{
+		StreamEntry entry;
+
+		entry.Size = _asset.ResidentSize;
+
+		if (entry.Size == 0)
+		{
+			VFS_Location location;
+
+			if (VFS_Resolve(_asset.Path, location))
+			{
+				entry.Size = location.Size;
+			}
+			else
+			{
+				std::error_code error;
+
+				uintmax_t size = std::filesystem::file_size(Path(_asset.Path), error);
+
+				entry.Size = error ? 0 : uDM(size);
+			}
+		}
+
+		entry.Asset = move(_asset);
+
+		StreamAssetID id = NextAssetID++;
+
+		Assets.emplace(id, move(entry));
+
+		return id;
+	}
+
+	void Streaming_Unregister(StreamAssetID _asset)
+	{
+		auto found = Assets.find(_asset);
+
+		if (found == Assets.end()) return;
+
+		// Taken out first, the eviction callback may unregister it again.
+		StreamEntry entry = move(found->second);
+
+		Assets.erase(found);
+
+		if (entry.State == EStreamState::Resident) Evict(_asset, entry);
+
+		if (entry.State == EStreamState::Loading)
+		{
+			// Its completion no longer finds the asset and is dropped.
+			AsyncIO_Cancel(entry.Read);
+
+			LoadingBytes -= entry.Size;
+			Loading--;
+		}
+	}
+
+	void Streaming_Hint(StreamAssetID _asset, const StreamHint& _hint)
+	{
+		auto found = Assets.find(_asset);
+
+		if (found == Assets.end()) return;
+
+		found->second.Hint      = _hint;
+		found->second.HintCycle = Cycle;
+		found->second.LastUsed  = Cycle;
+	}
+
+	void Streaming_Prefetch(StreamAssetID _asset)
+	{
+		auto found = Assets.find(_asset);
+
+		if (found != Assets.end() && found->second.State != EStreamState::Resident) found->second.Prefetch = true;
+	}
+
+	void Streaming_Require(StreamAssetID _asset)
+	{
+		auto found = Assets.find(_asset);
+
+		if (found == Assets.end()) return;
+
+		StreamEntry& entry = found->second;
+
+		entry.LastUsed = Cycle;
+
+		if (entry.State == EStreamState::Resident) return;
+
+		// An explicit requirement retries a failed load.
+		if (entry.State == EStreamState::Failed) entry.State = EStreamState::Unloaded;
+
+		entry.Required = true;
+	}
+
+	void Streaming_Touch(StreamAssetID _asset)
+	{
+		auto found = Assets.find(_asset);
+
+		if (found != Assets.end()) found->second.LastUsed = Cycle;
+	}
+
+	EStreamState Streaming_GetState(StreamAssetID _asset)
+	{
+		auto found = Assets.find(_asset);
+
+		return found != Assets.end() ? found->second.State : EStreamState::Unloaded;
+	}
+
+	void Streaming_SetBudget(uDM _bytes)
+	{
+		Budget = _bytes;
+	}
+
+	void Streaming_Update()
+	{
+		using Ranked = std::pair<f32, StreamAssetID>;
+		using Used   = std::pair<u64, StreamAssetID>;
+
+		DynamicArray<Ranked> candidates;
+		DynamicArray<Used>   residents ;
+
+		for (auto& asset : Assets)
+		{
+			StreamEntry& entry = asset.second;
+
+			if (entry.State == EStreamState::Resident)
+			{
+				// Used this cycle, not up for eviction.
+				if (entry.LastUsed < Cycle) residents.emplace_back(entry.LastUsed, asset.first);
+
+				continue;
+			}
+
+			if (entry.State != EStreamState::Unloaded) continue;
+
+			f32 score = Score(entry);
+
+			if (score > 0.0f) candidates.emplace_back(score, asset.first);
+		}
+
+		// Most important first, eviction in least recently used order.
+		std::sort(candidates.begin(), candidates.end(), [](const Ranked& _a, const Ranked& _b) { return _a.first > _b.first; });
+		std::sort(residents .begin(), residents .end(), [](const Used&   _a, const Used&   _b) { return _a.first < _b.first; });
+
+		uDM victim = 0;
+
+		// Frees room for an asset of _score, only evicting assets that matter less.
+		auto makeRoom = [&](uDM _size, f32 _score)
+		{
+			for (uDM scan = victim; ResidentBytes + LoadingBytes + _size > Budget && scan < residents.size(); scan++)
+			{
+				auto found = Assets.find(residents[scan].second);
+
+				if (found == Assets.end() || found->second.State != EStreamState::Resident) continue;
+
+				if (Score(found->second) >= _score) continue;
+
+				Evict(found->first, found->second);
+
+				// Everything before it was either evicted or matters more than any later (lower scored) candidate.
+				victim = scan + 1;
+			}
+
+			return ResidentBytes + LoadingBytes + _size <= Budget;
+		};
+
+		// A lowered budget is enforced even with nothing to load.
+		makeRoom(0, std::numeric_limits<f32>::max());
+
+		for (auto& candidate : candidates)
+		{
+			if (Loading >= Meta::Streaming_MaxInFlight) break;
+
+			auto found = Assets.find(candidate.second);
+
+			if (found == Assets.end()) continue;
+
+			bool room = makeRoom(found->second.Size, candidate.first);
+
+			// The callbacks of an eviction or of an immediate load may have unregistered it.
+			found = Assets.find(candidate.second);
+
+			if (found == Assets.end() || found->second.State != EStreamState::Unloaded) continue;
+
+			if (!room && !found->second.Required) continue;
+
+			Issue(candidate.second, found->second);
+		}
+
+		Cycle++;
+	}
+
+	void Unload_Streaming()
+	{
+		// Taken out first, the eviction callbacks may unregister.
+		UnorderedMap<StreamAssetID, StreamEntry> assets;
+
+		assets.swap(Assets);
+
+		for (auto& asset : assets)
+		{
+			StreamEntry& entry = asset.second;
+
+			if (entry.State == EStreamState::Resident) Evict(asset.first, entry);
+
+			if (entry.State == EStreamState::Loading) AsyncIO_Cancel(entry.Read);
+		}
+
+		LoadingBytes = 0;
+		Loading      = 0;
+	}
+
+	void Streaming_Record_EditorDevDebugUI()
+	{
+		using namespace SAL::Imgui;
+
+		uDM resident = 0;
+
+		for (auto& asset : Assets)
+		{
+			if (asset.second.State == EStreamState::Resident) resident++;
+		}
+
+		if (Table2C::Record())
+		{
+			Table2C::Entry("Streamed Assets"    , ToString(Assets.size()));
+			Table2C::Entry("Streaming Resident" , ToString(resident) + " (" + ToString(ResidentBytes / 1024) + " / " + ToString(Budget / 1024) + " KB)");
+			Table2C::Entry("Streaming Loading"  , ToString(Loading) + " (" + ToString(LoadingBytes / 1024) + " KB)");
+			Table2C::Entry("Streaming Loads"    , ToString(Loads));
+			Table2C::Entry("Streaming Evictions", ToString(Evictions));
+			Table2C::Entry("Streaming Failures" , ToString(Failures));
+
+			Table2C::EndRecord();
+		}
+	}
+
+
+
+	// Private
+
+	f32 Score(const StreamEntry& _entry)
+	{
+		if (_entry.Required) return std::numeric_limits<f32>::max();
+
+		f32 score = 0.0f;
+
+		if (_entry.HintCycle != 0 && Cycle - _entry.HintCycle < Meta::Streaming_HintCycles)
+		{
+			score = _entry.Hint.ScreenSize + Meta::Streaming_ProximityWeight / (1.0f + std::max(_entry.Hint.Distance, 0.0f));
+		}
+
+		if (_entry.Prefetch) score = std::max(score, Meta::Streaming_PrefetchScore);
+
+		return score;
+	}
+
+	void Issue(StreamAssetID _id, StreamEntry& _entry)
+	{
+		VFS_Location location;
+
+		bool mounted = VFS_Resolve(_entry.Asset.Path, location);
+
+		ReadRequest request;
+
+		request.File     = mounted && location.Type == EMountType::Directory ? location.File : Path(_entry.Asset.Path);
+		request.Priority = _entry.Required ? EIOPriority::Critical : _entry.HintCycle != 0 ? EIOPriority::High : EIOPriority::Low;
+
+		// Packed content still pages in from disk and decompresses, it is read on the workers too.
+		// The location keeps its pack alive, the read is safe against an unmount in the meantime.
+		if (mounted && location.Type != EMountType::Directory)
+		{
+			request.Source = [location](ReadResult& _result) { _result.Data = VFS_Read(location); };
+		}
+
+		request.OnComplete = [_id](ReadResult& _result) { OnRead(_id, _result); };
+
+		_entry.State = EStreamState::Loading;
+
+		LoadingBytes += _entry.Size;
+		Loading++;
+
+		_entry.Read = AsyncIO_Read(move(request));
+	}
+
+	void OnRead(StreamAssetID _id, ReadResult& _result)
+	{
+		auto found = Assets.find(_id);
+
+		// Unregistered (or unloaded) while it was read.
+		if (found == Assets.end() || found->second.Read != _result.ID) return;
+
+		StreamEntry& entry = found->second;
+
+		entry.Read = 0;
+
+		LoadingBytes -= entry.Size;
+		Loading--;
+
+		if (_result.Status == EIOStatus::Cancelled)
+		{
+			entry.State = EStreamState::Unloaded;
+
+			return;
+		}
+
+		if (_result.Status == EIOStatus::Failed)
+		{
+			Dev::CLog_Error("Streaming: " + _result.Error);
+
+			entry.State = EStreamState::Failed;
+
+			Failures++;
+
+			return;
+		}
+
+		Complete(_id, entry, move(_result.Data));
+	}
+
+	void Complete(StreamAssetID _id, StreamEntry& _entry, DynamicArray<u8>&& _data)
+	{
+		_entry.State    = EStreamState::Resident;
+		_entry.LastUsed = std::max(_entry.LastUsed, Cycle);
+		_entry.Prefetch = false;
+		_entry.Required = false;
+
+		ResidentBytes += _entry.Size;
+
+		Loads++;
+
+		// Called on a copy, a callback that unregisters its asset destroys the entry holding it.
+		auto onLoaded = _entry.Asset.OnLoaded;
+
+		if (onLoaded) onLoaded(_id, move(_data));
+	}
+
+	void Evict(StreamAssetID _id, StreamEntry& _entry)
+	{
+		_entry.State = EStreamState::Unloaded;
+
+		ResidentBytes -= _entry.Size;
+
+		Evictions++;
+
+		auto onEvicted = _entry.Asset.OnEvicted;
+
+		if (onEvicted) onEvicted(_id);
+	}
+}
@@ -0,0 +1,113 @@
+/*
+	Streaming
+
+	Keeps a budgeted resident set of assets, loaded in the background through the async IO service.
+
+	Assets are registered once with their virtual path and what they cost once resident. Every cycle the users of an
+	asset hint how much it matters (distance to the camera, screen coverage), or flag it as predicted to be needed soon.
+	Streaming_Update (pumped by the master cycler) ranks the assets that are not resident, issues their reads most
+	important first and, when the budget is exceeded, evicts the least recently used assets that matter less than
+	the one being loaded. Assets hinted or touched in the current cycle are never evicted.
+
+	The streamer does not keep the data: it is handed to OnLoaded (on the master cycler) and the owner uploads or
+	parses it, OnEvicted tells the owner to release it.
+*/
+
+
+
+#pragma once
+
+
+
+// Engine
+#include "LAL/LAL.hpp"
+
+
+
+namespace Core::IO
+{
+	using namespace LAL;
+
+
+
+	// Enums
+
+	enum class EStreamState : u8
+	{
+		Unloaded,
+		Loading ,
+		Resident,
+		Failed
+	};
+
+
+
+	// Structs
+
+	using StreamAssetID = u32;
+
+	constexpr StreamAssetID InvalidStreamAsset = 0;
+
+	struct StreamAsset
+	{
+		String Path;   // Virtual (VFS) path, or a plain file path if no mount provides it.
+
+		uDM ResidentSize = 0;   // What the asset costs once loaded (e.g. its VRAM footprint), 0 uses the file size.
+
+		Function<void(StreamAssetID, DynamicArray<u8>&&)> OnLoaded ;
+		Function<void(StreamAssetID)>                     OnEvicted;
+	};
+
+	struct StreamHint
+	{
+		f32 Distance   = 0.0f;   // To the camera, in world units.
+		f32 ScreenSize = 0.0f;   // Projected size over the screen height (0 - 1).
+	};
+
+
+
+	// Functions
+
+	StreamAssetID Streaming_Register(StreamAsset&& _asset);
+
+	/*
+	Evicts the asset if it is resident. A read still in flight is dropped when it completes.
+	*/
+	void Streaming_Unregister(StreamAssetID _asset);
+
+	/*
+	How much the asset matters this cycle. Hints expire after Meta::Streaming_HintCycles without being renewed.
+	*/
+	void Streaming_Hint(StreamAssetID _asset, const StreamHint& _hint);
+
+	/*
+	The asset is predicted to be needed soon, loaded at low priority when there is room in the budget.
+	*/
+	void Streaming_Prefetch(StreamAssetID _asset);
+
+	/*
+	The asset is needed now: loaded ahead of everything else, evicting whatever it takes.
+	*/
+	void Streaming_Require(StreamAssetID _asset);
+
+	/*
+	Marks a resident asset as used this cycle.
+	*/
+	void Streaming_Touch(StreamAssetID _asset);
+
+	EStreamState Streaming_GetState(StreamAssetID _asset);
+
+	void Streaming_SetBudget(uDM _bytes);
+
+	/*
+	Ranks the hinted assets, evicts and issues reads. Called once per cycle.
+	*/
+	void Streaming_Update();
+
+	/*
+	Evicts everything and forgets every asset.
+	*/
+	void Unload_Streaming();
+
+	void Streaming_Record_EditorDevDebugUI();
+}
@@ -0,0 +1,479 @@
+// Parent Header
+#include "VFS.hpp"
+
+
+
+// Engine
+#include "ImGui_SAL.hpp"
+
+
+
+namespace Core::IO
+{
+	// Private
+
+	struct Mount;
+
+	struct MountFile
+	{
+		String Name;   // Full normalized virtual path.
+		u64    Hash;
+		uDM    Size;
+
+		ptr<const Mount> Owner;   // Owned through a pointer, the mount keeps its address.
+
+		Path                         File;
+		ptr <const PackEntry>        Entry  = nullptr;
+		SPtr<const DynamicArray<u8>> Memory;
+	};
+
+	struct Mount
+	{
+		MountID    ID;
+		EMountType Type;
+		String     Point;      // Normalized, with a trailing slash unless it is the root.
+		s32        Priority;
+		Path       Source;
+
+		// Shared with the locations resolved into the mount, which may outlive it.
+		SPtr<PackArchive> Pack;
+
+		UnorderedMap<String, SPtr<const DynamicArray<u8>>> MemoryFiles;
+
+		DynamicArray<MountFile> Files;
+	};
+
+	StaticData()
+
+		Mutex VFSLock;
+
+		// Ordered by (priority, mount order), so merging them in order lets the winner overwrite.
+		DynamicArray< UPtr<Mount> > Mounts;
+
+		MountID NextMountID = 1;
+
+		// The merged view: path hash -> winning file.
+		UnorderedMap<u64, ptr<const MountFile>> Resolved;
+
+		// Paths whose hash collides with another path, looked up by name. Practically always empty.
+		UnorderedMap<String, ptr<const MountFile>> Collided;
+
+		// Directory hash -> files directly inside it.
+		UnorderedMap<u64, DynamicArray< ptr<const MountFile> >> Directories;
+
+
+
+	// Forwards
+
+	void Scan(Mount& _mount);
+
+	void Rebuild();
+
+	ptr<const MountFile> Find(StringView _path);
+
+	bool SamePath(StringView _name, StringView _path);
+
+	MountID AddMount(UPtr<Mount>&& _mount);
+
+	String NormalizeMountPoint(StringView _mountPoint);
+
+	StringView ParentOf(StringView _path);
+
+
+
+	// Public
+
+	MountID VFS_MountDirectory(StringView _mountPoint, const Path& _directory, s32 _priority)
+	{
+		UPtr<Mount> mount = MakeUPtr<Mount>();
+
+		mount->Type     = EMountType::Directory;
+		mount->Point    = NormalizeMountPoint(_mountPoint);
+		mount->Priority = _priority;
+		mount->Source   = _directory;
+
+		Scan(*mount);
+
+		return AddMount(move(mount));
+	}
+
+	MountID VFS_MountPack(StringView _mountPoint, const Path& _pack, s32 _priority)
+	{
+		UPtr<Mount> mount = MakeUPtr<Mount>();
+
+		mount->Type     = EMountType::Pack;
+		mount->Point    = NormalizeMountPoint(_mountPoint);
+		mount->Priority = _priority;
+		mount->Source   = _pack;
+		mount->Pack     = MakeSPtr<PackArchive>();
+
+		if (!mount->Pack->Open(_pack)) return InvalidMount;
+
+		Scan(*mount);
+
+		return AddMount(move(mount));
+	}
+
+	MountID VFS_MountMemory(StringView _mountPoint, s32 _priority)
+	{
+		UPtr<Mount> mount = MakeUPtr<Mount>();
+
+		mount->Type     = EMountType::Memory;
+		mount->Point    = NormalizeMountPoint(_mountPoint);
+		mount->Priority = _priority;
+
+		return AddMount(move(mount));
+	}
+
+	void VFS_AddMemoryFile(MountID _mount, StringView _path, DynamicArray<u8>&& _data)
+	{
+		ScopedLock vfsGuard(VFSLock);
+
+		for (auto& mount : Mounts)
+		{
+			if (mount->ID != _mount || mount->Type != EMountType::Memory) continue;
+
+			// A file it replaces lives on in the locations still holding it.
+			mount->MemoryFiles[PackNormalizePath(_path)] = MakeSPtr<const DynamicArray<u8>>(move(_data));
+
+			Scan(*mount);
+
+			Rebuild();
+
+			return;
+		}
+
+		throw RuntimeError("VFS_AddMemoryFile: Not a memory mount.");
+	}
+
+	void VFS_Unmount(MountID _mount)
+	{
+		ScopedLock vfsGuard(VFSLock);
+
+		auto found = std::find_if(Mounts.begin(), Mounts.end(), [_mount](const UPtr<Mount>& _entry) { return _entry->ID == _mount; });
+
+		if (found == Mounts.end()) return;
+
+		Mounts.erase(found);
+
+		Rebuild();
+	}
+
+	void VFS_Rescan(MountID _mount)
+	{
+		ScopedLock vfsGuard(VFSLock);
+
+		for (auto& mount : Mounts)
+		{
+			if (mount->ID != _mount) continue;
+
+			Scan(*mount);
+
+			Rebuild();
+
+			return;
+		}
+	}
+
+	bool VFS_Exists(StringView _path)
+	{
+		ScopedLock vfsGuard(VFSLock);
+
+		return Find(_path) != nullptr;
+	}
+
+	bool VFS_Resolve(StringView _path, VFS_Location& _location)
+	{
+		ScopedLock vfsGuard(VFSLock);
+
+		ptr<const MountFile> file = Find(_path);
+
+		if (file == nullptr) return false;
+
+		const Mount& mount = *file->Owner;
+
+		_location.Type   = mount.Type;
+		_location.Mount  = mount.ID;
+		_location.Size   = file->Size;
+		_location.File   = file->File;
+		_location.Pack   = mount.Pack;
+		_location.Entry  = file->Entry;
+		_location.Memory = file->Memory;
+
+		return true;
+	}
+
+	DynamicArray<u8> VFS_Read(StringView _path)
+	{
+		VFS_Location location;
+
+		if (!VFS_Resolve(_path, location)) throw RuntimeError("VFS_Read: No file at: " + String(_path));
+
+		return VFS_Read(location);
+	}
+
+	DynamicArray<u8> VFS_Read(const VFS_Location& _location)
+	{
+		switch (_location.Type)
+		{
+			case EMountType::Directory:
+			{
+				File_InputStream file(_location.File, std::ios::binary);
+
+				DynamicArray<u8> data(_location.Size);
+
+				if (!file.read(RCast<char>(data.data()), std::streamsize(data.size())))
+				{
+					throw RuntimeError("VFS_Read: Failed reading: " + _location.File.generic_string());
+				}
+
+				return data;
+			}
+			case EMountType::Pack:
+			{
+				return _location.Pack->Read(*_location.Entry);
+			}
+			default:
+			{
+				return *_location.Memory;
+			}
+		}
+	}
+
+	bool VFS_ToVirtualPath(const Path& _file, String& _virtualPath)
+	{
+		ScopedLock vfsGuard(VFSLock);
+
+		Path file = _file.lexically_normal();
+
+		// Highest priority last.
+		for (auto mount = Mounts.rbegin(); mount != Mounts.rend(); mount++)
+		{
+			if ((*mount)->Type != EMountType::Directory) continue;
+
+			Path relative = file.lexically_relative((*mount)->Source.lexically_normal());
+
+			// Outside of it, or the mounted directory itself.
+			if (relative.empty() || relative == "." || *relative.begin() == "..") continue;
+
+			_virtualPath = (*mount)->Point + PackNormalizePath(relative.generic_string());
+
+			return true;
+		}
+
+		return false;
+	}
+
+	DynamicArray<String> VFS_List(StringView _directory)
+	{
+		ScopedLock vfsGuard(VFSLock);
+
+		DynamicArray<String> result;
+
+		String directory = PackNormalizePath(_directory);
+
+		while (!directory.empty() && directory.back() == '/') directory.pop_back();
+
+		auto found = Directories.find(PackPathHash(directory));
+
+		if (found == Directories.end()) return result;
+
+		for (auto file : found->second)
+		{
+			if (ParentOf(file->Name) == directory) result.push_back(file->Name);
+		}
+
+		return result;
+	}
+
+	void VFS_Record_EditorDevDebugUI()
+	{
+		using namespace SAL::Imgui;
+
+		ScopedLock vfsGuard(VFSLock);
+
+		if (Table2C::Record())
+		{
+			Table2C::Entry("VFS Files", ToString(Resolved.size() + Collided.size()));
+
+			for (auto& mount : Mounts)
+			{
+				Table2C::Entry
+				(
+					(mount->Point.empty() ? String("/") : mount->Point) + " (" + ToString(mount->Priority) + ")",
+					mount->Source.generic_string() + ": " + ToString(mount->Files.size()) + " files"
+				);
+			}
+
+			Table2C::EndRecord();
+		}
+	}
+
+
+
+	// Private
+
+	void Scan(Mount& _mount)
+	{
+		_mount.Files.clear();
+
+		switch (_mount.Type)
+		{
+			case EMountType::Directory:
+			{
+				using namespace std::filesystem;
+
+				std::error_code error, entryError;
+
+				for (recursive_directory_iterator entry(_mount.Source, error), end; !error && entry != end; entry.increment(error))
+				{
+					if (!entry->is_regular_file(entryError)) continue;
+
+					MountFile file;
+
+					file.Name = _mount.Point + PackNormalizePath(entry->path().lexically_relative(_mount.Source).generic_string());
+					file.Size = uDM(entry->file_size(entryError));
+					file.File = entry->path();
+
+					_mount.Files.push_back(move(file));
+				}
+
+			} break;
+
+			case EMountType::Pack:
+			{
+				ptr<const PackEntry> entries = _mount.Pack->GetEntries();
+
+				for (uDM index = 0; index < _mount.Pack->GetEntryCount(); index++)
+				{
+					MountFile file;
+
+					file.Name  = _mount.Point + String(_mount.Pack->GetName(entries[index]));
+					file.Size  = uDM(entries[index].Size);
+					file.Entry = entries + index;
+
+					_mount.Files.push_back(move(file));
+				}
+
+			} break;
+
+			case EMountType::Memory:
+			{
+				for (auto& memoryFile : _mount.MemoryFiles)
+				{
+					MountFile file;
+
+					file.Name   = _mount.Point + memoryFile.first;
+					file.Size   = memoryFile.second->size();
+					file.Memory = memoryFile.second;
+
+					_mount.Files.push_back(move(file));
+				}
+
+			} break;
+		}
+
+		for (auto& file : _mount.Files)
+		{
+			file.Hash  = PackPathHash(file.Name);
+			file.Owner = getPtr(_mount);
+		}
+	}
+
+	void Rebuild()
+	{
+		Resolved   .clear();
+		Collided   .clear();
+		Directories.clear();
+
+		UnorderedMap<String, ptr<const MountFile>> byName;
+
+		// Lowest priority first, so the winners overwrite.
+		for (auto& mount : Mounts)
+		{
+			for (auto& file : mount->Files) byName[file.Name] = getPtr(file);
+		}
+
+		for (auto& entry : byName)
+		{
+			ptr<const MountFile> file = entry.second;
+
+			auto inserted = Resolved.emplace(file->Hash, file);
+
+			if (!inserted.second) Collided.emplace(file->Name, file);
+
+			Directories[PackPathHash(ParentOf(file->Name))].push_back(file);
+		}
+	}
+
+	ptr<const MountFile> Find(StringView _path)
+	{
+		auto found = Resolved.find(PackPathHash(_path));
+
+		if (found != Resolved.end() && SamePath(found->second->Name, _path)) return found->second;
+
+		if (Collided.empty()) return nullptr;
+
+		auto collided = Collided.find(PackNormalizePath(_path));
+
+		return collided != Collided.end() ? collided->second : nullptr;
+	}
+
+	bool SamePath(StringView _name, StringView _path)
+	{
+		// Compares against the normalized name without building the normalized path.
+		while (_path.size() >= 2 && _path[0] == '.' && (_path[1] == '/' || _path[1] == '\\')) _path.remove_prefix(2);
+
+		if (_name.size() != _path.size()) return false;
+
+		for (uDM index = 0; index < _path.size(); index++)
+		{
+			char character = _path[index] == '\\' ? '/' : char(std::tolower(u8(_path[index])));
+
+			if (character != _name[index]) return false;
+		}
+
+		return true;
+	}
+
+	MountID AddMount(UPtr<Mount>&& _mount)
+	{
+		ScopedLock vfsGuard(VFSLock);
+
+		_mount->ID = NextMountID++;
+
+		MountID id = _mount->ID;
+
+		// Stable: a later mount of the same priority lands after the earlier ones.
+		auto position = std::upper_bound
+		(
+			Mounts.begin(), Mounts.end(), _mount->Priority,
+
+			[](s32 _priority, const UPtr<Mount>& _entry) { return _priority < _entry->Priority; }
+		);
+
+		Mounts.insert(position, move(_mount));
+
+		Rebuild();
+
+		return id;
+	}
+
+	String NormalizeMountPoint(StringView _mountPoint)
+	{
+		String point = PackNormalizePath(_mountPoint);
+
+		while (!point.empty() && point.front() == '/') point.erase(0, 1);
+
+		if (!point.empty() && point.back() != '/') point.push_back('/');
+
+		return point;
+	}
+
+	StringView ParentOf(StringView _path)
+	{
+		uDM slash = _path.rfind('/');
+
+		return slash == StringView::npos ? StringView() : _path.substr(0, slash);
+	}
+}
@@ -0,0 +1,119 @@
+/*
+	Virtual File System
+
+	Overlays loose directories, pack archives and in memory files under virtual paths.
+
+	Every mount is scanned once when it is mounted, the files of all the mounts are then merged into a single
+	table keyed by path hash. Existence checks, stats and lookups are a hash table hit that never reaches the OS.
+	Where two mounts provide the same path the higher priority wins, on a tie the latest mount wins.
+
+	Virtual paths use the pack normalization: forward slashes, no leading "./", case insensitive.
+*/
+
+
+
+#pragma once
+
+
+
+// Engine
+#include "LAL/LAL.hpp"
+#include "PackArchive.hpp"
+
+
+
+namespace Core::IO
+{
+	using namespace LAL;
+
+
+
+	// Enums
+
+	enum class EMountType : u8
+	{
+		Directory,
+		Pack     ,
+		Memory
+	};
+
+
+
+	// Structs
+
+	using MountID = u32;
+
+	constexpr MountID InvalidMount = 0;
+
+	/*
+	Where a virtual path resolves to. Only the member matching the mount type is set.
+	The location shares ownership of its pack or memory file: it stays readable after an unmount or a rescan.
+	*/
+	struct VFS_Location
+	{
+		EMountType Type;
+		MountID    Mount;
+		uDM        Size;
+
+		Path                         File;      // Directory
+		SPtr<const PackArchive>      Pack;      // Pack
+		ptr <const PackEntry>        Entry;     // Pack, in the table of contents of Pack.
+		SPtr<const DynamicArray<u8>> Memory;    // Memory
+	};
+
+
+
+	// Functions
+
+	/*
+	Mounts the files under _directory at _mountPoint (a virtual directory, empty for the root).
+	*/
+	MountID VFS_MountDirectory(StringView _mountPoint, const Path& _directory, s32 _priority = 0);
+
+	/*
+	Mounts the entries of a pack at _mountPoint. Returns InvalidMount if the pack cannot be opened.
+	*/
+	MountID VFS_MountPack(StringView _mountPoint, const Path& _pack, s32 _priority = 0);
+
+	MountID VFS_MountMemory(StringView _mountPoint, s32 _priority = 0);
+
+	/*
+	Adds (or replaces) a file of a memory mount, _path is relative to the mount point.
+	*/
+	void VFS_AddMemoryFile(MountID _mount, StringView _path, DynamicArray<u8>&& _data);
+
+	void VFS_Unmount(MountID _mount);
+
+	/*
+	Scans a directory mount again (after its contents changed on disk).
+	*/
+	void VFS_Rescan(MountID _mount);
+
+	bool VFS_Exists(StringView _path);
+
+	bool VFS_Resolve(StringView _path, VFS_Location& _location);
+
+	/*
+	Reads the whole file, throws if the path does not resolve or the read fails.
+	*/
+	DynamicArray<u8> VFS_Read(StringView _path);
+
+	/*
+	Reads the whole file at a resolved location, throws if the read fails.
+	Does not take the VFS lock, the location can be read on any thread.
+	*/
+	DynamicArray<u8> VFS_Read(const VFS_Location& _location);
+
+	/*
+	The virtual path a file on disk is mounted at, through the highest priority directory mount containing it.
+	For matching file watcher changes against virtual paths. Returns false if no directory mount contains it.
+	*/
+	bool VFS_ToVirtualPath(const Path& _file, String& _virtualPath);
+
+	/*
+	The virtual paths of the files directly under _directory.
+	*/
+	DynamicArray<String> VFS_List(StringView _directory);
+
+	void VFS_Record_EditorDevDebugUI();
+}
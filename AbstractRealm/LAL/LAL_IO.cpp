@@ -19,4 +19,20 @@ namespace LAL
 	{
 		return std::filesystem::create_directories(_path);
 	}
+
+	bool Remove(const Path& _path)
+	{
+		std::error_code error;
+
+		return std::filesystem::remove(_path, error);
+	}
+
+	bool Rename(const Path& _from, const Path& _to)
+	{
+		std::error_code error;
+
+		std::filesystem::rename(_from, _to, error);
+
+		return !error;
+	}
 }
\ No newline at end of file
@@ -38,4 +38,8 @@ namespace LAL
 
 	bool Create_Directory  (const Path& _path);
 	bool Create_Directories(const Path& _path);
+
+	bool Remove(const Path& _path);
+
+	bool Rename(const Path& _from, const Path& _to);
 }
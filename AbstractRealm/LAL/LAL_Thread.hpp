@@ -8,5 +8,17 @@
 
 namespace LAL
 {
-	using Thread = std::thread;
+	using Thread   = std::thread;
+	using ThreadID = std::thread::id;
+
+	using Mutex      = std::mutex;
+	using ScopedLock = std::lock_guard<Mutex>;
+	using UniqueLock = std::unique_lock<Mutex>;
+
+	using ConditionVariable = std::condition_variable;
+
+	template<typename Type>
+	using Atomic = std::atomic<Type>;
+
+	inline ThreadID GetThreadID() { return std::this_thread::get_id(); }
 }
@@ -2,12 +2,14 @@
 
 
 
-
+#include "LAL/LAL.hpp"
 
 
 
 namespace Meta
 {
+	using namespace LAL;
+
 	/**
 	 * See: https://twitter.com/TimSweeneyEpic/status/1223077404660371456?s=20.
 	 * 
@@ -33,5 +35,92 @@ namespace Meta
 
 	constexpr ELogToFileMode LogToFile_Mode = ELogToFileMode::GlobalOnly;
 
+	/*
+	Log files are rotated once they reach LogFile_MaxSize bytes or have been open for LogFile_MaxAge.
+	Rotated segments are LZ4 compressed (.lz4) on a background thread if LogFile_Compress is set.
+	*/
+	constexpr uDM     LogFile_MaxSize  = 16 * 1024 * 1024;
+	constexpr Seconds LogFile_MaxAge   = Seconds(60 * 60);
+	constexpr bool    LogFile_Compress = true;
+
+	/*
+	Retention: the rotated segments kept per log file, the oldest is removed once a rotation goes past the limit.
+	On load, log files in the log directory older than LogFile_KeepDays are removed, the plain ones of previous sessions get compressed.
+	*/
+	constexpr uDM LogFile_KeepSegments = 8;
+	constexpr u32 LogFile_KeepDays     = 14;
+
+	/*
+	Mirrors the dev log into a memory mapped ring (DevLog.journal) that survives a hard crash.
+	The journal of the previous session is kept as DevLog.Previous.journal. If that session did not shut down in order
+	its tail is recovered to DevLog.Previous.log at startup.
+	*/
+	constexpr bool LogToJournal = true;
+
+	constexpr uDM LogJournal_Capacity = 4 * 1024 * 1024;
+
 	constexpr bool Dump_EngineStateJson_OnCrash = true;
+
+	// IO
+
+	// Threads servicing Core::IO async reads. Reads are disk bound, a few are enough to keep the queue deep.
+	constexpr u32 AsyncIO_Workers = 2;
+
+	// Plain file reads are submitted to the OS read ring where there is one (io_uring), the workers then only submit them.
+	constexpr bool AsyncIO_UseReadRing = true;
+
+	// Reads in flight on the ring, past it the workers read with blocking calls.
+	constexpr u32 AsyncIO_ReadRingDepth = 64;
+
+	// Persistent threads helping the caller compress and decode block streams, 0 uses one per hardware thread but the caller's.
+	constexpr u32 BlockStream_Workers = 0;
+
+	// Default ring of a Core::IO StreamWriter: 8 x 4 MB lets a producer run ~32 MB ahead of the disk.
+	constexpr uDM StreamWriter_BufferSize  = 4 * 1024 * 1024;
+	constexpr uDM StreamWriter_BufferCount = 8;
+	constexpr uDM StreamWriter_Alignment   = 4096;
+
+	/*
+	Cooked asset data (SPIR-V, vertex data, decoded images) is cached in DDC_Directory, keyed by the hash of its inputs.
+	Entries are LZ4 compressed when DDC_Compress is set. Deleting the directory is always safe.
+	*/
+	constexpr bool   DDC_Enabled   = true;
+	constexpr bool   DDC_Compress  = true;
+	constexpr RoCStr DDC_Directory = "Engine/DerivedData";
+
+	/*
+	Streaming: the resident set budget and how many streamed reads may be in flight at once.
+	An asset's score is its screen size plus Streaming_ProximityWeight / (1 + distance), predicted (prefetched) assets
+	score at least Streaming_PrefetchScore. Hints are forgotten after Streaming_HintCycles cycles without renewal.
+	*/
+	constexpr uDM Streaming_Budget      = 512 * 1024 * 1024;
+	constexpr uDM Streaming_MaxInFlight = 8;
+	constexpr u64 Streaming_HintCycles  = 30;
+
+	constexpr f32 Streaming_ProximityWeight = 16.0f;
+	constexpr f32 Streaming_PrefetchScore   = 0.001f;
+
+	/*
+	Loose content directories mounted into the VFS at load (under the same virtual path).
+	Every pack in VFS_PackDirectory is mounted at the root above them, so packed content overrides loose files.
+	*/
+	constexpr StaticArray<RoCStr, 2> VFS_ContentDirectories = { "Engine/Data", "Engine/Renderer" };
+
+	constexpr RoCStr VFS_PackDirectory = "Engine/Packs";
+
+	/*
+	Build step: cooks the loose content directories into VFS_CookedPack at load, before the packs are mounted.
+	The cooked pack overrides the loose files, edits to them are not picked up while it exists.
+	*/
+	constexpr bool VFS_CookContentOnLoad = false;
+
+	constexpr RoCStr VFS_CookedPack = "Engine/Packs/Content.pak";
+
+	// Watch the loose content directories and rescan their mounts when files change on disk.
+	constexpr bool FileWatcher_WatchContent = true;
+
+	constexpr Milliseconds FileWatcher_PollInterval = Milliseconds(50);
+
+	// How long a path has to stay quiet before its change is published (editors save in several writes).
+	constexpr Milliseconds FileWatcher_Debounce = Milliseconds(150);
 }
@@ -81,6 +81,41 @@ namespace Meta
 
 	constexpr EGPU_Engage GPU_Engagement = EGPU_Engage::Single;   // Currently only supports single.
 
+	// Device memory is sub-allocated from blocks of this size, drivers cap the number of memory objects (often to 4096).
+	constexpr uDM GPU_MemoryBlockSize = 256 * 1024 * 1024;
+
+	// Images this large get a memory object of their own.
+	constexpr uDM GPU_DedicatedImageSize = 32 * 1024 * 1024;
+
+	// Host to device uploads are staged in a persistently mapped ring of this size.
+	constexpr uDM GPU_StagingSize = 64 * 1024 * 1024;
+
+	// Staging batches that can be in flight, one is submitted per frame.
+	constexpr uDM GPU_StagingBatches = 3;
+
+	// Per frame in flight, the uniforms written by every renderable of a render context in a frame.
+	constexpr uDM GPU_UniformArenaSize = 4 * 1024 * 1024;
+
+	// Data rewritten every frame goes to memory both device local and host visible when the device has it
+	// (resizable BAR, integrated and software devices), written directly instead of staged.
+	constexpr bool GPU_UseDeviceHostMemory = true;
+
+	// Textures and storage buffers are bound through global descriptor arrays when the device supports descriptor indexing.
+	constexpr bool GPU_EnableBindless = true;
+
+	constexpr u32 GPU_BindlessTextures = 4096;
+	constexpr u32 GPU_BindlessBuffers  = 1024;
+
+	// Blocks with fewer bytes allocated than this percentage of their size are emptied by the defragmenter.
+	constexpr uDM GPU_DefragOccupancy = 50;
+
+	// Bytes the defragmenter copies per frame, spreads compaction across frames.
+	constexpr uDM GPU_DefragBytesPerFrame = 8 * 1024 * 1024;
+
+	// Geometry pools, the vertex and index buffers meshes of the same vertex stride are sub-allocated from.
+	constexpr uDM GPU_GeometryVertexSize = 64 * 1024 * 1024;
+	constexpr uDM GPU_GeometryIndexSize  = 32 * 1024 * 1024;
+
 
 	// Runtime
 
@@ -0,0 +1,57 @@
+// Parent Header
+#include "GPUVK_Barriers.hpp"
+
+
+
+namespace HAL::GPU::Vulkan
+{
+	void BarrierBatch::Add(const Buffer::Memory_Barrier& _barrier, Pipeline::StageFlags _source, Pipeline::StageFlags _destination)
+	{
+		bufferBarriers.push_back(_barrier);
+
+		sourceStages      |= _source     ;
+		destinationStages |= _destination;
+	}
+
+	void BarrierBatch::Add(const Image::Memory_Barrier& _barrier, Pipeline::StageFlags _source, Pipeline::StageFlags _destination)
+	{
+		imageBarriers.push_back(_barrier);
+
+		sourceStages      |= _source     ;
+		destinationStages |= _destination;
+	}
+
+	void BarrierBatch::Flush(const CommandBuffer& _commandBuffer)
+	{
+		if (IsEmpty()) return;
+
+		if (!bufferBarriers.empty())
+		{
+			_commandBuffer.SubmitPipelineBarrier
+			(
+				sourceStages, destinationStages, 0,
+				SCast<u32>(bufferBarriers.size()), bufferBarriers.data()
+			);
+		}
+
+		if (!imageBarriers.empty())
+		{
+			_commandBuffer.SubmitPipelineBarrier
+			(
+				sourceStages, destinationStages, 0,
+				SCast<u32>(imageBarriers.size()), imageBarriers.data()
+			);
+		}
+
+		bufferBarriers.clear();
+		imageBarriers .clear();
+
+		sourceStages     .Reset();
+		destinationStages.Reset();
+	}
+
+	bool BarrierBatch::IsEmpty() const
+	{
+		return bufferBarriers.empty() && imageBarriers.empty();
+	}
+}
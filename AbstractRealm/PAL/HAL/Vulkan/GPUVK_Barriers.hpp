@@ -0,0 +1,51 @@
+/*
+Barriers
+
+Collects the barriers of a recording so they are submitted together instead of one pipeline barrier each.
+*/
+
+
+
+#pragma once
+
+
+
+#include "GPUVK_Resources.hpp"
+#include "GPUVK_PayloadDeck.hpp"
+
+
+
+namespace HAL::GPU::Vulkan
+{
+	/*
+	Barriers added to a batch are merged into a single pipeline barrier per kind (buffer and image) when flushed.
+	The stages of the merged barrier are the union of the stages each barrier was added with: slightly wider
+	than each needs, but a single dependency the driver can resolve at once.
+
+	Only barriers that may execute together should share a flush, a barrier that depends on commands
+	recorded after another one in the batch needs a flush in between.
+	*/
+	class BarrierBatch
+	{
+	public:
+
+		void Add(const Buffer::Memory_Barrier& _barrier, Pipeline::StageFlags _source, Pipeline::StageFlags _destination);
+
+		void Add(const Image::Memory_Barrier& _barrier, Pipeline::StageFlags _source, Pipeline::StageFlags _destination);
+
+		/*
+		Records the pending barriers into _commandBuffer and clears the batch.
+		*/
+		void Flush(const CommandBuffer& _commandBuffer);
+
+		bool IsEmpty() const;
+
+	protected:
+
+		Pipeline::StageFlags sourceStages     ;
+		Pipeline::StageFlags destinationStages;
+
+		DynamicArray<Buffer::Memory_Barrier> bufferBarriers;
+		DynamicArray<Image ::Memory_Barrier> imageBarriers ;
+	};
+}
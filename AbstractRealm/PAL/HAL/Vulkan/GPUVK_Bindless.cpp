@@ -0,0 +1,316 @@
+// Parent Header
+#include "GPUVK_Bindless.hpp"
+
+
+
+#include "GPUVK_Resources.hpp"
+#include "GPUVK_Rendering.hpp"
+
+
+
+
+namespace HAL::GPU::Vulkan
+{
+	// Private
+
+	struct ReleasedIndex
+	{
+		u32  Index  ;
+		u32  Frame  ;   // Frame it was released during.
+		bool Texture;
+	};
+
+	StaticData()
+
+		bool Enabled = false;
+
+		DescriptorSetLayout         Layout;
+		DescriptorPool              Pool  ;
+		DynamicArray<DescriptorSet> Sets  ;   // One, holds both arrays.
+
+		Pipeline::Layout::PushConstantRange PushRange {};
+
+		DynamicArray<u32> FreeTextures;
+		DynamicArray<u32> FreeBuffers ;
+
+		// Indices never handed out start past these.
+		u32 NextTexture = 0;
+		u32 NextBuffer  = 0;
+
+		DynamicArray<ReleasedIndex> Released;
+
+		u32 Frame = 0;
+
+
+
+	// Forwards
+
+	u32 AcquireIndex(DynamicArray<u32>& _free, u32& _next, u32 _capacity);
+
+	void CreateLayout();
+
+	void CreatePool();
+
+
+
+	// Public
+
+	void Bindless_Maker<Meta::EGPU_Engage::Single>::Prepare()
+	{
+		Enabled = Meta::GPU_EnableBindless && GPU_Comms::SupportsBindless();
+
+		if (!Enabled) return;
+
+		CreateLayout();
+
+		CreatePool();
+
+		DescriptorSetLayout::Handle layout = Layout;
+
+		DescriptorPool::AllocateInfo allocInfo;
+
+		allocInfo.DescriptorPool     = Pool;
+		allocInfo.DescriptorSetCount = 1;
+		allocInfo.SetLayouts         = &layout;
+
+		if (Pool.Allocate(allocInfo, Sets) != EResult::Success)
+			throw RuntimeError("Failed to allocate the bindless descriptor set.");
+
+		PushRange.StageFlags.Set(EShaderStageFlag::Vertex, EShaderStageFlag::Fragment);
+
+		PushRange.Offset = 0;
+		PushRange.Size   = sizeof(BindlessIndices);
+	}
+
+	void Bindless_Maker<Meta::EGPU_Engage::Single>::Wipe()
+	{
+		if (!Enabled) return;
+
+		// The set goes with its pool.
+		Sets.clear();
+
+		Pool  .Destroy();
+		Layout.Destroy();
+
+		FreeTextures.clear();
+		FreeBuffers .clear();
+		Released    .clear();
+
+		NextTexture = 0;
+		NextBuffer  = 0;
+
+		Enabled = false;
+	}
+
+	bool Bindless_Maker<Meta::EGPU_Engage::Single>::IsEnabled()
+	{
+		return Enabled;
+	}
+
+	u32 Bindless_Maker<Meta::EGPU_Engage::Single>::Register(const TextureImage& _texture)
+	{
+		u32 index = AcquireIndex(FreeTextures, NextTexture, Meta::GPU_BindlessTextures);
+
+		DescriptorSet::ImageInfo imageInfo {};
+
+		imageInfo.ImageLayout = EImageLayout::Shader_ReadonlyOptimal;
+		imageInfo.ImageView   = _texture.GetView();
+		imageInfo.Sampler     = _texture.GetSampler();
+
+		DescriptorSet::Write write;
+
+		write.DstSet          = Sets[0]                ;
+		write.DstBinding      = Bindless_TextureBinding;
+		write.DstArrayElement = index                  ;
+
+		write.DescriptorType  = EDescriptorType::CombinedImageSampler;
+		write.DescriptorCount = 1                                    ;
+
+		write.BufferInfo      = nullptr   ;
+		write.ImageInfo       = &imageInfo;
+		write.TexelBufferView = nullptr   ;
+
+		// Update after bind, the set may be bound by frames in flight.
+		Sets[0].Update(1, &write, 0, nullptr);
+
+		return index;
+	}
+
+	void Bindless_Maker<Meta::EGPU_Engage::Single>::Release_Texture(u32 _index)
+	{
+		Released.push_back({ _index, Frame, true });
+	}
+
+	u32 Bindless_Maker<Meta::EGPU_Engage::Single>::Register(const Buffer& _buffer, DeviceSize _offset, DeviceSize _range)
+	{
+		u32 index = AcquireIndex(FreeBuffers, NextBuffer, Meta::GPU_BindlessBuffers);
+
+		DescriptorSet::BufferInfo bufferInfo;
+
+		bufferInfo.Buffer = _buffer;
+		bufferInfo.Offset = _offset;
+		bufferInfo.Range  = _range ;
+
+		DescriptorSet::Write write;
+
+		write.DstSet          = Sets[0]               ;
+		write.DstBinding      = Bindless_BufferBinding;
+		write.DstArrayElement = index                 ;
+
+		write.DescriptorType  = EDescriptorType::StorageBuffer;
+		write.DescriptorCount = 1                             ;
+
+		write.BufferInfo      = &bufferInfo;
+		write.ImageInfo       = nullptr    ;
+		write.TexelBufferView = nullptr    ;
+
+		Sets[0].Update(1, &write, 0, nullptr);
+
+		return index;
+	}
+
+	void Bindless_Maker<Meta::EGPU_Engage::Single>::Release_Buffer(u32 _index)
+	{
+		Released.push_back({ _index, Frame, false });
+	}
+
+	const DescriptorSetLayout& Bindless_Maker<Meta::EGPU_Engage::Single>::GetLayout()
+	{
+		return Layout;
+	}
+
+	const Pipeline::Layout::PushConstantRange& Bindless_Maker<Meta::EGPU_Engage::Single>::GetPushConstantRange()
+	{
+		return PushRange;
+	}
+
+	void Bindless_Maker<Meta::EGPU_Engage::Single>::Bind(const CommandBuffer& _commandBuffer, const PipelineLayout& _pipelineLayout)
+	{
+		_commandBuffer.BindDescriptorSets
+		(
+			EPipelineBindPoint::Graphics,
+			_pipelineLayout,
+			Bindless_Set,
+			1,
+			Sets[0],
+			0,
+			nullptr
+		);
+	}
+
+	void Bindless_Maker<Meta::EGPU_Engage::Single>::Push
+	(
+		const CommandBuffer&   _commandBuffer ,
+		const PipelineLayout&  _pipelineLayout,
+		const BindlessIndices& _indices
+	)
+	{
+		_commandBuffer.PushConstants(_pipelineLayout, PushRange.StageFlags, 0, sizeof(BindlessIndices), &_indices);
+	}
+
+	void Bindless_Maker<Meta::EGPU_Engage::Single>::EndFrame()
+	{
+		Frame++;
+
+		uDM kept = 0;
+
+		for (auto& released : Released)
+		{
+			if (Frame - released.Frame < Rendering::GetFramesBeforeReuse())
+			{
+				Released[kept++] = released;
+
+				continue;
+			}
+
+			if (released.Texture) FreeTextures.push_back(released.Index);
+			else                  FreeBuffers .push_back(released.Index);
+		}
+
+		Released.resize(kept);
+	}
+
+
+
+	// Private
+
+	u32 AcquireIndex(DynamicArray<u32>& _free, u32& _next, u32 _capacity)
+	{
+		if (!_free.empty())
+		{
+			u32 index = _free.back();
+
+			_free.pop_back();
+
+			return index;
+		}
+
+		if (_next == _capacity) throw RuntimeError("Bindless: Out of descriptor array indices.");
+
+		return _next++;
+	}
+
+	void CreateLayout()
+	{
+		StaticArray<DescriptorSetLayout::Binding, 2> bindings {};
+
+		bindings[0].BindingID         = Bindless_TextureBinding;
+		bindings[0].Type              = EDescriptorType::CombinedImageSampler;
+		bindings[0].Count             = Meta::GPU_BindlessTextures;
+		bindings[0].ImmutableSamplers = nullptr;
+
+		bindings[0].StageFlags.Set(EShaderStageFlag::Fragment);
+
+		bindings[1].BindingID         = Bindless_BufferBinding;
+		bindings[1].Type              = EDescriptorType::StorageBuffer;
+		bindings[1].Count             = Meta::GPU_BindlessBuffers;
+		bindings[1].ImmutableSamplers = nullptr;
+
+		bindings[1].StageFlags.Set(EShaderStageFlag::Vertex, EShaderStageFlag::Fragment);
+
+		// The wrapper has no binding flags info, the Vulkan structure is chained.
+		// Partially bound: unregistered elements are never written. Update after bind: registering does not wait on frames in flight.
+		StaticArray<VkDescriptorBindingFlagsEXT, 2> bindingFlags {};
+
+		bindingFlags.fill(VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT);
+
+		VkDescriptorSetLayoutBindingFlagsCreateInfoEXT flagsInfo {};
+
+		flagsInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+		flagsInfo.bindingCount  = SCast<u32>(bindingFlags.size());
+		flagsInfo.pBindingFlags = bindingFlags.data();
+
+		DescriptorSetLayout::CreateInfo layoutInfo;
+
+		layoutInfo.Next         = &flagsInfo;
+		layoutInfo.BindingCount = SCast<u32>(bindings.size());
+		layoutInfo.Bindings     = bindings.data();
+
+		layoutInfo.Flags.Set(EDescriptorSetLayoutCreateFlag::UpdateAfterBindPool);
+
+		if (Layout.Create(GPU_Comms::GetEngagedDevice(), layoutInfo) != EResult::Success)
+			throw RuntimeError("Failed to create the bindless descriptor set layout.");
+	}
+
+	void CreatePool()
+	{
+		StaticArray<DescriptorPool::Size, 2> poolSizes {};
+
+		poolSizes[0].Type  = EDescriptorType::CombinedImageSampler;
+		poolSizes[0].Count = Meta::GPU_BindlessTextures;
+
+		poolSizes[1].Type  = EDescriptorType::StorageBuffer;
+		poolSizes[1].Count = Meta::GPU_BindlessBuffers;
+
+		DescriptorPool::CreateInfo poolInfo {};
+
+		poolInfo.PoolSizeCount = SCast<u32>(poolSizes.size());
+		poolInfo.PoolSizes     = poolSizes.data();
+		poolInfo.MaxSets       = 1;
+
+		poolInfo.Flags.Set(EDescriptorPoolCreateFlag::UpdateAfterBind);
+
+		if (Pool.Create(GPU_Comms::GetEngagedDevice(), poolInfo) != EResult::Success)
+			throw RuntimeError("Failed to create the bindless descriptor pool.");
+	}
+}
@@ -0,0 +1,88 @@
+/*
+Bindless
+
+Global descriptor arrays of every texture and storage buffer, bound once per pipeline.
+
+Resources are registered for an index into the arrays instead of getting a descriptor set each,
+draws select what they use by pushing the indices as constants. Requires descriptor indexing
+(see GPU_Comms::SupportsBindless), without it renderables keep their own descriptor sets.
+
+Released indices are only reused once the frames that may still reference them are done.
+*/
+
+
+
+#pragma once
+
+
+
+#include "GPUVK_PayloadDeck.hpp"
+
+
+
+namespace HAL::GPU::Vulkan
+{
+	class Buffer;
+	class TextureImage;
+
+	// Set of the pipeline layouts the descriptor arrays are bound to, set 0 belongs to the renderable.
+	constexpr u32 Bindless_Set = 1;
+
+	// Binding of each array in the set.
+	constexpr u32 Bindless_TextureBinding = 0;
+	constexpr u32 Bindless_BufferBinding  = 1;
+
+	// Given when nothing is registered for the draw.
+	constexpr u32 Bindless_NoIndex = UINT32_MAX;
+
+	/*
+	The push constants of a bindless draw, matches the shaders' push constant block.
+	*/
+	struct BindlessIndices
+	{
+		u32 Texture = Bindless_NoIndex;
+		u32 Buffer  = Bindless_NoIndex;
+	};
+
+	template<Meta::EGPU_Engage>
+	class Bindless_Maker;
+
+	template<>
+	class Bindless_Maker<Meta::EGPU_Engage::Single>
+	{
+	public:
+
+		/*
+		Creates the descriptor arrays when the engaged device supports them and Meta::GPU_EnableBindless is set.
+		*/
+		unbound void Prepare();
+
+		unbound void Wipe();
+
+		unbound bool IsEnabled();
+
+		unbound u32  Register       (const TextureImage& _texture);
+		unbound void Release_Texture(u32 _index);
+
+		unbound u32  Register      (const Buffer& _buffer, DeviceSize _offset, DeviceSize _range);
+		unbound void Release_Buffer(u32 _index);
+
+		unbound const DescriptorSetLayout& GetLayout();
+
+		unbound const Pipeline::Layout::PushConstantRange& GetPushConstantRange();
+
+		/*
+		Binds the arrays to Bindless_Set, once after binding a pipeline.
+		*/
+		unbound void Bind(const CommandBuffer& _commandBuffer, const PipelineLayout& _pipelineLayout);
+
+		unbound void Push(const CommandBuffer& _commandBuffer, const PipelineLayout& _pipelineLayout, const BindlessIndices& _indices);
+
+		/*
+		Called once per frame, returns the indices released long enough ago to their free lists.
+		*/
+		unbound void EndFrame();
+	};
+
+	using Bindless = Bindless_Maker<Meta::GPU_Engagement>;
+}
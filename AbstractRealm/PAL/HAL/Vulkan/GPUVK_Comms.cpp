@@ -20,6 +20,13 @@ namespace HAL::GPU::Vulkan
 		DynamicArray<RoCStr>   DesiredInstanceExts   ;
 		DynamicArray<RoCStr>   DesiredDeviceExts     ;
 
+		// Enabled when supported, a device is not required to have them. A group is enabled only when all of it is supported (an extension and what it requires).
+		DynamicArray< DynamicArray<RoCStr>> OptionalDeviceExts;
+
+		// The instance is 1.0, the physical device queries of 1.1 come from VK_KHR_get_physical_device_properties2.
+		PFN_vkGetPhysicalDeviceFeatures2KHR   GetPhysicalDeviceFeatures2   = nullptr;
+		PFN_vkGetPhysicalDeviceProperties2KHR GetPhysicalDeviceProperties2 = nullptr;
+
 		DebugUtils::Messenger GPU_Messenger_Verbose;
 		DebugUtils::Messenger GPU_Messenger_Info;
 		DebugUtils::Messenger GPU_Messenger_Warning;
@@ -150,6 +157,8 @@ namespace HAL::GPU::Vulkan
 
 		ProcessExtensionSupport();
 
+		ProcessFeatureSupport();
+
 		ProcessLayerSupport();
 	}
 
@@ -234,6 +243,27 @@ namespace HAL::GPU::Vulkan
 		return transferQueue;
 	}
 
+	bool LogicalDevice::ExtensionEnabled(RoCStr _extension) const
+	{
+		for (auto& extension : extensionsEnabled)
+		{
+			if (CStrCompare(extension, _extension) == 0) return true;
+		}
+
+		return false;
+	}
+
+	bool LogicalDevice::SupportsBindless() const
+	{
+		return bindless;
+	}
+
+	bool LogicalDevice::HasDedicatedTransfer() const
+	{
+		// The transfer queue is only assigned a family that supports nothing else.
+		return transferQueue.FamilySpecified() && transferQueue.GetFamilyIndex() != graphicsQueue.GetFamilyIndex();
+	}
+
 	const String LogicalDevice::GetSig() const
 	{
 		StringStream handleStr; handleStr << handle;
@@ -370,10 +400,87 @@ namespace HAL::GPU::Vulkan
 			}			
 		}
 
+		for (auto& extensionGroup : OptionalDeviceExts)
+		{
+			if (physicalDevice->CheckExtensionSupport(extensionGroup))
+			{
+				extensionsEnabled.insert(extensionsEnabled.end(), extensionGroup.begin(), extensionGroup.end());
+			}
+		}
+
 		info.EnabledExtensionCount = SCast<u32>(extensionsEnabled.size());
 		info.EnabledExtensionNames = extensionsEnabled.data()               ;
 	}
 
+	void LogicalDevice::ProcessFeatureSupport()
+	{
+		// The wrapper only takes the core feature set, extension features are queried and chained with the Vulkan structures.
+		descriptorIndexing       = {};
+		descriptorIndexing.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+
+		bindless = false;
+
+		// Descriptor indexing is only enabled along with maintenance 3, and only queried through the instance extension.
+		if (!ExtensionEnabled(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME) || GetPhysicalDeviceFeatures2 == nullptr) return;
+
+		VkPhysicalDeviceFeatures2KHR features {};
+
+		features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+		features.pNext = &descriptorIndexing;
+
+		PhysicalDevice::Handle gpu = *physicalDevice;
+
+		GetPhysicalDeviceFeatures2(gpu, &features);
+
+		VkPhysicalDeviceDescriptorIndexingPropertiesEXT limits {};
+
+		limits.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES_EXT;
+
+		VkPhysicalDeviceProperties2KHR properties {};
+
+		properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2_KHR;
+		properties.pNext = &limits;
+
+		GetPhysicalDeviceProperties2(gpu, &properties);
+
+		// The arrays are allocated at full size, every element counts against the update after bind limits.
+		bool withinLimits =
+			limits.maxDescriptorSetUpdateAfterBindSampledImages         >= Meta::GPU_BindlessTextures &&
+			limits.maxPerStageDescriptorUpdateAfterBindSampledImages    >= Meta::GPU_BindlessTextures &&
+			limits.maxDescriptorSetUpdateAfterBindStorageBuffers        >= Meta::GPU_BindlessBuffers  &&
+			limits.maxPerStageDescriptorUpdateAfterBindStorageBuffers   >= Meta::GPU_BindlessBuffers  &&
+			limits.maxPerStageUpdateAfterBindResources                  >= Meta::GPU_BindlessTextures + Meta::GPU_BindlessBuffers &&
+			limits.maxUpdateAfterBindDescriptorsInAllPools              >= Meta::GPU_BindlessTextures + Meta::GPU_BindlessBuffers;
+
+		bindless =
+			withinLimits                                                     &&
+			descriptorIndexing.runtimeDescriptorArray                        &&
+			descriptorIndexing.descriptorBindingPartiallyBound               &&
+			descriptorIndexing.descriptorBindingSampledImageUpdateAfterBind  &&
+			descriptorIndexing.descriptorBindingStorageBufferUpdateAfterBind &&
+			descriptorIndexing.shaderSampledImageArrayNonUniformIndexing;
+
+		if (!withinLimits) Log("Bindless disabled: the device's update after bind limits are below the bindless array sizes.");
+
+		// Only what the bindless table uses is enabled.
+		VkPhysicalDeviceDescriptorIndexingFeaturesEXT enabled {};
+
+		enabled.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+
+		if (bindless)
+		{
+			enabled.runtimeDescriptorArray                        = VK_TRUE;
+			enabled.descriptorBindingPartiallyBound               = VK_TRUE;
+			enabled.descriptorBindingSampledImageUpdateAfterBind  = VK_TRUE;
+			enabled.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+			enabled.shaderSampledImageArrayNonUniformIndexing     = VK_TRUE;
+
+			info.Next = &descriptorIndexing;
+		}
+
+		descriptorIndexing = enabled;
+	}
+
 	void LogicalDevice::ProcessLayerSupport()
 	{
 		if (Meta::Vulkan::EnableLayers())
@@ -537,6 +644,16 @@ namespace HAL::GPU::Vulkan
 
 		Log("Application handshake complete.");
 
+		if (std::find(DesiredInstanceExts.begin(), DesiredInstanceExts.end(), VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME) != DesiredInstanceExts.end())
+		{
+			AppInstance::Handle instance = AppGPU_Comms;
+
+			GetPhysicalDeviceFeatures2   = RCast<std::remove_pointer_t<PFN_vkGetPhysicalDeviceFeatures2KHR  >>(vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFeatures2KHR"  ));
+			GetPhysicalDeviceProperties2 = RCast<std::remove_pointer_t<PFN_vkGetPhysicalDeviceProperties2KHR>>(vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceProperties2KHR"));
+
+			if (GetPhysicalDeviceProperties2 == nullptr) GetPhysicalDeviceFeatures2 = nullptr;
+		}
+
 		if (Meta::Vulkan::EnableLayers())
 		{
 			if (Meta::Vulkan::Enable_LogError())
@@ -685,6 +802,16 @@ namespace HAL::GPU::Vulkan
 		return DeviceEngaged->GetTransferQueue();
 	}
 
+	bool GPU_Comms_Maker<Meta::EGPU_Engage::Single>::HasDedicatedTransfer()
+	{
+		return DeviceEngaged->HasDedicatedTransfer();
+	}
+
+	bool GPU_Comms_Maker<Meta::EGPU_Engage::Single>::SupportsBindless()
+	{
+		return DeviceEngaged->SupportsBindless();
+	}
+
 #pragma endregion Public
 
 #pragma region Protected
@@ -932,6 +1059,36 @@ namespace HAL::GPU::Vulkan
 
 		Log("Added desired device extension: " + String(DeviceExt::Swapchain));
 
+		if (Meta::GPU_EnableBindless)
+		{
+			// Descriptor indexing requires the 1.1 physical device queries on the instance, and maintenance 3 on the device.
+			u32 available = 0;
+
+			vkEnumerateInstanceExtensionProperties(nullptr, &available, nullptr);
+
+			DynamicArray<VkExtensionProperties> instanceExts(available);
+
+			vkEnumerateInstanceExtensionProperties(nullptr, &available, instanceExts.data());
+
+			bool hasProperties2 = false;
+
+			for (auto& extension : instanceExts)
+			{
+				if (CStrCompare(extension.extensionName, VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME) == 0) hasProperties2 = true;
+			}
+
+			if (hasProperties2)
+			{
+				DesiredInstanceExts.push_back(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
+
+				Log("Added desired instance extension: " + String(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME));
+
+				OptionalDeviceExts.push_back({ VK_KHR_MAINTENANCE3_EXTENSION_NAME, VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME });
+
+				Log("Added optional device extensions: " + String(VK_KHR_MAINTENANCE3_EXTENSION_NAME) + ", " + String(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME));
+			}
+		}
+
 		if (Meta::Vulkan::EnableLayers())
 		{
 			DesiredInstanceExts.push_back(InstanceExt::DebugUtility);
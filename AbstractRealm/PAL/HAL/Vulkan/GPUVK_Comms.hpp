@@ -106,6 +106,8 @@ namespace HAL::GPU::Vulkan
 		EResult Create();
 
 		bool ExtensionsEnabled(DynamicArray<RoCStr> _extensions);
+
+		bool ExtensionEnabled(RoCStr _extension) const;
 		
 		const PhysicalDevice& GetPhysicalDevice() const;
 
@@ -115,6 +117,12 @@ namespace HAL::GPU::Vulkan
 		const Queue& GetComputeQueue () const;
 		const Queue& GetTransferQueue() const;
 
+		// A transfer only queue family was found, uploads can run alongside graphics work.
+		bool HasDedicatedTransfer() const;
+
+		// Descriptor indexing is enabled with what the bindless descriptor table needs.
+		bool SupportsBindless() const;
+
 		const String GetSig() const;
 
 		operator       Handle ();
@@ -126,6 +134,7 @@ namespace HAL::GPU::Vulkan
 
 		void PrepareQueues          ();
 		void ProcessExtensionSupport();
+		void ProcessFeatureSupport  ();
 		void ProcessLayerSupport    ();
 
 		// An object used to organize
@@ -156,6 +165,11 @@ namespace HAL::GPU::Vulkan
 		Queue transferQueue;
 
 		DynamicArray<RoCStr> extensionsEnabled;
+
+		// Extension features, chained to the device creation info.
+		VkPhysicalDeviceDescriptorIndexingFeaturesEXT descriptorIndexing {};
+
+		bool bindless = false;
 	};
 
 
@@ -195,6 +209,10 @@ namespace HAL::GPU::Vulkan
 		unbound const LogicalDevice::Queue& GetComputeQueue ();   // Provides a reference to the engaged device's compute queue.
 		unbound const LogicalDevice::Queue& GetTransferQueue();   // Provides a reference to the engaged device's transfer queue.
 
+		unbound bool HasDedicatedTransfer();
+
+		unbound bool SupportsBindless();
+
 	protected:
 
 		unbound void AquireSupportedValidationLayers();
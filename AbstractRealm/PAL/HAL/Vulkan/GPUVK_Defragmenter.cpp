@@ -0,0 +1,328 @@
+// Parent Header
+#include "GPUVK_Defragmenter.hpp"
+
+
+
+#include "GPUVK_Barriers.hpp"
+#include "GPUVK_Rendering.hpp"
+
+
+
+
+namespace HAL::GPU::Vulkan
+{
+	// Private
+
+	struct Relocatable
+	{
+		ptr<Buffer>           Resource;
+		ptr<MemoryAllocation> Memory  ;
+	};
+
+	struct Relocation
+	{
+		ptr<Relocatable> Entry;
+
+		Buffer           Replacement;
+		MemoryAllocation Allocation ;
+	};
+
+	/*
+	A moved out buffer, released once its copy is done and the frames that may bind it are.
+	*/
+	struct RetiredBuffer
+	{
+		Buffer           Resource;
+		MemoryAllocation Memory  ;
+
+		u32  Frame ;   // Frame it was moved during.
+		bool Copied;
+	};
+
+	// Frames to wait after a pass could not move anything, the other blocks have to free up first.
+	constexpr u32 FramesBeforeRetry = 60;
+
+	StaticData()
+
+		DynamicArray<Relocatable>   Registered;
+		DynamicArray<RetiredBuffer> Retired   ;
+
+		sInternal ptr<CommandPool>         Pool     = nullptr;
+		sInternal ptr<const CommandBuffer> Commands = nullptr;
+
+		Fence Done;
+
+		bool InFlight = false;
+
+		sInternal u32 Frame      = 0;
+		sInternal u32 RetryFrame = 0;
+
+
+
+	// Forwards
+
+	ptr<const MemoryBlock> FindSparseBlock();
+
+	void ReleaseRetired(bool _all);
+
+	void Record(DynamicArray<Relocation>& _relocations);
+
+
+
+	// Public
+
+	void Defragmenter_Maker<Meta::EGPU_Engage::Single>::Prepare()
+	{
+		Pool     = Deck::RequestCommandPools(1);
+		Commands = &Pool->RequestBuffer();
+
+		Fence::CreateInfo fenceInfo;
+
+		Done.Create(GPU_Comms::GetEngagedDevice(), fenceInfo);
+
+		InFlight   = false;
+		Frame      = 0;
+		RetryFrame = 0;
+	}
+
+	void Defragmenter_Maker<Meta::EGPU_Engage::Single>::Wipe()
+	{
+		if (InFlight) Done.WaitFor(UInt64Max);
+
+		InFlight = false;
+
+		ReleaseRetired(true);
+
+		Done.Destroy();
+
+		// The command pool is destroyed with the deck.
+		Registered.clear();
+	}
+
+	void Defragmenter_Maker<Meta::EGPU_Engage::Single>::Register(Buffer& _buffer, MemoryAllocation& _memory)
+	{
+		Registered.push_back({ getPtr(_buffer), getPtr(_memory) });
+	}
+
+	void Defragmenter_Maker<Meta::EGPU_Engage::Single>::Unregister(const Buffer& _buffer)
+	{
+		for (auto entry = Registered.begin(); entry != Registered.end(); entry++)
+		{
+			if (entry->Resource == getPtr(_buffer))
+			{
+				Registered.erase(entry);
+
+				return;
+			}
+		}
+	}
+
+	void Defragmenter_Maker<Meta::EGPU_Engage::Single>::Update()
+	{
+		Frame++;
+
+		if (InFlight)
+		{
+			// Still copying, nothing new is started until it is done.
+			if (Done.WaitFor(0) != EResult::Success) return;
+
+			InFlight = false;
+
+			for (auto& retired : Retired) retired.Copied = true;
+		}
+
+		ReleaseRetired(false);
+
+		if (Frame < RetryFrame) return;
+
+		ptr<const MemoryBlock> sparse = FindSparseBlock();
+
+		if (sparse == nullptr) return;
+
+		DynamicArray<Relocation> relocations;
+
+		DeviceSize moved = 0;
+
+		for (auto& entry : Registered)
+		{
+			if (entry.Memory->Block != sparse) continue;
+
+			// The block only holds allocations that fit the budget on their own, the first one always does.
+			if (moved + entry.Memory->Size > Meta::GPU_DefragBytesPerFrame) break;
+
+			Relocation relocation;
+
+			relocation.Entry = getPtr(entry);
+
+			if (relocation.Replacement.Create(GPU_Comms::GetEngagedDevice(), entry.Resource->GetInfo()) != EResult::Success) break;
+
+			if (AllocateForRelocation(relocation.Replacement.GetMemoryRequirements(), *entry.Memory, relocation.Allocation) != EResult::Success)
+			{
+				relocation.Replacement.Destroy();
+
+				break;
+			}
+
+			relocation.Replacement.BindMemory(relocation.Allocation.GetMemory(), relocation.Allocation.Offset);
+
+			moved += entry.Memory->Size;
+
+			relocations.push_back(relocation);
+		}
+
+		if (relocations.empty())
+		{
+			RetryFrame = Frame + FramesBeforeRetry;
+
+			return;
+		}
+
+		Record(relocations);
+
+		CommandBuffer::SubmitInfo submitInfo;
+
+		submitInfo.CommandBufferCount = 1;
+		submitInfo.CommandBuffers     = dref(Commands);
+
+		Done.Reset();
+
+		if (GPU_Comms::GetGraphicsQueue().SubmitToQueue(1, submitInfo, Done) != EResult::Success)
+			throw RuntimeError("Failed to submit the defragmentation copies.");
+
+		InFlight = true;
+
+		// Frames are submitted after the copies on the same queue, they can use the replacements from now on.
+		for (auto& relocation : relocations)
+		{
+			Retired.push_back({ dref(relocation.Entry->Resource), dref(relocation.Entry->Memory), Frame, false });
+
+			dref(relocation.Entry->Resource) = relocation.Replacement;
+			dref(relocation.Entry->Memory  ) = relocation.Allocation ;
+		}
+	}
+
+
+
+	// Private
+
+	ptr<const MemoryBlock> FindSparseBlock()
+	{
+		Map< ptr<const MemoryBlock>, uDM> movable;
+
+		// Blocks holding an allocation larger than a frame's budget, it could not be moved without exceeding it.
+		Map< ptr<const MemoryBlock>, bool> oversized;
+
+		for (auto& entry : Registered)
+		{
+			if (!entry.Memory->IsValid()) continue;
+
+			movable[entry.Memory->Block]++;
+
+			if (entry.Memory->Size > Meta::GPU_DefragBytesPerFrame) oversized[entry.Memory->Block] = true;
+		}
+
+		ptr<const MemoryBlock> sparsest  = nullptr;
+		DeviceSize             allocated = 0;
+
+		for (auto& block : movable)
+		{
+			MemoryBlockUsage usage = GetBlockUsage(block.first);
+
+			// A block with an allocation that cannot be moved would never be freed.
+			if (usage.Dedicated || usage.Allocations != block.second || oversized.count(block.first) > 0) continue;
+
+			if (usage.Allocated * 100 >= usage.Size * Meta::GPU_DefragOccupancy) continue;
+
+			if (sparsest == nullptr || usage.Allocated < allocated)
+			{
+				sparsest  = block.first    ;
+				allocated = usage.Allocated;
+			}
+		}
+
+		return sparsest;
+	}
+
+	void ReleaseRetired(bool _all)
+	{
+		uDM kept = 0;
+
+		for (auto& retired : Retired)
+		{
+			if (!_all && (!retired.Copied || Frame - retired.Frame < Rendering::GetFramesBeforeReuse()))
+			{
+				Retired[kept++] = retired;
+
+				continue;
+			}
+
+			retired.Resource.Destroy();
+
+			FreeMemory(retired.Memory);
+		}
+
+		Retired.resize(kept);
+	}
+
+	void Record(DynamicArray<Relocation>& _relocations)
+	{
+		Pool->Reset(0);
+
+		CommandBuffer::BeginInfo beginInfo;
+
+		beginInfo.Flags = ECommandBufferUsageFlag::OneTimeSubmit;
+
+		if (Commands->BeginRecord(beginInfo) != EResult::Success)
+			throw RuntimeError("Failed to begin the defragmentation copies.");
+
+		BarrierBatch before;
+		BarrierBatch after ;
+
+		for (auto& relocation : _relocations)
+		{
+			Buffer::Memory_Barrier barrier {};
+
+			barrier.SrcQueueFamilyIndex = QueueFamily_Ignored;
+			barrier.DstQueueFamilyIndex = QueueFamily_Ignored;
+
+			barrier.Offset = 0;
+			barrier.Size   = relocation.Entry->Resource->GetSize();
+
+			// The contents were last written by staging copies.
+			barrier.Buffer = dref(relocation.Entry->Resource);
+
+			barrier.SrcAccessMask.Set(EAccessFlag::TransferWrite);
+			barrier.DstAccessMask.Set(EAccessFlag::TransferRead );
+
+			before.Add(barrier, EPipelineStageFlag::Transfer, EPipelineStageFlag::Transfer);
+
+			barrier.Buffer = relocation.Replacement;
+
+			barrier.SrcAccessMask.Reset();
+			barrier.DstAccessMask.Reset();
+
+			barrier.SrcAccessMask.Set(EAccessFlag::TransferWrite);
+			barrier.DstAccessMask.Set(EAccessFlag::VertexAttributeRead, EAccessFlag::IndexRead);
+
+			after.Add(barrier, EPipelineStageFlag::Transfer, EPipelineStageFlag::VertexInput);
+		}
+
+		before.Flush(dref(Commands));
+
+		for (auto& relocation : _relocations)
+		{
+			Buffer::CopyInfo copyInfo {};
+
+			copyInfo.SourceOffset      = 0;
+			copyInfo.DestinationOffset = 0;
+			copyInfo.Size              = relocation.Entry->Resource->GetSize();
+
+			Commands->CopyBuffer(dref(relocation.Entry->Resource), relocation.Replacement, 1, &copyInfo);
+		}
+
+		after.Flush(dref(Commands));
+
+		if (Commands->EndRecord() != EResult::Success)
+			throw RuntimeError("Failed to end the defragmentation copies.");
+	}
+}
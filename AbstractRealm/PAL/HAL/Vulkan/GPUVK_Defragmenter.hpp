@@ -0,0 +1,64 @@
+/*
+Defragmenter
+
+Compacts device memory across frames, so streaming resources in and out does not leave the blocks
+of the sub-allocator sparse.
+
+Each frame the sparsest block whose allocations can all be moved is picked, and as many of its
+resources as fit Meta::GPU_DefragBytesPerFrame are copied into denser blocks of the same kind on the
+graphics queue. A block holding a resource larger than the budget is left as is, moving it would stall
+the frame it is copied in. Owners are switched to the copies right away: the copies are submitted ahead of the
+frame. The originals are released once the copies are done and no frame in flight can reference them,
+a block left empty goes back to the sub-allocator.
+*/
+
+
+
+#pragma once
+
+
+
+#include "GPUVK_Resources.hpp"
+#include "GPUVK_PayloadDeck.hpp"
+
+
+
+namespace HAL::GPU::Vulkan
+{
+	template<Meta::EGPU_Engage>
+	class Defragmenter_Maker;
+
+	template<>
+	class Defragmenter_Maker<Meta::EGPU_Engage::Single>
+	{
+	public:
+
+		unbound void Prepare();
+
+		/*
+		Waits for the copies in flight and releases the moved out resources.
+		*/
+		unbound void Wipe();
+
+		/*
+		Allows _buffer to be moved, replacing _buffer and _memory in place. The handle changes after a move.
+
+		Only for device local buffers written through staging whose handle is not kept elsewhere (bound per draw).
+		The buffer needs transfer source and destination usage. Both are kept by address: until unregistered
+		they must not be moved, so their owner is neither copyable nor movable.
+		*/
+		unbound void Register(Buffer& _buffer, MemoryAllocation& _memory);
+
+		/*
+		Before the buffer is destroyed.
+		*/
+		unbound void Unregister(const Buffer& _buffer);
+
+		/*
+		Called once per frame, after the staging batch is submitted and before the frames are.
+		*/
+		unbound void Update();
+	};
+
+	using Defragmenter = Defragmenter_Maker<Meta::GPU_Engagement>;
+}
@@ -0,0 +1,357 @@
+// Parent Header
+#include "GPUVK_Geometry.hpp"
+
+
+
+#include "GPUVK_Defragmenter.hpp"
+#include "GPUVK_Rendering.hpp"
+#include "GPUVK_Resources.hpp"
+#include "GPUVK_Staging.hpp"
+
+#include <algorithm>
+
+
+
+
+namespace HAL::GPU::Vulkan
+{
+	// Private
+
+	// Free ranges of a pool buffer in elements, by first element. Adjacent ranges are merged.
+	using RangeList = Map<u32, u32>;
+
+	struct GeometryPool
+	{
+		DeviceSize Stride;
+
+		Buffer           Vertices    ;
+		MemoryAllocation VertexMemory;
+
+		Buffer           Indices    ;
+		MemoryAllocation IndexMemory;
+
+		RangeList FreeVertices;
+		RangeList FreeIndices ;
+
+		bool Mapped = false;   // Both buffers are device local and host visible.
+	};
+
+	struct FreedRange
+	{
+		GeometryRange Range;
+		u32           Frame;   // Frame it was freed during.
+	};
+
+	StaticData()
+
+		// Stable, ranges refer to their pool by index.
+		DynamicArray< UPtr<GeometryPool>> Pools;
+
+		DynamicArray<FreedRange> Freed;
+
+		sInternal u32 Frame = 0;
+
+
+
+	// Forwards
+
+	u32 CreatePool(DeviceSize _stride, u32 _vertices, u32 _indices);
+
+	bool CreateBuffer(Buffer& _buffer, MemoryAllocation& _memory, DeviceSize _size, EBufferUsage _usage, bool _mapped);
+
+	void Write(const GeometryPool& _pool, const Buffer& _buffer, const MemoryAllocation& _memory, DeviceSize _offset, ptr<const void> _data, DeviceSize _size);
+
+	bool Reserve(GeometryPool& _pool, u32 _vertexCount, u32 _indexCount, GeometryRange& _range);
+
+	bool TakeRange(RangeList& _free, u32 _count, u32& _first);
+
+	void ReturnRange(RangeList& _free, u32 _first, u32 _count);
+
+
+
+	// Public
+
+	void Geometry_Maker<Meta::EGPU_Engage::Single>::Wipe()
+	{
+		for (auto& pool : Pools)
+		{
+			Defragmenter::Unregister(pool->Vertices);
+			Defragmenter::Unregister(pool->Indices );
+
+			pool->Vertices.Destroy();
+			pool->Indices .Destroy();
+
+			FreeMemory(pool->VertexMemory);
+			FreeMemory(pool->IndexMemory );
+		}
+
+		Pools.clear();
+		Freed.clear();
+	}
+
+	GeometryRange Geometry_Maker<Meta::EGPU_Engage::Single>::Allocate
+	(
+		ptr<const void> _vertices, u32 _vertexCount, DeviceSize _stride,
+		ptr<const u32>  _indices,  u32 _indexCount
+	)
+	{
+		GeometryRange range;
+
+		for (u32 index = 0; index < Pools.size(); index++)
+		{
+			if (Pools[index]->Stride != _stride) continue;
+
+			if (Reserve(dref(Pools[index]), _vertexCount, _indexCount, range))
+			{
+				range.Pool = index;
+
+				break;
+			}
+		}
+
+		if (!range.IsValid())
+		{
+			// A mesh larger than a pool gets one sized for it.
+			u32 vertexCapacity = std::max(SCast<u32>(Meta::GPU_GeometryVertexSize / _stride     ), _vertexCount);
+			u32 indexCapacity  = std::max(SCast<u32>(Meta::GPU_GeometryIndexSize  / sizeof(u32)), _indexCount );
+
+			u32 index = CreatePool(_stride, vertexCapacity, indexCapacity);
+
+			Reserve(dref(Pools[index]), _vertexCount, _indexCount, range);
+
+			range.Pool = index;
+		}
+
+		GeometryPool& pool = dref(Pools[range.Pool]);
+
+		Write(pool, pool.Vertices, pool.VertexMemory, DeviceSize(range.FirstVertex) * _stride     , _vertices, DeviceSize(_vertexCount) * _stride     );
+		Write(pool, pool.Indices , pool.IndexMemory , DeviceSize(range.FirstIndex ) * sizeof(u32), _indices , DeviceSize(_indexCount ) * sizeof(u32));
+
+		return range;
+	}
+
+	void Geometry_Maker<Meta::EGPU_Engage::Single>::Free(GeometryRange& _range)
+	{
+		if (!_range.IsValid()) return;
+
+		Freed.push_back({ _range, Frame });
+
+		_range = GeometryRange();
+	}
+
+	void Geometry_Maker<Meta::EGPU_Engage::Single>::Bind(const CommandBuffer& _commandBuffer, u32 _pool)
+	{
+		GeometryPool& pool = dref(Pools[_pool]);
+
+		Buffer::Handle handle = pool.Vertices;
+
+		DeviceSize offset = 0;
+
+		_commandBuffer.BindVertexBuffers(0, 1, &handle, &offset);
+
+		_commandBuffer.BindIndexBuffer(pool.Indices, 0, EIndexType::uInt32);
+	}
+
+	void Geometry_Maker<Meta::EGPU_Engage::Single>::Draw(const CommandBuffer& _commandBuffer, const GeometryRange& _range, u32 _instances)
+	{
+		_commandBuffer.DrawIndexed
+		(
+			_range.IndexCount,
+			_instances,
+			_range.FirstIndex,
+			SCast<si32>(_range.FirstVertex),   // Indices are relative to the mesh.
+			0
+		);
+	}
+
+	void Geometry_Maker<Meta::EGPU_Engage::Single>::EndFrame()
+	{
+		Frame++;
+
+		uDM kept = 0;
+
+		for (auto& freed : Freed)
+		{
+			if (Frame - freed.Frame < Rendering::GetFramesBeforeReuse())
+			{
+				Freed[kept++] = freed;
+
+				continue;
+			}
+
+			GeometryPool& pool = dref(Pools[freed.Range.Pool]);
+
+			ReturnRange(pool.FreeVertices, freed.Range.FirstVertex, freed.Range.VertexCount);
+			ReturnRange(pool.FreeIndices , freed.Range.FirstIndex , freed.Range.IndexCount );
+		}
+
+		Freed.resize(kept);
+	}
+
+
+
+	// Private
+
+	u32 CreatePool(DeviceSize _stride, u32 _vertices, u32 _indices)
+	{
+		UPtr<GeometryPool> pool = MakeUPtr<GeometryPool>();
+
+		pool->Stride = _stride;
+		pool->Mapped = HasDeviceHostMemory();
+
+		// The host visible window of VRAM may be full, a pool that does not fit in it is staged into instead.
+		pool->Mapped = CreateBuffer(pool->Vertices, pool->VertexMemory, _stride * _vertices, EBufferUsage::VertexBuffer, pool->Mapped);
+
+		if (!CreateBuffer(pool->Indices, pool->IndexMemory, sizeof(u32) * _indices, EBufferUsage::IndexBuffer, pool->Mapped) && pool->Mapped)
+		{
+			pool->Vertices.Destroy();
+
+			FreeMemory(pool->VertexMemory);
+
+			pool->Mapped = false;
+
+			CreateBuffer(pool->Vertices, pool->VertexMemory, _stride * _vertices, EBufferUsage::VertexBuffer, false);
+		}
+
+		pool->FreeVertices.emplace(0, _vertices);
+		pool->FreeIndices .emplace(0, _indices );
+
+		// Pools are only bound through Bind, their handles can change between frames. Owned through a pointer, they keep their address.
+		// Mapped ones are written by the host, a move would race it.
+		if (!pool->Mapped)
+		{
+			Defragmenter::Register(pool->Vertices, pool->VertexMemory);
+			Defragmenter::Register(pool->Indices , pool->IndexMemory );
+		}
+
+		Pools.push_back(move(pool));
+
+		return SCast<u32>(Pools.size() - 1);
+	}
+
+	/*
+	Returns whether the buffer ended up in device local host visible memory, only tried when _mapped is set.
+	*/
+	bool CreateBuffer(Buffer& _buffer, MemoryAllocation& _memory, DeviceSize _size, EBufferUsage _usage, bool _mapped)
+	{
+		Buffer::CreateInfo info {};
+
+		info.Size        = _size;
+		info.SharingMode = ESharingMode::Exclusive;
+
+		// Transfer source so the defragmenter can move it.
+		info.Usage.Set(EBufferUsage::TransferSource, EBufferUsage::TransferDestination, _usage);
+
+		if (_buffer.Create(GPU_Comms::GetEngagedDevice(), info) != EResult::Success)
+			throw RuntimeError("Failed to create a geometry pool buffer.");
+
+		if (_mapped)
+			_mapped = AllocateDeviceHostMemory(_buffer.GetMemoryRequirements(), EResourceTiling::Linear, _memory) == EResult::Success;
+
+		if (!_mapped)
+		{
+			EResult result = AllocateMemory
+			(
+				_buffer.GetMemoryRequirements(),
+				Memory::PropertyFlags(EMemoryPropertyFlag::DeviceLocal),
+				EResourceTiling::Linear,
+				_memory
+			);
+
+			if (result != EResult::Success)
+				throw RuntimeError("Failed to allocate a geometry pool buffer.");
+		}
+
+		_buffer.BindMemory(_memory.GetMemory(), _memory.Offset);
+
+		return _mapped;
+	}
+
+	void Write(const GeometryPool& _pool, const Buffer& _buffer, const MemoryAllocation& _memory, DeviceSize _offset, ptr<const void> _data, DeviceSize _size)
+	{
+		// The range is new or was freed frames before reuse ago, nothing in flight draws it.
+		if (_pool.Mapped) _memory.WriteToGPU(_offset, _size, _data);
+		else              Staging::Upload(_buffer, _offset, _data, _size);
+	}
+
+	bool Reserve(GeometryPool& _pool, u32 _vertexCount, u32 _indexCount, GeometryRange& _range)
+	{
+		u32 firstVertex = 0;
+		u32 firstIndex  = 0;
+
+		if (!TakeRange(_pool.FreeVertices, _vertexCount, firstVertex)) return false;
+
+		if (!TakeRange(_pool.FreeIndices, _indexCount, firstIndex))
+		{
+			ReturnRange(_pool.FreeVertices, firstVertex, _vertexCount);
+
+			return false;
+		}
+
+		_range.FirstVertex = firstVertex ;
+		_range.VertexCount = _vertexCount;
+		_range.FirstIndex  = firstIndex  ;
+		_range.IndexCount  = _indexCount ;
+
+		return true;
+	}
+
+	bool TakeRange(RangeList& _free, u32 _count, u32& _first)
+	{
+		if (_count == 0)
+		{
+			_first = 0;
+
+			return true;
+		}
+
+		// First fit, keeps the start of the pools dense.
+		for (auto range = _free.begin(); range != _free.end(); range++)
+		{
+			if (range->second < _count) continue;
+
+			_first = range->first;
+
+			u32 remaining = range->second - _count;
+
+			_free.erase(range);
+
+			if (remaining > 0) _free.emplace(_first + _count, remaining);
+
+			return true;
+		}
+
+		return false;
+	}
+
+	void ReturnRange(RangeList& _free, u32 _first, u32 _count)
+	{
+		if (_count == 0) return;
+
+		auto next = _free.lower_bound(_first);
+
+		if (next != _free.begin())
+		{
+			auto previous = std::prev(next);
+
+			if (previous->first + previous->second == _first)
+			{
+				_first  = previous->first;
+				_count += previous->second;
+
+				_free.erase(previous);
+			}
+		}
+
+		next = _free.lower_bound(_first);
+
+		if (next != _free.end() && _first + _count == next->first)
+		{
+			_count += next->second;
+
+			_free.erase(next);
+		}
+
+		_free.emplace(_first, _count);
+	}
+}
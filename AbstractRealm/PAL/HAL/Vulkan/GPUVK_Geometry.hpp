@@ -0,0 +1,102 @@
+/*
+Geometry
+
+Vertices and indices of every mesh, sub-allocated from a few large device local buffers.
+
+Meshes with the same vertex stride share a pool: a vertex buffer and an index buffer. A mesh is a range of
+each, drawn with its first index and vertex offset, so indices stay relative to the mesh. A pass binds a
+pool once for all the meshes in it instead of binding buffers per object, which is also what indirect
+and multi-draw need.
+
+Pools are Meta::GPU_GeometryVertexSize / Meta::GPU_GeometryIndexSize, another one is created for the
+stride when they are full. Freed ranges are only reused once the frames that may still draw them are done.
+
+When the device has memory both device local and host visible (resizable BAR, integrated GPUs) pools are
+placed in it and meshes are written through the mapping, without a staging copy. Otherwise the pools are
+device local, uploaded through staging, and registered with the defragmenter, which moves them out of
+sparse memory blocks.
+Ranges within a pool are not compacted, freed ones are merged with their neighbours and reused first fit.
+*/
+
+
+
+#pragma once
+
+
+
+#include "GPUVK_PayloadDeck.hpp"
+
+
+
+namespace HAL::GPU::Vulkan
+{
+	constexpr u32 Geometry_NoPool = UINT32_MAX;
+
+	/*
+	Where a mesh is in its pool, in vertices and indices.
+	*/
+	struct GeometryRange
+	{
+		u32 Pool = Geometry_NoPool;
+
+		u32 FirstVertex = 0;
+		u32 VertexCount = 0;
+
+		u32 FirstIndex = 0;
+		u32 IndexCount = 0;
+
+		bool IsValid() const { return Pool != Geometry_NoPool; }
+	};
+
+	template<Meta::EGPU_Engage>
+	class Geometry_Maker;
+
+	template<>
+	class Geometry_Maker<Meta::EGPU_Engage::Single>
+	{
+	public:
+
+		/*
+		Releases every pool, only once nothing draws from them.
+		*/
+		unbound void Wipe();
+
+		/*
+		Sub-allocates the mesh in a pool of _stride, written through the pool's mapping or uploaded through staging.
+		*/
+		unbound GeometryRange Allocate
+		(
+			ptr<const void> _vertices, u32 _vertexCount, DeviceSize _stride,
+			ptr<const u32>  _indices,  u32 _indexCount
+		);
+
+		template<typename VertexType>
+		unbound GeometryRange Allocate(const DynamicArray<VertexType>& _vertices, const DynamicArray<u32>& _indices)
+		{
+			return Allocate
+			(
+				_vertices.data(), SCast<u32>(_vertices.size()), sizeof(VertexType),
+				_indices .data(), SCast<u32>(_indices .size())
+			);
+		}
+
+		unbound void Free(GeometryRange& _range);
+
+		/*
+		Binds the vertex and index buffers of _pool, at binding 0.
+		*/
+		unbound void Bind(const CommandBuffer& _commandBuffer, u32 _pool);
+
+		/*
+		Records the indexed draw of _range, the range's pool must be bound.
+		*/
+		unbound void Draw(const CommandBuffer& _commandBuffer, const GeometryRange& _range, u32 _instances = 1);
+
+		/*
+		Called once per frame, returns the ranges freed long enough ago to their pools.
+		*/
+		unbound void EndFrame();
+	};
+
+	using Geometry = Geometry_Maker<Meta::GPU_Engagement>;
+}
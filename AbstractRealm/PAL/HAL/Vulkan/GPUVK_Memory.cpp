@@ -3,18 +3,65 @@
 
 
 
+#include <algorithm>
+#include <cstring>
+
+
+
 
 namespace HAL::GPU::Vulkan
 {
+	struct MemoryBlock
+	{
+		Memory Object;
+
+		u32             TypeIndex;
+		EResourceTiling Tiling   ;
+		bool            Dedicated;
+
+		// Free ranges by offset (to coalesce) and by size (to find the best fit).
+		Map<DeviceSize, DeviceSize>           FreeByOffset;
+		std::multimap<DeviceSize, DeviceSize> FreeBySize  ;
+
+		DeviceSize Allocated   = 0;
+		uDM        Allocations = 0;
+
+		ptr<void> Mapped = nullptr;   // The whole block, mapped on first use.
+	};
+
+	constexpr VkMemoryPropertyFlags DeviceHostFlags =
+		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT  |
+		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT  |
+		VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
 	StaticData()
 
-		DynamicArray<Memory> Memories;
+		DynamicArray< UPtr<MemoryBlock>> Blocks;
+
+		// Of the engaged device, queried on first use.
+		VkPhysicalDeviceMemoryProperties MemoryProperties {};
+
+		bool PropertiesQueried = false;
 
 
 
 	// Forwards
 
-	const Memory& RequestMemory(const Memory::AllocateInfo& _info);
+	EResult AllocateFromType(u32 _typeIndex, const Memory::Requirements& _requirements, EResourceTiling _tiling, MemoryAllocation& _allocation);
+
+	const VkPhysicalDeviceMemoryProperties& GetMemoryProperties();
+
+	bool FindDeviceHostType(u32 _typeBits, u32& _typeIndex);
+
+	ptr<MemoryBlock> CreateBlock(u32 _typeIndex, EResourceTiling _tiling, DeviceSize _size, bool _dedicated, EResult& _result);
+
+	void ReleaseBlock(ptr<MemoryBlock> _block);
+
+	bool SubAllocate(MemoryBlock& _block, DeviceSize _size, DeviceSize _alignment, DeviceSize& _offset);
+
+	void AddFreeRange(MemoryBlock& _block, DeviceSize _offset, DeviceSize _size);
+
+	void RemoveFreeRange(MemoryBlock& _block, DeviceSize _offset, DeviceSize _size);
 
 
 #pragma region Memory
@@ -54,25 +101,422 @@ namespace HAL::GPU::Vulkan
 
 #pragma endregion Memory
 
-	/**
-	Right now a new memory object is provided per allocation request.
-	*/
-	const Memory& RequestMemory(const Memory::AllocateInfo& _info)
+#pragma region MemoryAllocation
+
+	const Memory& MemoryAllocation::GetMemory() const
+	{
+		return Block->Object;
+	}
+
+	ptr<u8> MemoryAllocation::GetMapped() const
+	{
+		// A memory object can only be mapped once, so the whole block is mapped and shared by its allocations.
+		if (Block->Mapped == nullptr)
+		{
+			ptr<void> address = nullptr;
+
+			if (Block->Object.Map(0, Block->Object.GetSize(), Memory::MapFlags(), address) != EResult::Success)
+				throw RuntimeError("Failed to map device memory.");
+
+			Block->Mapped = address;
+		}
+
+		return RCast<u8>(Block->Mapped) + Offset;
+	}
+
+	void MemoryAllocation::WriteToGPU(DeviceSize _offset, DeviceSize _size, ptr<const void> _data) const
+	{
+		memcpy(GetMapped() + _offset, _data, _size);
+	}
+
+#pragma endregion MemoryAllocation
+
+	EResult AllocateMemory
+	(
+		const Memory::Requirements& _requirements,
+		Memory::PropertyFlags       _propertyFlags,
+		EResourceTiling             _tiling,
+		MemoryAllocation&           _allocation
+	)
+	{
+		u32 typeIndex = GPU_Comms::GetEngagedPhysicalGPU().FindMemoryType(_requirements.MemoryTypeBits, _propertyFlags);
+
+		return AllocateFromType(typeIndex, _requirements, _tiling, _allocation);
+	}
+
+	EResult AllocateDeviceHostMemory(const Memory::Requirements& _requirements, EResourceTiling _tiling, MemoryAllocation& _allocation)
+	{
+		u32 typeIndex = 0;
+
+		if (!Meta::GPU_UseDeviceHostMemory || !FindDeviceHostType(_requirements.MemoryTypeBits, typeIndex))
+			return EResult::Error_OutOfDeviceMemory;
+
+		return AllocateFromType(typeIndex, _requirements, _tiling, _allocation);
+	}
+
+	bool HasDeviceHostMemory()
+	{
+		u32 typeIndex = 0;
+
+		return Meta::GPU_UseDeviceHostMemory && FindDeviceHostType(UInt32Max, typeIndex);
+	}
+
+	void FreeMemory(MemoryAllocation& _allocation)
+	{
+		if (!_allocation.IsValid()) return;
+
+		MemoryBlock& block = *_allocation.Block;
+
+		_allocation.Block = nullptr;
+
+		if (block.Dedicated)
+		{
+			ReleaseBlock(getPtr(block));
+
+			return;
+		}
+
+		AddFreeRange(block, _allocation.Offset, _allocation.Size);
+
+		block.Allocated -= _allocation.Size;
+		block.Allocations--;
+
+		if (block.Allocations > 0) return;
+
+		// Keep one empty block of its kind around so a resource recreated every frame does not thrash.
+		for (auto& other : Blocks)
+		{
+			bool sameKind =
+				other.get()       != getPtr(block)    &&
+				!other->Dedicated                     &&
+				other->TypeIndex   == block.TypeIndex &&
+				other->Tiling      == block.Tiling;
+
+			if (sameKind && other->Allocations == 0)
+			{
+				ReleaseBlock(getPtr(block));
+
+				return;
+			}
+		}
+	}
+
+	MemoryStats GetMemoryStats()
 	{
-		Memories.resize(Memories.size() + 1);
+		MemoryStats stats;
+
+		for (auto& block : Blocks)
+		{
+			if (block->Dedicated) stats.Dedicated++;
+			else                  stats.Blocks   ++;
+
+			stats.Allocations    += block->Allocations;
+			stats.BytesReserved  += block->Object.GetSize();
+			stats.BytesAllocated += block->Allocated;
+		}
+
+		return stats;
+	}
 
-		auto& memory = Memories.back();
+	MemoryBlockUsage GetBlockUsage(ptr<const MemoryBlock> _block)
+	{
+		MemoryBlockUsage usage;
 
-		memory.Allocate(_info);
+		usage.Size        = _block->Object.GetSize();
+		usage.Allocated   = _block->Allocated       ;
+		usage.Allocations = _block->Allocations     ;
+		usage.Dedicated   = _block->Dedicated       ;
 
-		return memory;
+		return usage;
+	}
+
+	EResult AllocateForRelocation(const Memory::Requirements& _requirements, const MemoryAllocation& _source, MemoryAllocation& _destination)
+	{
+		const MemoryBlock& source = *_source.Block;
+
+		DynamicArray< ptr<MemoryBlock>> candidates;
+
+		for (auto& block : Blocks)
+		{
+			bool sameKind =
+				block.get()      != getPtr(source)    &&
+				!block->Dedicated                     &&
+				block->TypeIndex  == source.TypeIndex &&
+				block->Tiling     == source.Tiling;
+
+			// Moving into a sparser block would only shift the fragmentation there.
+			bool denser = block->Allocated >= source.Allocated;
+
+			if (sameKind && denser && (_requirements.MemoryTypeBits & (1u << block->TypeIndex))) candidates.push_back(block.get());
+		}
+
+		// Fullest first, so what is left sparse is what gets emptied next.
+		std::sort(candidates.begin(), candidates.end(), [](ptr<MemoryBlock> _a, ptr<MemoryBlock> _b)
+		{
+			return _a->Allocated > _b->Allocated;
+		});
+
+		DeviceSize alignment = std::max<DeviceSize>(_requirements.Alignment, 1);
+
+		for (auto candidate : candidates)
+		{
+			DeviceSize offset = 0;
+
+			if (SubAllocate(*candidate, _requirements.Size, alignment, offset))
+			{
+				_destination.Block  = candidate         ;
+				_destination.Offset = offset            ;
+				_destination.Size   = _requirements.Size;
+
+				return EResult::Success;
+			}
+		}
+
+		return EResult::Error_OutOfDeviceMemory;
 	}
 
 	void WipeMemory()
 	{
-		for (auto& memory : Memories)
+		for (auto& block : Blocks)
 		{
-			memory.Free();
+			if (block->Mapped != nullptr) block->Object.Unmap();
+
+			block->Object.Free();
+		}
+
+		Blocks.clear();
+
+		// The next device may differ.
+		PropertiesQueried = false;
+	}
+
+
+
+	// Private
+
+	EResult AllocateFromType(u32 _typeIndex, const Memory::Requirements& _requirements, EResourceTiling _tiling, MemoryAllocation& _allocation)
+	{
+		DeviceSize size      = _requirements.Size;
+		DeviceSize alignment = std::max<DeviceSize>(_requirements.Alignment, 1);
+
+		bool dedicated =
+			size > Meta::GPU_MemoryBlockSize / 2 ||
+			(_tiling == EResourceTiling::Optimal && size >= Meta::GPU_DedicatedImageSize);
+
+		ptr<MemoryBlock> block  = nullptr;
+		DeviceSize       offset = 0;
+		EResult          result = EResult::Success;
+
+		if (dedicated)
+		{
+			block = CreateBlock(_typeIndex, _tiling, size, true, result);
+		}
+		else
+		{
+			for (auto& candidate : Blocks)
+			{
+				if (candidate->Dedicated || candidate->TypeIndex != _typeIndex || candidate->Tiling != _tiling) continue;
+
+				if (SubAllocate(*candidate, size, alignment, offset))
+				{
+					block = candidate.get();
+
+					break;
+				}
+			}
+
+			if (block == nullptr)
+			{
+				const VkPhysicalDeviceMemoryProperties& properties = GetMemoryProperties();
+
+				DeviceSize heapSize = properties.memoryHeaps[properties.memoryTypes[_typeIndex].heapIndex].size;
+
+				// A block takes at most a quarter of a small heap, like the 256 MB host visible window of VRAM without resizable BAR.
+				DeviceSize firstBlock = std::min<DeviceSize>(Meta::GPU_MemoryBlockSize, std::max<DeviceSize>(heapSize / 4, Meta::GPU_MemoryBlockSize / 8));
+
+				// Heaps smaller than a block (or nearly full) still get the largest block they can back.
+				for (DeviceSize blockSize = firstBlock; block == nullptr; blockSize /= 2)
+				{
+					if (blockSize < size || blockSize < Meta::GPU_MemoryBlockSize / 8)
+					{
+						// Last resort, a memory object of its own.
+						block = CreateBlock(_typeIndex, _tiling, size, true, result);
+
+						break;
+					}
+
+					block = CreateBlock(_typeIndex, _tiling, blockSize, false, result);
+				}
+
+				if (block != nullptr && !block->Dedicated) SubAllocate(*block, size, alignment, offset);
+			}
+		}
+
+		if (block == nullptr) return result;
+
+		if (block->Dedicated)
+		{
+			block->Allocated   = size;
+			block->Allocations = 1;
+		}
+
+		_allocation.Block  = block ;
+		_allocation.Offset = offset;
+		_allocation.Size   = size  ;
+
+		return EResult::Success;
+	}
+
+	const VkPhysicalDeviceMemoryProperties& GetMemoryProperties()
+	{
+		if (!PropertiesQueried)
+		{
+			// The heap sizes are not exposed by the wrapper.
+			PhysicalDevice::Handle gpu = GPU_Comms::GetEngagedPhysicalGPU();
+
+			vkGetPhysicalDeviceMemoryProperties(gpu, &MemoryProperties);
+
+			PropertiesQueried = true;
+		}
+
+		return MemoryProperties;
+	}
+
+	bool FindDeviceHostType(u32 _typeBits, u32& _typeIndex)
+	{
+		const VkPhysicalDeviceMemoryProperties& properties = GetMemoryProperties();
+
+		for (u32 index = 0; index < properties.memoryTypeCount; index++)
+		{
+			if ((_typeBits & (1u << index)) == 0) continue;
+
+			if ((properties.memoryTypes[index].propertyFlags & DeviceHostFlags) == DeviceHostFlags)
+			{
+				_typeIndex = index;
+
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	ptr<MemoryBlock> CreateBlock(u32 _typeIndex, EResourceTiling _tiling, DeviceSize _size, bool _dedicated, EResult& _result)
+	{
+		UPtr<MemoryBlock> block = MakeUPtr<MemoryBlock>();
+
+		block->TypeIndex = _typeIndex;
+		block->Tiling    = _tiling   ;
+		block->Dedicated = _dedicated;
+
+		Memory::AllocateInfo info;
+
+		info.AllocationSize  = _size     ;
+		info.MemoryTypeIndex = _typeIndex;
+
+		_result = block->Object.Allocate(GPU_Comms::GetEngagedDevice(), info);
+
+		if (_result != EResult::Success) return nullptr;
+
+		if (!_dedicated) AddFreeRange(*block, 0, _size);
+
+		Blocks.push_back(move(block));
+
+		return Blocks.back().get();
+	}
+
+	void ReleaseBlock(ptr<MemoryBlock> _block)
+	{
+		for (auto entry = Blocks.begin(); entry != Blocks.end(); entry++)
+		{
+			if (entry->get() != _block) continue;
+
+			if (_block->Mapped != nullptr) _block->Object.Unmap();
+
+			_block->Object.Free();
+
+			Blocks.erase(entry);
+
+			return;
+		}
+	}
+
+	bool SubAllocate(MemoryBlock& _block, DeviceSize _size, DeviceSize _alignment, DeviceSize& _offset)
+	{
+		// Smallest range that fits once aligned.
+		for (auto range = _block.FreeBySize.lower_bound(_size); range != _block.FreeBySize.end(); range++)
+		{
+			DeviceSize rangeOffset = range->second;
+			DeviceSize rangeSize   = range->first ;
+
+			DeviceSize aligned = (rangeOffset + _alignment - 1) / _alignment * _alignment;
+
+			if (aligned + _size > rangeOffset + rangeSize) continue;
+
+			RemoveFreeRange(_block, rangeOffset, rangeSize);
+
+			// The padding and the tail stay free, they coalesce back when the allocation is freed.
+			if (aligned > rangeOffset) AddFreeRange(_block, rangeOffset, aligned - rangeOffset);
+
+			DeviceSize end = aligned + _size;
+
+			if (end < rangeOffset + rangeSize) AddFreeRange(_block, end, rangeOffset + rangeSize - end);
+
+			_block.Allocated += _size;
+			_block.Allocations++;
+
+			_offset = aligned;
+
+			return true;
+		}
+
+		return false;
+	}
+
+	void AddFreeRange(MemoryBlock& _block, DeviceSize _offset, DeviceSize _size)
+	{
+		auto next = _block.FreeByOffset.lower_bound(_offset);
+
+		if (next != _block.FreeByOffset.begin())
+		{
+			auto previous = std::prev(next);
+
+			if (previous->first + previous->second == _offset)
+			{
+				_offset = previous->first;
+				_size  += previous->second;
+
+				RemoveFreeRange(_block, previous->first, previous->second);
+			}
+		}
+
+		next = _block.FreeByOffset.lower_bound(_offset);
+
+		if (next != _block.FreeByOffset.end() && _offset + _size == next->first)
+		{
+			_size += next->second;
+
+			RemoveFreeRange(_block, next->first, next->second);
+		}
+
+		_block.FreeByOffset.emplace(_offset, _size  );
+		_block.FreeBySize  .emplace(_size  , _offset);
+	}
+
+	void RemoveFreeRange(MemoryBlock& _block, DeviceSize _offset, DeviceSize _size)
+	{
+		_block.FreeByOffset.erase(_offset);
+
+		auto sized = _block.FreeBySize.equal_range(_size);
+
+		for (auto range = sized.first; range != sized.second; range++)
+		{
+			if (range->second == _offset)
+			{
+				_block.FreeBySize.erase(range);
+
+				return;
+			}
 		}
 	}
-}
\ No newline at end of file
+}
@@ -26,6 +26,10 @@ namespace HAL::GPU::Vulkan
 
 		void Free();
 
+		DeviceSize GetSize() const { return info.AllocationSize; }
+
+		u32 GetTypeIndex() const { return info.MemoryTypeIndex; }
+
 	protected:
 
 		// KeyValue Pair<void*, DeviceSize> size.
@@ -33,7 +37,107 @@ namespace HAL::GPU::Vulkan
 		AllocateInfo info;
 	};
 
-	const Memory& RequestMemory(const Memory::AllocateInfo& _info);
+	/*
+	How a resource lays out its memory.
+
+	Linear (buffers) and optimal (images) resources are never placed in the same block,
+	so bufferImageGranularity never has to be padded for within a block.
+	*/
+	enum class EResourceTiling
+	{
+		Linear ,
+		Optimal
+	};
+
+	struct MemoryBlock;
+
+	/*
+	A range of a memory block. Resources bind to GetMemory() at Offset.
+	*/
+	struct MemoryAllocation
+	{
+		ptr<MemoryBlock> Block  = nullptr;
+		DeviceSize       Offset = 0;
+		DeviceSize       Size   = 0;
+
+		bool IsValid() const { return Block != nullptr; }
+
+		const Memory& GetMemory() const;
+
+		/*
+		Host address of the allocation, the memory must be host visible.
+		Blocks are mapped once on first use and stay mapped until released.
+		*/
+		ptr<u8> GetMapped() const;
+
+		/*
+		Writes into the allocation's range, the memory must be host visible and coherent.
+		*/
+		void WriteToGPU(DeviceSize _offset, DeviceSize _size, ptr<const void> _data) const;
+	};
+
+	/*
+	Sub-allocates from large blocks per memory type instead of creating a memory object per resource.
+
+	Blocks are Meta::GPU_MemoryBlockSize, images of Meta::GPU_DedicatedImageSize or more (and anything larger than a block)
+	get a dedicated memory object. Freed ranges are coalesced with their neighbours, a block left empty is released
+	unless it is the last one of its kind.
+
+	Not thread safe: GPU resources are created and destroyed on the rendering thread.
+	*/
+	EResult AllocateMemory
+	(
+		const Memory::Requirements& _requirements,
+		Memory::PropertyFlags       _propertyFlags,
+		EResourceTiling             _tiling,
+		MemoryAllocation&           _allocation
+	);
+
+	/*
+	Allocates from memory both device local and host visible (and coherent), so the host writes where
+	the device reads without a staging copy. The allocation is mapped on first use like any host visible one.
+
+	Fails when the device has no such memory for the resource, or Meta::GPU_UseDeviceHostMemory is off:
+	the caller falls back to staging into device local memory, or to plain host visible memory.
+	*/
+	EResult AllocateDeviceHostMemory(const Memory::Requirements& _requirements, EResourceTiling _tiling, MemoryAllocation& _allocation);
+
+	/*
+	The device has memory both device local and host visible.
+	*/
+	bool HasDeviceHostMemory();
+
+	void FreeMemory(MemoryAllocation& _allocation);
+
+	struct MemoryStats
+	{
+		uDM        Blocks         = 0;
+		uDM        Dedicated      = 0;
+		uDM        Allocations    = 0;
+		DeviceSize BytesReserved  = 0;   // Held in memory objects.
+		DeviceSize BytesAllocated = 0;   // Handed out to resources.
+	};
+
+	MemoryStats GetMemoryStats();
+
+	struct MemoryBlockUsage
+	{
+		DeviceSize Size        = 0;
+		DeviceSize Allocated   = 0;
+		uDM        Allocations = 0;
+		bool       Dedicated   = false;
+	};
+
+	MemoryBlockUsage GetBlockUsage(ptr<const MemoryBlock> _block);
+
+	/*
+	Allocates room for a resource moved out of _source's block, in another block of its kind at least as full.
+	Never creates a block: fails when the others cannot take it, moving would free nothing.
+	*/
+	EResult AllocateForRelocation(const Memory::Requirements& _requirements, const MemoryAllocation& _source, MemoryAllocation& _destination);
 
+	/*
+	Frees every memory object. Only valid once the resources bound to them are destroyed.
+	*/
 	void WipeMemory();
 }
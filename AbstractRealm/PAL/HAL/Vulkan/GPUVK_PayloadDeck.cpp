@@ -131,6 +131,11 @@ namespace HAL::GPU::Vulkan
 	}
 
 	ptr<CommandPool> Deck_Maker<Meta::EGPU_Engage::Single>::RequestCommandPools(uDM _numDesired)
+	{
+		return RequestCommandPools(_numDesired, EQueueFlag::Graphics);
+	}
+
+	ptr<CommandPool> Deck_Maker<Meta::EGPU_Engage::Single>::RequestCommandPools(uDM _numDesired, EQueueFlag _queue)
 	{
 		uDM firstOfNewPools = CommandPools.size();
 
@@ -138,13 +143,16 @@ namespace HAL::GPU::Vulkan
 
 		CommandPool::CreateInfo info;
 
-		info.QueueFamilyIndex = GPU_Comms::GetGraphicsQueue().GetFamilyIndex();
+		info.QueueFamilyIndex = GPU_Comms::GetEngagedDevice().GetQueue(_queue).GetFamilyIndex();
 
-		EResult result = CommandPools.back().Create(GPU_Comms::GetEngagedDevice(), info);
-
-		if (result != EResult::Success)
+		for (uDM index = firstOfNewPools; index < CommandPools.size(); index++)
 		{
-			throw RuntimeError("Failed to create requested command pool.");
+			EResult result = CommandPools[index].Create(GPU_Comms::GetEngagedDevice(), info);
+
+			if (result != EResult::Success)
+			{
+				throw RuntimeError("Failed to create requested command pool.");
+			}
 		}
 
 		return &CommandPools[firstOfNewPools];
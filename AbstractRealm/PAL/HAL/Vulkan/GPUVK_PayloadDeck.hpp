@@ -61,6 +61,11 @@ namespace HAL::GPU::Vulkan
 
 		unbound ptr<CommandPool> RequestCommandPools(uDM _numDesired);
 
+		/*
+		Pools for the family of the given queue, their buffers can only be submitted to it.
+		*/
+		unbound ptr<CommandPool> RequestCommandPools(uDM _numDesired, EQueueFlag _queue);
+
 		unbound const CommandBuffer& RecordOnGraphics();
 
 		unbound const CommandBuffer& RecordOnTransient();
@@ -3,6 +3,10 @@
 
 
 
+#include "GPUVK_Bindless.hpp"
+
+
+
 
 
 
@@ -175,40 +179,39 @@ namespace HAL::GPU::Vulkan
 		//Layout::CreateInfo layoutInfo;
 
 		//layoutInfo.SetLayoutCount = RCast<ui32>(_descriptorSetLayouts.size());  // hardcoded for now.
+		setLayouts[0] = *_descriptorSetLayout;
+
 		layoutInfo.SetLayoutCount         = 1;  
-		layoutInfo.SetLayouts             = *_descriptorSetLayout;
+		layoutInfo.SetLayouts             = setLayouts.data();
 		layoutInfo.PushConstantRangeCount = 0;
 		layoutInfo.PushConstantRanges     = nullptr;
 
+		// The descriptor arrays follow the renderable's set, draws select from them with push constants.
+		if (Bindless::IsEnabled())
+		{
+			setLayouts[Bindless_Set] = Bindless::GetLayout();
+
+			layoutInfo.SetLayoutCount         = 2;
+			layoutInfo.PushConstantRangeCount = 1;
+			layoutInfo.PushConstantRanges     = &Bindless::GetPushConstantRange();
+		}
+
 
 		if (layout.Create(GPU_Comms::GetEngagedDevice(), layoutInfo) != EResult::Success)
 		{
 			throw RuntimeError("Could not create pipeline layout.");
 		}
 
+		info.RenderPass = _renderPass;
 
+		Build(_shader);
+	}
 
-		info.StageCount         = _shader->GetShaderStageInfos().size();   // BasicSahder only has 2 shader stages.
-		info.Stages             = _shader->GetShaderStageInfos().data();
-		info.VertexInputState   = getPtr(vertexInputStateInfo);
-		info.InputAssemblyState = getPtr(inputAssemblyStateInfo);
-		info.TessellationState  = nullptr;   // None for now...
-		info.ViewportState      = getPtr(viewportStateInfo);
-		info.MultisampleState   = getPtr(multisampleStateInfo);
-		info.DepthStencilState  = getPtr(depthStencilStateInfo);
-		info.ColorBlendState    = getPtr(colorBlendStateInfo);
-		info.RasterizationState = getPtr(rasterizationStateInfo);
-		info.DynamicState       = getPtr(dynamicStateInfo);
-		info.Layout             = layout;
-		info.RenderPass         = _renderPass;
-		info.Subpass            = 0;   // Why?
-		info.BasePipelineHandle = Null<Handle>;
-		info.BasePipelineIndex  = -1;
+	void GraphicsPipeline::Rebuild(ptr<const AShader> _shader)
+	{
+		Parent::Destroy();
 
-		if (Parent::Create(GPU_Comms::GetEngagedDevice(), GPU_Pipeline::Request_Cache(), info) != EResult::Success)
-		{
-			throw RuntimeError("Could not create graphics pipeline.");
-		}
+		Build(_shader);
 	}
 
 	ptr<const GraphicsPipeline::ShaderStage::CreateInfo> GraphicsPipeline::GetShaderStages() const
@@ -231,6 +234,35 @@ namespace HAL::GPU::Vulkan
 		return layoutInfo.SetLayouts;
 	}*/
 
+	// Protected
+
+	void GraphicsPipeline::Build(ptr<const AShader> _shader)
+	{
+		// Pointed at again on every build, the pipeline may have been moved since it was created.
+		colorBlendStateInfo.Attachments = getPtr(colorBlendAttachmentState);
+
+		info.StageCount         = _shader->GetShaderStageInfos().size();   // BasicSahder only has 2 shader stages.
+		info.Stages             = _shader->GetShaderStageInfos().data();
+		info.VertexInputState   = getPtr(vertexInputStateInfo);
+		info.InputAssemblyState = getPtr(inputAssemblyStateInfo);
+		info.TessellationState  = nullptr;   // None for now...
+		info.ViewportState      = getPtr(viewportStateInfo);
+		info.MultisampleState   = getPtr(multisampleStateInfo);
+		info.DepthStencilState  = getPtr(depthStencilStateInfo);
+		info.ColorBlendState    = getPtr(colorBlendStateInfo);
+		info.RasterizationState = getPtr(rasterizationStateInfo);
+		info.DynamicState       = getPtr(dynamicStateInfo);
+		info.Layout             = layout;
+		info.Subpass            = 0;   // Why?
+		info.BasePipelineHandle = Null<Handle>;
+		info.BasePipelineIndex  = -1;
+
+		if (Parent::Create(GPU_Comms::GetEngagedDevice(), GPU_Pipeline::Request_Cache(), info) != EResult::Success)
+		{
+			throw RuntimeError("Could not create graphics pipeline.");
+		}
+	}
+
 #pragma endregion GraphicsPipeline
 
 #pragma region GPU_Pipeline
@@ -42,6 +42,12 @@ namespace HAL::GPU::Vulkan
 			      Bool                                _enableDepthClamp
 		);
 
+		/*
+		Recreates the pipeline with the current modules of _shader, after they were recompiled.
+		The pipeline must not be in use by the device.
+		*/
+		void Rebuild(ptr<const AShader> _shader);
+
 		ptr<const ShaderStage::CreateInfo> GetShaderStages() const;
 
 		const VertexInputState::CreateInfo& GetVertexInputState() const;
@@ -52,6 +58,8 @@ namespace HAL::GPU::Vulkan
 
 	protected:
 
+		void Build(ptr<const AShader> _shader);
+
 		VertexInputState  ::CreateInfo      vertexInputStateInfo;
 		InputAssemblyState::CreateInfo      inputAssemblyStateInfo;
 		ViewportState     ::CreateInfo      viewportStateInfo;
@@ -64,6 +72,8 @@ namespace HAL::GPU::Vulkan
 		DynamicState      ::CreateInfo      dynamicStateInfo;
 		Layout            ::CreateInfo      layoutInfo;
 
+		StaticArray<DescriptorSetLayout::Handle, 2> setLayouts;   // The renderable's, then the bindless arrays when enabled.
+
 		CreateInfo info;   // Should this be kept?
 
 		DescriptorSetLayout descriptorSetLayout;
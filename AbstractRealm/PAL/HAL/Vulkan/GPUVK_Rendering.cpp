@@ -1,6 +1,11 @@
 // Parent Header
 #include "GPUVK_Rendering.hpp"
 #include "Meta/EngineInfo.hpp"
+#include "GPUVK_Staging.hpp"
+#include "GPUVK_Bindless.hpp"
+#include "GPUVK_Defragmenter.hpp"
+
+#include <algorithm>
 
 
 
@@ -567,21 +572,14 @@ namespace HAL::GPU::Vulkan
 
 		if (result != EResult::Success) return result;
 
-		maxFramesInFlight = SCast<u32>(frameBuffers.size() - 1);
-
-		frameRefs.resize(maxFramesInFlight);
+		result = ResizeFramesInFlight(SCast<u32>(frameBuffers.size() - 1));
 
-		for (uDM index = 0; index < frameRefs.size(); index++)
-		{
-			frameRefs[index].Prepare();
-		}
+		if (result != EResult::Success) return result;
 
 		Semaphore::CreateInfo semaphoreInfo;
 
 		presentSubmitStatus.Create(GPU_Comms::GetEngagedDevice(), semaphoreInfo);
 
-		swapsInFlight.resize(frameBuffers.size());	
-
 		Fence::CreateInfo fenceInfo; fenceInfo.Flags.Set(EFenceCreateFlag::Signaled);
 
 		// Will always have at least one view context.
@@ -614,23 +612,14 @@ namespace HAL::GPU::Vulkan
 
 	void RenderContext::Destroy()
 	{
-		for (auto& frameBuffer : frameBuffers)
-		{
-			frameBuffer.Destroy();
-		}
-
-		renderPass.Destroy();
-
-		depthBuffer.image.Destroy();
-
-		depthBuffer.memory.Free();
+		DestroySurfaceResources();
 
-		depthBuffer.view.Destroy();
+		uniforms.Destroy();
 	}
 
 	void RenderContext::AddRenderable(ptr<ARenderable> _renderable)
 	{
-		_renderable->CreateDescriptorSets(swapchain->GetImages().size(), descriptorPool);
+		_renderable->CreateDescriptorSets(descriptorPool, uniforms);
 
 		if (renderGroups.empty())
 		{
@@ -677,6 +666,23 @@ namespace HAL::GPU::Vulkan
 		renderCallbacks.push_back(_callback);
 	}
 
+	void RenderContext::RebuildPipelines(const AShader& _shader)
+	{
+		for (auto& graphicsPipeline : graphicsPipelines)
+		{
+			// Matched the same way Request_GraphicsPipeline does, by the address of the stages.
+			if (graphicsPipeline.GetShaderStages() == _shader.GetShaderStageInfos().data())
+			{
+				graphicsPipeline.Rebuild(getPtr(_shader));
+			}
+		}
+	}
+
+	u32 RenderContext::GetFramesInFlight() const
+	{
+		return maxFramesInFlight;
+	}
+
 	const RenderPass& RenderContext::GetRenderPass() const
 	{
 		return renderPass;
@@ -689,6 +695,9 @@ namespace HAL::GPU::Vulkan
 		// Make sure next frame to process has been processed by the GPU.
 		frameRef.RenderingInFlight().WaitFor(UInt64Max);
 
+		// Its uniforms were read by that submission, they can be written over now.
+		uniforms.BeginFrame(currentFrameBuffer);
+
 		// Get the next available image from the swapchain to render to.
 		EResult result = swapchain->AcquireNextImage
 		(
@@ -757,13 +766,17 @@ namespace HAL::GPU::Vulkan
 
 			viewContexts[0].Prepare(primaryBuffer);
 
-			primaryBuffer.BindPipeline(EPipelineBindPoint::Graphics, dref(renderGroups[0].Pipeline));
+			// Nothing may have been added yet, renderables stream in.
+			if (!renderGroups.empty()) primaryBuffer.BindPipeline(EPipelineBindPoint::Graphics, dref(renderGroups[0].Pipeline));
 
 			for (auto renderCallback : renderCallbacks)
 			{
 				renderCallback(primaryBuffer, currentSwap);
 			}
 
+			// Vertex and index bindings are kept across pipelines, a pool is only bound when the next renderable needs another.
+			u32 boundGeometry = Geometry_NoPool;
+
 			for (auto& viewContext : viewContexts)
 			{
 				viewContext.Prepare(primaryBuffer);
@@ -772,9 +785,19 @@ namespace HAL::GPU::Vulkan
 				{
 					primaryBuffer.BindPipeline(EPipelineBindPoint::Graphics, dref(renderGroup.Pipeline));
 
+					if (Bindless::IsEnabled()) Bindless::Bind(primaryBuffer, renderGroup.Pipeline->GetLayout());
+
 					for (auto& renderable : renderGroup.Renderables)
 					{
-						renderable->RecordRender(currentFrameBuffer, primaryBuffer, renderGroup.Pipeline->GetLayout());
+						if (renderable->GetGeometryPool() != boundGeometry)
+						{
+							boundGeometry = renderable->GetGeometryPool();
+
+							// Renderables outside the pools bind their own buffers, the next pooled one binds again.
+							if (boundGeometry != Geometry_NoPool) Geometry::Bind(primaryBuffer, boundGeometry);
+						}
+
+						renderable->RecordRender(uniforms, primaryBuffer, renderGroup.Pipeline->GetLayout());
 					}
 				}
 			}
@@ -877,7 +900,7 @@ namespace HAL::GPU::Vulkan
 		// Make sure swapchain is ok first...
 		if (swapchain->QuerySurfaceChanges())
 		{
-			Destroy();
+			DestroySurfaceResources();
 
 			EResult result = CreateDepthBuffer();
 
@@ -891,10 +914,68 @@ namespace HAL::GPU::Vulkan
 
 			if (result != EResult::Success) throw RuntimeError("Failed to recreate frame renderer in context.");
 
+			// The regenerated swapchain may have another number of images. Waited on by the surface query, nothing is in flight.
+			result = ResizeFramesInFlight(SCast<u32>(frameBuffers.size() - 1));
+
+			if (result != EResult::Success) throw RuntimeError("Failed to resize the frames in flight of context.");
+
 			// Adjust view contexts to the new relative size of the swapchain.
 		}
 	}
 
+	EResult RenderContext::ResizeFramesInFlight(u32 _frames)
+	{
+		// The previous images are gone, none is being presented.
+		swapsInFlight.assign(frameBuffers.size(), nullptr);
+
+		currentFrameBuffer = 0;
+
+		if (_frames == maxFramesInFlight) return EResult::Success;
+
+		// Only grown: the surplus references of a shrink are left prepared but unused.
+		for (uDM index = frameRefs.size(); index < _frames; index++)
+		{
+			frameRefs.emplace_back();
+
+			frameRefs.back().Prepare();
+		}
+
+		maxFramesInFlight = _frames;
+
+		uniforms.Destroy();
+
+		EResult result = uniforms.Create(maxFramesInFlight, Meta::GPU_UniformArenaSize);
+
+		if (result != EResult::Success) return result;
+
+		// Their sets referenced the previous arena.
+		for (auto& renderGroup : renderGroups)
+		{
+			for (auto renderable : renderGroup.Renderables)
+			{
+				renderable->RebindUniforms(uniforms);
+			}
+		}
+
+		return result;
+	}
+
+	void RenderContext::DestroySurfaceResources()
+	{
+		for (auto& frameBuffer : frameBuffers)
+		{
+			frameBuffer.Destroy();
+		}
+
+		renderPass.Destroy();
+
+		depthBuffer.image.Destroy();
+
+		FreeMemory(depthBuffer.memory);
+
+		depthBuffer.view.Destroy();
+	}
+
 	EResult RenderContext::CreateDepthBuffer()
 	{
 		Image::CreateInfo imgInfo;
@@ -928,19 +1009,17 @@ namespace HAL::GPU::Vulkan
 
 		EResult result = depthBuffer.image.Create(GPU_Comms::GetEngagedDevice(), imgInfo);
 
-		auto& memReq = depthBuffer.image.GetMemoryRequirements();
-
-		Memory::AllocateInfo allocInfo;
-
-		allocInfo.AllocationSize = memReq.Size;
-
-		allocInfo.MemoryTypeIndex = 
-			GPU_Comms::GetEngagedDevice().GetPhysicalDevice().FindMemoryType
-			(memReq.MemoryTypeBits, Memory::PropertyFlags(EMemoryPropertyFlag::DeviceLocal));
+		result = AllocateMemory
+		(
+			depthBuffer.image.GetMemoryRequirements(),
+			Memory::PropertyFlags(EMemoryPropertyFlag::DeviceLocal),
+			EResourceTiling::Optimal,
+			depthBuffer.memory
+		);
 
-		result = depthBuffer.memory.Allocate(GPU_Comms::GetEngagedDevice(), allocInfo);
+		if (result != EResult::Success) return result;
 
-		result = depthBuffer.image.BindMemory(depthBuffer.memory, depthBuffer.memoryOffset);
+		result = depthBuffer.image.BindMemory(depthBuffer.memory.GetMemory(), depthBuffer.memory.Offset);
 
 		if (result != EResult::Success) return result;
 
@@ -964,7 +1043,8 @@ namespace HAL::GPU::Vulkan
 
 		result = depthBuffer.view.Create(GPU_Comms::GetEngagedDevice(), viewInfo);
 
-		depthBuffer.image.TransitionLayout(EImageLayout::Undefined, EImageLayout::DepthStencil_AttachmentOptimal);
+		// Recorded with the uploads, submitted ahead of the next frame.
+		depthBuffer.image.TransitionLayout(Staging::RecordAfterUpload(), EImageLayout::Undefined, EImageLayout::DepthStencil_AttachmentOptimal);
 
 		return result;
 	}
@@ -1149,7 +1229,7 @@ namespace HAL::GPU::Vulkan
 
 		StaticArray<V3::DescriptorPool::Size, 2> poolSizes{};
 
-		poolSizes[0].Type = EDescriptorType::UniformBuffer;
+		poolSizes[0].Type = EDescriptorType::UniformBufferDynamic;
 		poolSizes[0].Count = SCast<u32>(swapchain->GetImages().size());
 
 		poolSizes[1].Type = EDescriptorType::Sampler;
@@ -1283,6 +1363,8 @@ namespace HAL::GPU::Vulkan
 
 	Deque<RenderContext> RenderContexts;
 
+	sInternal u32 Frame = 0;
+
 
 
 	void Rendering_Maker<Meta::EGPU_Engage::Single>::SetSubmissionMode(ESubmissionType _submissionBehaviorDesired)
@@ -1290,6 +1372,16 @@ namespace HAL::GPU::Vulkan
 		SubmissionMode = _submissionBehaviorDesired;
 	}
 
+	void Rendering_Maker<Meta::EGPU_Engage::Single>::Rebuild_Pipelines(const AShader& _shader)
+	{
+		GPU_Comms::GetEngagedDevice().WaitUntilIdle();
+
+		for (auto& renderContext : RenderContexts)
+		{
+			renderContext.RebuildPipelines(_shader);
+		}
+	}
+
 	void Rendering_Maker<Meta::EGPU_Engage::Single>::Shutdown()
 	{
 		for (auto& swapchain : SwapChains)
@@ -1380,10 +1472,46 @@ namespace HAL::GPU::Vulkan
 
 	void Rendering_Maker<Meta::EGPU_Engage::Single>::Update()
 	{
+		// Submitted ahead of the frames on the same queue, so this frame sees everything uploaded during the last one.
+		Staging::Submit();
+
+		// Its copies are ordered after the uploads and before the frames.
+		Defragmenter::Update();
+
 		for (auto& renderContext : RenderContexts)
 		{
 			renderContext.ProcessNextFrame();
 		}
+
+		Bindless::EndFrame();
+
+		Geometry::EndFrame();
+
+		Frame++;
+	}
+
+	u32 Rendering_Maker<Meta::EGPU_Engage::Single>::GetFramesInFlight()
+	{
+		u32 framesInFlight = 0;
+
+		for (auto& renderContext : RenderContexts)
+		{
+			framesInFlight = std::max(framesInFlight, renderContext.GetFramesInFlight());
+		}
+
+		return framesInFlight;
+	}
+
+	u32 Rendering_Maker<Meta::EGPU_Engage::Single>::GetFramesBeforeReuse()
+	{
+		// A frame's fence is waited on when its slot comes around again, frames in flight updates later.
+		// One more covers what was released after the last frame referencing it was recorded, but before its update ended.
+		return GetFramesInFlight() + 1;
+	}
+
+	u32 Rendering_Maker<Meta::EGPU_Engage::Single>::GetFrame()
+	{
+		return Frame;
 	}
 
 	void Rendering_Maker<Meta::EGPU_Engage::Single>::Present()
@@ -236,8 +236,15 @@ namespace HAL::GPU::Vulkan
 
 		void AddRenderCallback(RenderCallback _callback);
 
+		/*
+		Recreates the pipelines built from _shader with its current modules. The device must be idle.
+		*/
+		void RebuildPipelines(const AShader& _shader);
+
 		const RenderPass& GetRenderPass() const;
 
+		u32 GetFramesInFlight() const;
+
 		void ProcessNextFrame();
 
 		void SubmitFrameToPresentation();
@@ -256,6 +263,14 @@ namespace HAL::GPU::Vulkan
 
 		void CheckContext();
 
+		// What is recreated when the surface changes.
+		void DestroySurfaceResources();
+
+		/*
+		Sizes the frame references and the uniform arena for _frames in flight. The queue must be idle.
+		*/
+		EResult ResizeFramesInFlight(u32 _frames);
+
 		GraphicsPipeline& Request_GraphicsPipeline(ptr<ARenderable> _renderable);
 
 		ptr<Swapchain> swapchain;
@@ -265,7 +280,7 @@ namespace HAL::GPU::Vulkan
 		ui32 currentFrameBuffer = 0 ,    // Current frame to process
 			 previousFrame    ,    // Previously processed frame
 			 currentSwap      ,    // Currently rendered frame to present.
-			 maxFramesInFlight ;   // Maximum number of frames to process at the same time.
+			 maxFramesInFlight = 0;   // Maximum number of frames to process at the same time.
 
 		DynamicArray<Framebuffer> frameBuffers;   // TODO: use frame reference?
 
@@ -314,6 +329,8 @@ namespace HAL::GPU::Vulkan
 
 		//DynamicArray<DescriptorPool> descriptorPool;
 
+		UniformArena uniforms;   // Region per frame in flight.
+
 		DynamicArray<DescriptorSet> descriptorSets;
 	};
 
@@ -377,10 +394,31 @@ namespace HAL::GPU::Vulkan
 
 		unbound void SetSubmissionMode(ESubmissionType _submissionBehaviorDesired);
 
+		/*
+		Waits for the device to be idle, then rebuilds the pipelines of every render context using _shader.
+		*/
+		unbound void Rebuild_Pipelines(const AShader& _shader);
+
 		unbound void Initalize();
 		unbound void Shutdown();
 		unbound void Present();
 		unbound void Update();
+
+		/*
+		The most frames in flight of the render contexts, 0 without any.
+		*/
+		unbound u32 GetFramesInFlight();
+
+		/*
+		Updates a resource released or rewritten during a frame is held for: once they passed, every frame
+		that may have referenced it is done. Shared by everything that defers reuse behind the frames in flight.
+		*/
+		unbound u32 GetFramesBeforeReuse();
+
+		/*
+		Updates so far. Between two updates, the frame that the next one records.
+		*/
+		unbound u32 GetFrame();
 	};
 
 	using Rendering = Rendering_Maker<Meta::GPU_Engagement>;
@@ -3,8 +3,15 @@
 
 
 
+#include "GPUVK_Barriers.hpp"
+#include "GPUVK_Defragmenter.hpp"
 #include "GPUVK_PayloadDeck.hpp"
 #include "GPUVK_Memory.hpp"
+#include "GPUVK_Rendering.hpp"
+#include "GPUVK_Staging.hpp"
+
+#include <algorithm>
+#include <cstring>
 
 
 
@@ -75,8 +82,24 @@ namespace HAL::GPU::Vulkan
 
 	void Image::TransitionLayout(EImageLayout _old, EImageLayout _new)
 	{
-		auto commandBuffer = Deck::RecordOnTransient();
+		auto& commandBuffer = Deck::RecordOnTransient();
 
+		TransitionLayout(commandBuffer, _old, _new);
+
+		Deck::EndRecordOnTransient(commandBuffer);
+	}
+
+	void Image::TransitionLayout(const CommandBuffer& _commandBuffer, EImageLayout _old, EImageLayout _new)
+	{
+		BarrierBatch barriers;
+
+		TransitionLayout(barriers, _old, _new);
+
+		barriers.Flush(_commandBuffer);
+	}
+
+	void Image::TransitionLayout(BarrierBatch& _barriers, EImageLayout _old, EImageLayout _new)
+	{
 		Image::Memory_Barrier barrier {};
 
 		barrier.OldLayout = _old;
@@ -142,14 +165,7 @@ namespace HAL::GPU::Vulkan
 			throw std::invalid_argument("unsupported layout transition!");
 		}
 
-		commandBuffer.SubmitPipelineBarrier
-		(
-			sourceStage, destinationStage,   // TODO
-			0, 
-			1, &barrier
-		);
-
-		Deck::EndRecordOnTransient(commandBuffer);
+		_barriers.Add(barrier, sourceStage, destinationStage);
 	}
 
 
@@ -180,14 +196,10 @@ namespace HAL::GPU::Vulkan
 
 #pragma region BufferPackage
 
-	BufferPackage::BufferPackage() : buffer(), memory(), memoryOffset(0), view()
+	BufferPackage::BufferPackage() : buffer(), memory(), view()
 	{}
 
-	BufferPackage::BufferPackage(const LogicalDevice& _device) : buffer(_device), memory(nullptr), memoryOffset(0), view(_device)
-	{}
-
-	BufferPackage::BufferPackage(const LogicalDevice& _device, const Memory& _memory) : 
-		buffer(_device), memory(&_memory), memoryOffset(0), view(_device)
+	BufferPackage::BufferPackage(const LogicalDevice& _device) : buffer(_device), memory(), view(_device)
 	{}
 
 	BufferPackage::~BufferPackage()
@@ -202,18 +214,12 @@ namespace HAL::GPU::Vulkan
 		if (returnCode != EResult::Success)
 			throw RuntimeError("Failed to initialize buffer package.");
 
-		Memory::AllocateInfo allocInfo;
-
-		auto& memReq = buffer.GetMemoryRequirements();
-
-		allocInfo.AllocationSize = memReq.Size;
+		returnCode = AllocateMemory(buffer.GetMemoryRequirements(), _memoryFlags, EResourceTiling::Linear, memory);
 
-		allocInfo.MemoryTypeIndex = 
-			buffer.GetDevice().GetPhysicalDevice().FindMemoryType(memReq.MemoryTypeBits, _memoryFlags);
-
-		memory = &RequestMemory(allocInfo);
+		if (returnCode != EResult::Success)
+			throw RuntimeError("Failed to allocate buffer package memory.");
 
-		buffer.BindMemory(*memory, memoryOffset);
+		buffer.BindMemory(memory.GetMemory(), memory.Offset);
 	}
 
 	void BufferPackage::Destroy()
@@ -221,9 +227,7 @@ namespace HAL::GPU::Vulkan
 		buffer.Destroy();
 		view  .Destroy();
 
-		memory = nullptr;
-
-		memoryOffset = 0;
+		FreeMemory(memory);
 	}
 
 	const Buffer& BufferPackage::GetBuffer()
@@ -233,12 +237,12 @@ namespace HAL::GPU::Vulkan
 
 	const Memory& BufferPackage::GetMemory()
 	{
-		return *memory;
+		return memory.GetMemory();
 	}
 
 	const DeviceSize& BufferPackage::GetMemoryOffset()
 	{
-		return memoryOffset;
+		return memory.Offset;
 	}
 
 	const BufferView& BufferPackage::GetView()
@@ -269,198 +273,259 @@ namespace HAL::GPU::Vulkan
 
 #pragma region VertexBuffer
 
-	EResult VertexBuffer::Create(ptr<const void> data, DeviceSize _dataSize, DeviceSize /*_stride*/)
+	EResult VertexBuffer::Create(ptr<const void> _data, DeviceSize _count, DeviceSize _stride, EBufferUpdate _update)
 	{
-		DeviceSize bufferSize = sizeof(Vertex_WColor) * _dataSize;
+		stride = _stride;
+		count  = _count ;
+		update = _update;
 
-		EResult result = EResult::Incomplete;
+		DeviceSize bufferSize = _stride * _count;
 
-		Buffer stagingBuffer;
+		copies = 1;
 
-		Memory stagingBufferMemory;
+		if (update == EBufferUpdate::Dynamic)
+		{
+			if (Rendering::GetFramesInFlight() == 0) throw RuntimeError("VertexBuffer: Dynamic buffers are created once a render context exists.");
 
-		Buffer::CreateInfo stagingBufferInfo;
+			// A copy rewritten before an update was last drawn copies updates ago, that frame must be done.
+			copies = Rendering::GetFramesBeforeReuse();
+		}
 
-		stagingBufferInfo.SharingMode = ESharingMode::Exclusive;
-		stagingBufferInfo.Size        = bufferSize;
+		mapped = update == EBufferUpdate::Dynamic && HasDeviceHostMemory();
 
-		stagingBufferInfo.Usage.Set(EBufferUsage::TransferSource);
+		EResult result = EResult::Incomplete;
 
-		result = stagingBuffer.Create(GPU_Comms::GetEngagedDevice(), stagingBufferInfo);
+		Buffer::CreateInfo vertexBufferInfo {};
 
-		if (result != EResult::Success) return result;
+		vertexBufferInfo.Size        = bufferSize * copies;
+		vertexBufferInfo.SharingMode = ESharingMode::Exclusive;
 
-		Memory::AllocateInfo allocInfo;
+		// Transfer source so the defragmenter can move it.
+		vertexBufferInfo.Usage.Set(EBufferUsage::TransferSource, EBufferUsage::TransferDestination, EBufferUsage::VertexBuffer);
 
-		auto& memReq = stagingBuffer.GetMemoryRequirements();
+		result = buffer.Create(GPU_Comms::GetEngagedDevice(), vertexBufferInfo);
 
-		allocInfo.AllocationSize = memReq.Size;
+		if (result != EResult::Success) return result;
 
-		allocInfo.MemoryTypeIndex =
-			stagingBuffer.GetDevice().GetPhysicalDevice().FindMemoryType
-			(memReq.MemoryTypeBits, Memory::PropertyFlags(EMemoryPropertyFlag::HostVisible, EMemoryPropertyFlag::HostCoherent));
+		if (mapped)
+		{
+			// The host visible window of VRAM may be full, the staged copies do not need it.
+			mapped = AllocateDeviceHostMemory(buffer.GetMemoryRequirements(), EResourceTiling::Linear, memory) == EResult::Success;
+		}
 
-		result = stagingBufferMemory.Allocate(GPU_Comms::GetEngagedDevice(), allocInfo);
+		if (!mapped)
+		{
+			result = AllocateMemory(buffer.GetMemoryRequirements(), Memory::PropertyFlags(EMemoryPropertyFlag::DeviceLocal), EResourceTiling::Linear, memory);
 
-		if (result != EResult::Success) return result;
+			if (result != EResult::Success) return result;
+		}
 
-		result = stagingBuffer.BindMemory(stagingBufferMemory, Memory::ZeroOffset);
+		result = buffer.BindMemory(memory.GetMemory(), memory.Offset);
 
 		if (result != EResult::Success) return result;
 
-		Memory::MapFlags mapflags;
-
-		stagingBufferMemory.WriteToGPU(0, bufferSize, mapflags, data);
-
-		Buffer::CreateInfo vertexBufferInfo {};
+		for (u32 copy = 0; copy < copies; copy++)
+		{
+			if (mapped) memory.WriteToGPU(bufferSize * copy, bufferSize, _data);
+			else        Staging::Upload(buffer, bufferSize * copy, _data, bufferSize);
+		}
 
-		vertexBufferInfo.Size        = bufferSize;
-		vertexBufferInfo.SharingMode = ESharingMode::Exclusive;
+		if (update == EBufferUpdate::Dynamic)
+		{
+			ptr<const Byte> bytes = RCast<const Byte>(_data);
 
-		vertexBufferInfo.Usage.Set(EBufferUsage::TransferDestination, EBufferUsage::VertexBuffer);
+			hostCopy.assign(bytes, bytes + bufferSize);
+		}
 
-		result = buffer.Create(GPU_Comms::GetEngagedDevice(), vertexBufferInfo);
+		dirty.assign(copies, DirtyRange());
 
-		if (result != EResult::Success) return result;
+		current = 0;
+		pending = false;
 
-		auto& memReqVert = buffer.GetMemoryRequirements();
+		// The initial contents count as this frame's flush, the other copies are not drawn yet.
+		flushedFrame = Rendering::GetFrame();
 
-		allocInfo.AllocationSize = memReqVert.Size;
+		// Host writes through the mapping would race a move.
+		if (!mapped) Defragmenter::Register(buffer, memory);
 
-		allocInfo.MemoryTypeIndex =
-			buffer.GetDevice().GetPhysicalDevice().FindMemoryType
-			(memReqVert.MemoryTypeBits, Memory::PropertyFlags(EMemoryPropertyFlag::DeviceLocal));
+		return result;
+	}
 
-		result = memory.Allocate(GPU_Comms::GetEngagedDevice(), allocInfo);
+	void VertexBuffer::Destroy()
+	{
+		Defragmenter::Unregister(buffer);
 
-		if (result != EResult::Success) return result;
+		buffer.Destroy();
 
-		memoryOffset = Memory::ZeroOffset;   // Hardcoded
+		FreeMemory(memory);
 
-		result = buffer.BindMemory(memory, memoryOffset);
+		hostCopy.clear();
+		dirty   .clear();
+	}
 
-		if (result != EResult::Success) return result;
+	void VertexBuffer::Write(DeviceSize _first, ptr<const void> _data, DeviceSize _count)
+	{
+		if (update != EBufferUpdate::Dynamic) throw RuntimeError("VertexBuffer: Write to a static buffer.");
 
-		Buffer::CopyInfo copyInfo {}; copyInfo.DestinationOffset = 0; copyInfo.SourceOffset = 0; copyInfo.Size = bufferSize;
+		if (_first + _count > count) throw RuntimeError("VertexBuffer: Write past the end of the buffer.");
 
-		auto commandBuffer = Deck::RecordOnTransient();
+		if (_count == 0) return;
 
-		commandBuffer.CopyBuffer(stagingBuffer, buffer, 1, &copyInfo);
+		DeviceSize begin = _first * stride;
+		DeviceSize end   = begin + _count * stride;
 
-		Deck::EndRecordOnTransient(commandBuffer);
+		memcpy(hostCopy.data() + begin, _data, end - begin);
 
-		stagingBuffer      .Destroy();
-		stagingBufferMemory.Free();
+		// One range per copy, what lies between two writes is uploaded again from the host copy.
+		for (auto& range : dirty)
+		{
+			if (range.End == 0)
+			{
+				range.Begin = begin;
+				range.End   = end  ;
+			}
+			else
+			{
+				range.Begin = std::min(range.Begin, begin);
+				range.End   = std::max(range.End  , end  );
+			}
+		}
 
-		return result;
+		pending = true;
 	}
 
-	void VertexBuffer::Destroy()
+	void VertexBuffer::Flush()
 	{
-		buffer.Destroy();
+		if (!pending) return;
 
-		memory.Free();
-	}
-	
-	const Buffer& VertexBuffer::GetBuffer() const { return buffer; }
+		// A render context recreated with more frames in flight, they could draw every copy. Rare, recreated after the device is done.
+		if (copies < Rendering::GetFramesBeforeReuse())
+		{
+			GPU_Comms::GetEngagedDevice().WaitUntilIdle();
 
-#pragma endregion VertexBuffer
+			DynamicArray<Byte> vertices = move(hostCopy);
 
-#pragma region IndexBuffer
+			DeviceSize vertexCount = count;
 
-	EResult IndexBuffer::Create(ptr<const void> _data, DeviceSize _dataSize, DeviceSize /*_stride*/)
-	{
-		indices = _dataSize;
+			Destroy();
 
-		DeviceSize bufferSize = sizeof(u32) * _dataSize;
+			if (Create(vertices.data(), vertexCount, stride, EBufferUpdate::Dynamic) != EResult::Success)
+				throw RuntimeError("VertexBuffer: Failed to recreate for more frames in flight.");
 
-		EResult result = EResult::Incomplete;
+			return;
+		}
 
-		Buffer             stagingBuffer;
-		Buffer::CreateInfo stagingBufferInfo;
-		Memory             stagingBufferMemory;
+		// Draws switch copies at most once per frame. Flushed again in the same frame, the copy is updated in place:
+		// no frame drew it since it was picked, the one that last did is done.
+		bool rotate = flushedFrame != Rendering::GetFrame();
 
-		stagingBufferInfo.SharingMode = ESharingMode::Exclusive;
-		stagingBufferInfo.Size = bufferSize;
+		u32 target = rotate ? (current + 1) % copies : current;
 
-		stagingBufferInfo.Usage.Set(EBufferUsage::TransferSource);
+		DirtyRange& range = dirty[target];
 
-		result = stagingBuffer.Create(GPU_Comms::GetEngagedDevice(), stagingBufferInfo);
+		DeviceSize offset = stride * count * target + range.Begin;
+		DeviceSize size   = range.End - range.Begin;
 
-		if (result != EResult::Success) return result;
+		if (mapped)
+		{
+			memory.WriteToGPU(offset, size, hostCopy.data() + range.Begin);
+		}
+		else
+		{
+			if (!rotate)
+			{
+				// Copies into the same range within a batch are not ordered.
+				Buffer::Memory_Barrier barrier {};
 
-		Memory::AllocateInfo allocInfo;
+				barrier.SrcQueueFamilyIndex = QueueFamily_Ignored;
+				barrier.DstQueueFamilyIndex = QueueFamily_Ignored;
 
-		auto& memReq = stagingBuffer.GetMemoryRequirements();
+				barrier.Buffer = buffer;
+				barrier.Offset = offset;
+				barrier.Size   = size  ;
 
-		allocInfo.AllocationSize = memReq.Size;
+				barrier.SrcAccessMask.Set(EAccessFlag::TransferWrite);
+				barrier.DstAccessMask.Set(EAccessFlag::TransferWrite);
 
-		allocInfo.MemoryTypeIndex =
-			stagingBuffer.GetDevice().GetPhysicalDevice().FindMemoryType
-			(memReq.MemoryTypeBits, Memory::PropertyFlags(EMemoryPropertyFlag::HostVisible, EMemoryPropertyFlag::HostCoherent));
+				BarrierBatch batch;
 
-		result = stagingBufferMemory.Allocate(GPU_Comms::GetEngagedDevice(), allocInfo);
+				batch.Add(barrier, EPipelineStageFlag::Transfer, EPipelineStageFlag::Transfer);
 
-		if (result != EResult::Success) return result;
+				batch.Flush(Staging::Record());
+			}
 
-		result = stagingBuffer.BindMemory(stagingBufferMemory, Memory::ZeroOffset);
+			Staging::Upload(buffer, offset, hostCopy.data() + range.Begin, size);
+		}
 
-		if (result != EResult::Success) return result;
+		range = DirtyRange();
 
-		// Hard coded vertex data...
+		current      = target;
+		flushedFrame = Rendering::GetFrame();
+		pending      = false;
+	}
+	
+	const Buffer& VertexBuffer::GetBuffer() const { return buffer; }
 
-		RoVoidPtr address = _data;
+	DeviceSize VertexBuffer::GetOffset() const
+	{
+		return stride * count * current;
+	}
 
-		stagingBufferMemory.WriteToGPU(0, bufferSize, Memory::MapFlags(), address);
+	DeviceSize VertexBuffer::GetStride() const
+	{
+		return stride;
+	}
 
-		Buffer::CreateInfo indexBufferInfo{};
+	DeviceSize VertexBuffer::GetCount() const
+	{
+		return count;
+	}
 
-		indexBufferInfo.SharingMode = ESharingMode::Exclusive;
-		indexBufferInfo.Size = bufferSize;
+#pragma endregion VertexBuffer
+
+#pragma region IndexBuffer
 
-		indexBufferInfo.Usage.Set(EBufferUsage::TransferDestination, EBufferUsage::IndexBuffer);
+	EResult IndexBuffer::Create(ptr<const void> _data, DeviceSize _dataSize, DeviceSize /*_stride*/)
+	{
+		indices = _dataSize;
 
-		result = buffer.Create(GPU_Comms::GetEngagedDevice(), indexBufferInfo);
+		DeviceSize bufferSize = sizeof(u32) * _dataSize;
 
-		if (result != EResult::Success) return result;
+		EResult result = EResult::Incomplete;
 
-		auto& memReqIndex = buffer.GetMemoryRequirements();
+		Buffer::CreateInfo indexBufferInfo{};
 
-		allocInfo.AllocationSize = memReqIndex.Size;
+		indexBufferInfo.SharingMode = ESharingMode::Exclusive;
+		indexBufferInfo.Size = bufferSize;
 
-		allocInfo.MemoryTypeIndex =
-			buffer.GetDevice().GetPhysicalDevice().FindMemoryType
-			(memReqIndex.MemoryTypeBits, Memory::PropertyFlags(EMemoryPropertyFlag::DeviceLocal));
+		indexBufferInfo.Usage.Set(EBufferUsage::TransferSource, EBufferUsage::TransferDestination, EBufferUsage::IndexBuffer);
 
-		result = memory.Allocate(GPU_Comms::GetEngagedDevice(), allocInfo);
+		result = buffer.Create(GPU_Comms::GetEngagedDevice(), indexBufferInfo);
 
 		if (result != EResult::Success) return result;
 
-		memoryOffset = Memory::ZeroOffset;
-
-		result = buffer.BindMemory(memory, memoryOffset);
+		result = AllocateMemory(buffer.GetMemoryRequirements(), Memory::PropertyFlags(EMemoryPropertyFlag::DeviceLocal), EResourceTiling::Linear, memory);
 
 		if (result != EResult::Success) return result;
 
-		Buffer::CopyInfo copyInfo{}; copyInfo.DestinationOffset = 0; copyInfo.SourceOffset = 0; copyInfo.Size = bufferSize;
+		result = buffer.BindMemory(memory.GetMemory(), memory.Offset);
 
-		auto commandBuffer = Deck::RecordOnTransient();
-
-		commandBuffer.CopyBuffer(stagingBuffer, buffer, 1, &copyInfo);
+		if (result != EResult::Success) return result;
 
-		Deck::EndRecordOnTransient(commandBuffer);
+		Staging::Upload(buffer, 0, _data, bufferSize);
 
-		stagingBuffer.Destroy();
-		stagingBufferMemory.Free();
+		Defragmenter::Register(buffer, memory);
 
 		return result;
 	}
 
 	void IndexBuffer::Destroy()
 	{
+		Defragmenter::Unregister(buffer);
+
 		buffer.Destroy();
 
-		memory.Free();
+		FreeMemory(memory);
 	}
 
 	const Buffer& IndexBuffer::GetBuffer() const
@@ -490,37 +555,6 @@ namespace HAL::GPU::Vulkan
 
 		u32 mipmapLevels = SCast<u32>(std::floor(std::log2(std::max<u32>(_width, _height)))) + 1;
 
-		Buffer stagingBuffer;
-
-		Memory stagingBufferMemory;
-
-		Buffer::CreateInfo stagingBufferInfo{};
-
-		stagingBufferInfo.Size = imageSize;
-		stagingBufferInfo.SharingMode = ESharingMode::Exclusive;
-
-		stagingBufferInfo.Usage.Set(EImageUsage::TransferSource);
-
-		stagingBuffer.Create(GPU_Comms::GetEngagedDevice(), stagingBufferInfo);
-
-		Memory::AllocateInfo allocInfo;
-
-		auto& memReq = stagingBuffer.GetMemoryRequirements();
-
-		allocInfo.AllocationSize = memReq.Size;
-
-		allocInfo.MemoryTypeIndex =
-			stagingBuffer.GetDevice().GetPhysicalDevice().FindMemoryType
-			(memReq.MemoryTypeBits, Memory::PropertyFlags(EMemoryPropertyFlag::HostVisible, EMemoryPropertyFlag::HostCoherent));
-
-		stagingBufferMemory.Allocate(GPU_Comms::GetEngagedDevice(), allocInfo);
-
-		stagingBuffer.BindMemory(stagingBufferMemory, Memory::ZeroOffset);
-
-		RoVoidPtr address = _imageData;
-
-		stagingBufferMemory.WriteToGPU(0, imageSize, 0, address);
-
 		Image::CreateInfo info;
 
 		info.ImageType     = EImageType::_2D       ;
@@ -540,21 +574,12 @@ namespace HAL::GPU::Vulkan
 
 		image.Create(GPU_Comms::GetEngagedDevice(), info);
 
-		Memory::AllocateInfo allocationInfo{};
-
-		auto& gpu = GPU_Comms::GetEngagedDevice().GetPhysicalDevice();
-
-		allocationInfo.AllocationSize  = image.GetMemoryRequirements().Size;
-		allocationInfo.MemoryTypeIndex = gpu.FindMemoryType(image.GetMemoryRequirements().MemoryTypeBits, Memory::PropertyFlags(EMemoryPropertyFlag::DeviceLocal));
-
-		if (memory.Allocate(image.GetMemoryRequirements(), Memory::PropertyFlags(EMemoryPropertyFlag::DeviceLocal)) != EResult::Success)
+		if (AllocateMemory(image.GetMemoryRequirements(), Memory::PropertyFlags(EMemoryPropertyFlag::DeviceLocal), EResourceTiling::Optimal, memory) != EResult::Success)
 			throw RuntimeError("Failed to allocate image memory!");
 
-		image.BindMemory(memory, 0);
-
-		image.TransitionLayout(EImageLayout::Undefined, EImageLayout::TransferDestination_Optimal);
+		image.BindMemory(memory.GetMemory(), memory.Offset);
 
-		auto& buffer = Deck::RecordOnTransient();
+		image.TransitionLayout(Staging::Record(), EImageLayout::Undefined, EImageLayout::TransferDestination_Optimal);
 
 		CommandBuffer::BufferImageRegion region{};
 
@@ -575,25 +600,21 @@ namespace HAL::GPU::Vulkan
 		region.ImageExtent.Height = _height;
 		region.ImageExtent.Depth  = 1;
 
-		buffer.CopyBufferToImage(stagingBuffer, image, EImageLayout::TransferDestination_Optimal, 1, &region);
-
-		Deck::EndRecordOnTransient(buffer);
+		Staging::Upload(image, region, _imageData, imageSize);
 
-		GenerateMipmaps();
+		// Blits need the graphics queue, the copies may have run on the transfer queue.
+		GenerateMipmaps(Staging::RecordAfterUpload());
 
 		CreateImageView();
 
 		CreateSampler();
-
-		stagingBuffer.Destroy();
-		stagingBufferMemory.Free();
 	}
 
 	void TextureImage::Destroy()
 	{
 		image.Destroy();
 
-		memory.Free();
+		FreeMemory(memory);
 
 		imageView.Destroy();
 
@@ -654,7 +675,7 @@ namespace HAL::GPU::Vulkan
 			throw RuntimeError("Failed to create texture sampler!");
 	}
 
-	void TextureImage::GenerateMipmaps()
+	void TextureImage::GenerateMipmaps(const CommandBuffer& _commandBuffer)
 	{
 		// Check if image format supports linear blitting
 		FormatProperties formatProperties = GPU_Comms::GetEngagedDevice().GetPhysicalDevice().GetFormatProperties(GetFormat());
@@ -664,8 +685,6 @@ namespace HAL::GPU::Vulkan
 			throw std::runtime_error("Texture image format does not support linear blitting!");
 		}
 
-		auto& commandBuffer = Deck::RecordOnTransient();
-
 		Image::Memory_Barrier barrier{};
 
 		barrier.Image               = image              ;
@@ -678,6 +697,9 @@ namespace HAL::GPU::Vulkan
 		barrier.SubresourceRange.LayerCount     = 1;
 		barrier.SubresourceRange.LevelCount     = 1;
 
+		// Each level is made a blit source together with the previous one becoming readable, one barrier per level.
+		BarrierBatch barriers;
+
 		s32 mipWidth  = GetExtent().Width ;
 		s32 mipHeight = GetExtent().Height;
 
@@ -691,11 +713,9 @@ namespace HAL::GPU::Vulkan
 			barrier.SrcAccessMask.Set(EAccessFlag::TransferWrite);
 			barrier.DstAccessMask.Set(EAccessFlag::TransferRead);
 
-			commandBuffer.SubmitPipelineBarrier
-			(
-				EPipelineStageFlag::Transfer, EPipelineStageFlag::Transfer, 0,
-				1, &barrier
-			);
+			barriers.Add(barrier, EPipelineStageFlag::Transfer, EPipelineStageFlag::Transfer);
+
+			barriers.Flush(_commandBuffer);
 
 			Image::Blit blit{};
 
@@ -725,7 +745,7 @@ namespace HAL::GPU::Vulkan
 			blit.DstSubresource.BaseArrayLayer = 0;
 			blit.DstSubresource.LayerCount = 1;
 
-			commandBuffer.BlitImage
+			_commandBuffer.BlitImage
 			(
 				image, EImageLayout::TransferSource_Optimal,
 				image, EImageLayout::TransferDestination_Optimal,
@@ -733,17 +753,14 @@ namespace HAL::GPU::Vulkan
 				EFilter::Linear
 			);
 
+			// Submitted with the next level's barrier.
 			barrier.OldLayout = EImageLayout::TransferSource_Optimal;
 			barrier.NewLayout = EImageLayout::Shader_ReadonlyOptimal;
 
 			barrier.SrcAccessMask.Set(EAccessFlag::TransferRead);
 			barrier.DstAccessMask.Set(EAccessFlag::ShaderRead  );
 
-			commandBuffer.SubmitPipelineBarrier
-			(
-				EPipelineStageFlag::Transfer, EPipelineStageFlag::FragementShader, 0,
-				1, &barrier
-			);
+			barriers.Add(barrier, EPipelineStageFlag::Transfer, EPipelineStageFlag::FragementShader);
 
 			if (mipWidth  > 1) mipWidth  /= 2;
 			if (mipHeight > 1) mipHeight /= 2;
@@ -757,13 +774,9 @@ namespace HAL::GPU::Vulkan
 		barrier.SrcAccessMask.Set(EAccessFlag::TransferWrite);
 		barrier.DstAccessMask.Set(EAccessFlag::ShaderRead   );
 
-		commandBuffer.SubmitPipelineBarrier
-		(
-			EPipelineStageFlag::Transfer, EPipelineStageFlag::FragementShader, 0,
-			1, &barrier
-		);
+		barriers.Add(barrier, EPipelineStageFlag::Transfer, EPipelineStageFlag::FragementShader);
 
-		Deck::EndRecordOnTransient(commandBuffer);
+		barriers.Flush(_commandBuffer);
 	}
 
 	const ImageView& TextureImage::GetView() const
@@ -797,24 +810,20 @@ namespace HAL::GPU::Vulkan
 			throw RuntimeError("Failed to create uniform buffer.");
 		}
 
-		Memory::AllocateInfo allocInfo;
-
-		auto& memReq = buffer.GetMemoryRequirements();
-
-		allocInfo.AllocationSize = memReq.Size;
-
-		allocInfo.MemoryTypeIndex =
-			buffer.GetDevice().GetPhysicalDevice().FindMemoryType
-			(memReq.MemoryTypeBits, Memory::PropertyFlags(EMemoryPropertyFlag::HostVisible, EMemoryPropertyFlag::HostCoherent));
-
-		result = memory.Allocate(GPU_Comms::GetEngagedDevice(), allocInfo);
+		result = AllocateMemory
+		(
+			buffer.GetMemoryRequirements(),
+			Memory::PropertyFlags(EMemoryPropertyFlag::HostVisible, EMemoryPropertyFlag::HostCoherent),
+			EResourceTiling::Linear,
+			memory
+		);
 
 		if (result != EResult::Success)
 		{
 			throw RuntimeError("Failed to create uniform buffer memory.");
 		}
 
-		buffer.BindMemory(memory, Memory::ZeroOffset);
+		result = buffer.BindMemory(memory.GetMemory(), memory.Offset);
 
 		if (result != EResult::Success)
 		{
@@ -828,12 +837,12 @@ namespace HAL::GPU::Vulkan
 	{
 		buffer.Destroy();
 
-		memory.Free();
+		FreeMemory(memory);
 	}
 
 	void UniformBuffer::Write(ptr<const void> _data)
 	{
-		memory.WriteToGPU(0, buffer.GetSize(), 0, _data);
+		memory.WriteToGPU(0, buffer.GetSize(), _data);
 	}
 
 	const Buffer& UniformBuffer::GetBuffer() const
@@ -843,11 +852,97 @@ namespace HAL::GPU::Vulkan
 
 	const Memory& UniformBuffer::GetMemory() const
 	{
-		return memory;
+		return memory.GetMemory();
 	}
 
 #pragma endregion UniformBuffer
 
+#pragma region UniformArena
+
+	EResult UniformArena::Create(u32 _frames, DeviceSize _frameSize)
+	{
+		alignment = std::max<DeviceSize>(GPU_Comms::GetEngagedPhysicalGPU().GetProperties().Limits.MinUniformBufferOffsetAlignment, 1);
+
+		// Every region starts aligned, so do the offsets pushed into it.
+		frameSize = (_frameSize + alignment - 1) / alignment * alignment;
+
+		// Also when rebuilt for another number of frames.
+		frameStart = 0;
+		head       = 0;
+
+		Buffer::CreateInfo info;
+
+		info.Size        = frameSize * _frames;
+		info.SharingMode = ESharingMode::Exclusive;
+
+		info.Usage.Set(EBufferUsage::UniformBuffer);
+
+		EResult result = buffer.Create(GPU_Comms::GetEngagedDevice(), info);
+
+		if (result != EResult::Success) return result;
+
+		// Device local when the device can map it, read by every draw without crossing the bus.
+		result = AllocateDeviceHostMemory(buffer.GetMemoryRequirements(), EResourceTiling::Linear, memory);
+
+		if (result != EResult::Success)
+		{
+			result = AllocateMemory
+			(
+				buffer.GetMemoryRequirements(),
+				Memory::PropertyFlags(EMemoryPropertyFlag::HostVisible, EMemoryPropertyFlag::HostCoherent),
+				EResourceTiling::Linear,
+				memory
+			);
+		}
+
+		if (result != EResult::Success) return result;
+
+		result = buffer.BindMemory(memory.GetMemory(), memory.Offset);
+
+		if (result != EResult::Success) return result;
+
+		memory.GetMapped();
+
+		frameStart = 0;
+		head       = 0;
+
+		return result;
+	}
+
+	void UniformArena::Destroy()
+	{
+		buffer.Destroy();
+
+		FreeMemory(memory);
+	}
+
+	void UniformArena::BeginFrame(u32 _frame)
+	{
+		frameStart = frameSize * _frame;
+		head       = frameStart;
+	}
+
+	u32 UniformArena::Push(ptr<const void> _data, DeviceSize _size)
+	{
+		DeviceSize offset = head;
+
+		if (offset + _size > frameStart + frameSize)
+			throw RuntimeError("Uniform arena is out of space for the frame, raise Meta::GPU_UniformArenaSize.");
+
+		memory.WriteToGPU(offset, _size, _data);
+
+		head = (offset + _size + alignment - 1) / alignment * alignment;
+
+		return SCast<u32>(offset);
+	}
+
+	const Buffer& UniformArena::GetBuffer() const
+	{
+		return buffer;
+	}
+
+#pragma endregion UniformArena
+
 #pragma region GPU_Resources
 
 	//DynamicArray< DescriptorPool> GPU_Resources_Maker<Meta::EGPU_Engage::Single>::descriptorPools;
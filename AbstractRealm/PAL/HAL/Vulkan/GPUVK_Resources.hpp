@@ -2,6 +2,8 @@
 
 
 #include "GPUVK_Memory.hpp"
+#include "GPUVK_Bindless.hpp"
+#include "GPUVK_Geometry.hpp"
 //#include "GPUVK_Rendering.hpp"
 #include "GPUVK_Shaders.hpp"
 
@@ -9,6 +11,10 @@
 
 namespace HAL::GPU::Vulkan
 {
+	class BarrierBatch;
+
+
+
 	// Classes
 
 	class Buffer : public V3::Buffer
@@ -34,6 +40,8 @@ namespace HAL::GPU::Vulkan
 
 		DeviceSize GetSize() const { return info.Size; }
 
+		const CreateInfo& GetInfo() const { return info; }
+
 	protected:
 
 		CreateInfo info;
@@ -59,6 +67,13 @@ namespace HAL::GPU::Vulkan
 
 		void TransitionLayout(EImageLayout _old, EImageLayout _new);
 
+		void TransitionLayout(const CommandBuffer& _commandBuffer, EImageLayout _old, EImageLayout _new);
+
+		/*
+		Adds the transition to _barriers instead of recording it, so it is submitted with the others.
+		*/
+		void TransitionLayout(BarrierBatch& _barriers, EImageLayout _old, EImageLayout _new);
+
 		operator Parent&();
 
 	protected:
@@ -89,8 +104,6 @@ namespace HAL::GPU::Vulkan
 
 		BufferPackage(const LogicalDevice& _device);
 
-		BufferPackage(const LogicalDevice& _device, const Memory& _allocator);
-
 		~BufferPackage();
 
 		void Create(const Buffer::CreateInfo& _bufferInfo, Memory::PropertyFlags _memoryFlags);
@@ -106,10 +119,9 @@ namespace HAL::GPU::Vulkan
 
 	protected:
 
-		      Buffer     buffer      ;
-		const Memory*    memory      ;
-		      DeviceSize memoryOffset;
-		      BufferView view        ;
+		Buffer           buffer;
+		MemoryAllocation memory;
+		BufferView       view  ;
 	};
 
 	class ImagePackage
@@ -121,11 +133,9 @@ namespace HAL::GPU::Vulkan
 
 		u32 GetMipmapLevels() const;
 
-		Image      image ;
-		Memory     memory;
-		//Memory*    memory;
-		DeviceSize memoryOffset;
-		ImageView  view  ;
+		Image            image ;
+		MemoryAllocation memory;
+		ImageView        view  ;
 	};
 
 	struct VertexInputState : Pipeline::VertexInputState
@@ -134,27 +144,106 @@ namespace HAL::GPU::Vulkan
 		BindingDescription                 Bind      ;
 	};
 
+	enum class EBufferUpdate
+	{
+		Static ,   // Written once when created.
+		Dynamic    // Rewritten in place, see VertexBuffer::Write.
+	};
+
+	/*
+	Vertices in device local memory, uploaded through staging.
+
+	Dynamic buffers keep the vertices on the host too, and Rendering::GetFramesBeforeReuse device copies:
+	the one written, and the ones frames in flight may still draw. Writes go to the host and mark their range
+	dirty in every device copy. Flush uploads what the next copy is missing and draws switch to it, at most
+	once per frame, so a copy is never written while a frame may be drawing it.
+
+	When the device has memory that is both device local and host visible (resizable BAR, integrated GPUs),
+	dynamic buffers are placed in it and flushed with a copy through the mapping instead of staging.
+	*/
 	class VertexBuffer
 	{
 	public:
 
-		EResult Create(ptr<const void> data, DeviceSize _dataSize, DeviceSize _stride);
+		VertexBuffer() {}
+
+		// Registered with the defragmenter by address, neither copied nor moved (which also deletes the moves).
+		VertexBuffer(const VertexBuffer&) = delete;
+
+		VertexBuffer& operator=(const VertexBuffer&) = delete;
+
+		EResult Create(ptr<const void> _data, DeviceSize _count, DeviceSize _stride, EBufferUpdate _update = EBufferUpdate::Static);
+
+		template<typename VertexType>
+		EResult Create(const DynamicArray<VertexType>& _vertices, EBufferUpdate _update = EBufferUpdate::Static)
+		{
+			return Create(_vertices.data(), _vertices.size(), sizeof(VertexType), _update);
+		}
 
 		void Destroy();
 
+		/*
+		Dynamic buffers only. Replaces _count vertices starting at _first, uploaded by the next flush.
+		*/
+		void Write(DeviceSize _first, ptr<const void> _data, DeviceSize _count);
+
+		/*
+		Dynamic buffers only. Uploads the writes since the last flush.
+		Called before Rendering::Update, which submits the upload ahead of the frame. May be called more than once a frame.
+		Recreates the buffer with more copies once the frames in flight grew.
+		*/
+		void Flush();
+
 		const Buffer& GetBuffer() const;
 
+		/*
+		Where the vertices drawn this frame start in the buffer, to bind at.
+		*/
+		DeviceSize GetOffset() const;
+
+		DeviceSize GetStride() const;
+
+		DeviceSize GetCount() const;
+
 	protected:
 
-		Buffer     buffer      ;
-		Memory     memory      ;
-		DeviceSize memoryOffset;
+		// In bytes, empty when End is 0.
+		struct DirtyRange
+		{
+			DeviceSize Begin = 0;
+			DeviceSize End   = 0;
+		};
+
+		Buffer           buffer;
+		MemoryAllocation memory;
+
+		DeviceSize stride = 0;
+		DeviceSize count  = 0;
+
+		EBufferUpdate update = EBufferUpdate::Static;
+
+		DynamicArray<Byte> hostCopy;
+
+		DynamicArray<DirtyRange> dirty;   // What each device copy is missing.
+
+		u32  copies       = 1    ;
+		u32  current      = 0    ;   // Device copy drawn.
+		u32  flushedFrame = 0    ;   // Rendering frame current was picked during.
+		bool pending      = false;   // Written since the last flush.
+		bool mapped       = false;   // Device local and host visible.
 	};
 
 	class IndexBuffer
 	{
 	public:
 
+		IndexBuffer() {}
+
+		// Registered with the defragmenter by address, neither copied nor moved.
+		IndexBuffer(const IndexBuffer&) = delete;
+
+		IndexBuffer& operator=(const IndexBuffer&) = delete;
+
 		EResult Create(ptr<const void> data, DeviceSize _dataSize, DeviceSize _stride);
 
 		void Destroy();
@@ -167,9 +256,8 @@ namespace HAL::GPU::Vulkan
 
 	protected:
 
-		Buffer     buffer      ;
-		Memory     memory      ;
-		DeviceSize memoryOffset;
+		Buffer           buffer;
+		MemoryAllocation memory;
 
 		u32 indices;
 	};
@@ -192,7 +280,7 @@ namespace HAL::GPU::Vulkan
 
 		void CreateSampler();
 
-		void GenerateMipmaps();
+		void GenerateMipmaps(const CommandBuffer& _commandBuffer);
 
 		ImageView imageView;
 
@@ -215,8 +303,46 @@ namespace HAL::GPU::Vulkan
 
 	protected:
 
-		Buffer buffer;
-		Memory memory;
+		Buffer           buffer;
+		MemoryAllocation memory;
+	};
+
+	/*
+	A persistently mapped uniform buffer split into a region per frame in flight.
+
+	Uniforms are bump allocated into the region of the current frame and bound with a dynamic offset,
+	so every renderable shares the one buffer and a single descriptor of it instead of a buffer per swap image.
+	*/
+	class UniformArena
+	{
+	public:
+
+		EResult Create(u32 _frames, DeviceSize _frameSize);
+
+		void Destroy();
+
+		/*
+		Starts writing _frame's region over, the GPU must be done with the frame's previous use.
+		*/
+		void BeginFrame(u32 _frame);
+
+		/*
+		Copies _data into the current frame's region, returns the dynamic offset to bind it with.
+		*/
+		u32 Push(ptr<const void> _data, DeviceSize _size);
+
+		const Buffer& GetBuffer() const;
+
+	protected:
+
+		Buffer           buffer;
+		MemoryAllocation memory;
+
+		DeviceSize frameSize = 0;
+		DeviceSize alignment = 1;   // minUniformBufferOffsetAlignment
+
+		DeviceSize frameStart = 0;
+		DeviceSize head       = 0;
 	};
 
 
@@ -338,7 +464,7 @@ namespace HAL::GPU::Vulkan
 
 		~ARenderable() {};
 
-		virtual void RecordRender(u32 _index, const CommandBuffer& _commandBuffer, const PipelineLayout& _pipelineLayout) = NULL;
+		virtual void RecordRender(UniformArena& _uniforms, const CommandBuffer& _commandBuffer, const PipelineLayout& _pipelineLayout) = NULL;
 
 		virtual DynamicArray<AttributeDescription>& GetVertexAttributes() const = NULL;
 
@@ -346,9 +472,19 @@ namespace HAL::GPU::Vulkan
 
 		virtual ptr<const AShader> GetShader() const = NULL;
 
+		/*
+		The geometry pool drawn from, bound by the render context when it changes.
+		*/
+		virtual u32 GetGeometryPool() const = NULL;
+
 		virtual ptr<const DescriptorSetLayout> GetDescriptorsLayout() const = NULL;
 
-		virtual void CreateDescriptorSets(u32 _count, const DescriptorPool& _descriptorPool) = NULL;
+		virtual void CreateDescriptorSets(const DescriptorPool& _descriptorPool, const UniformArena& _uniforms) = NULL;
+
+		/*
+		Points the descriptor sets at _uniforms, when the render context rebuilt its arena.
+		*/
+		virtual void RebindUniforms(const UniformArena& _uniforms) = NULL;
 
 		//virtual void CreateUniforms
 
@@ -396,16 +532,21 @@ namespace HAL::GPU::Vulkan
 
 		using Vertex = VertexType;
 
+		/*
+		Static meshes are sub-allocated from the geometry pools. Dynamic ones get their own buffers, the vertices
+		can then be rewritten every frame (see VertexBuffer).
+		*/
 		void Create
 		(
 			const DynamicArray<VertexType>& _verticies, 
 			const DynamicArray<u32>         _indicies,
 			ptr<const u8>                   _textureData,
 			u32 _width, u32 _height,
-			ptr<const AShader> _shader
+			ptr<const AShader> _shader,
+			EBufferUpdate      _update = EBufferUpdate::Static
 		);
 
-		void RecordRender(u32 _index, const CommandBuffer& _commandBuffer, const PipelineLayout& _pipelineLayout) override;
+		void RecordRender(UniformArena& _uniforms, const CommandBuffer& _commandBuffer, const PipelineLayout& _pipelineLayout) override;
 
 		DynamicArray<AttributeDescription>& GetVertexAttributes() const override;
 
@@ -413,30 +554,58 @@ namespace HAL::GPU::Vulkan
 
 		ptr<const AShader> GetShader() const override;
 
+		u32 GetGeometryPool() const override;
+
 		ptr<const DescriptorSetLayout> GetDescriptorsLayout() const override;
 
-		void CreateDescriptorSets(u32 _count, const DescriptorPool& _descriptorPool) override;
+		void CreateDescriptorSets(const DescriptorPool& _descriptorPool, const UniformArena& _uniforms) override;
+
+		void RebindUniforms(const UniformArena& _uniforms) override;
 
 		//void CreateUniforms()
 
 		void UpdateUniforms(ptr<const void> _data, DeviceSize _size) override;
+
+		/*
+		Static only. Replaces the mesh, the previous one is freed once the frames drawing it are done.
+		*/
+		void ReplaceGeometry(const DynamicArray<VertexType>& _verticies, const DynamicArray<u32>& _indicies);
+
+		/*
+		Dynamic only. Replaces _count vertices starting at _first, drawn once flushed.
+		*/
+		void WriteVertices(DeviceSize _first, ptr<const VertexType> _vertices, DeviceSize _count);
+
+		/*
+		Dynamic only. Uploads the vertices written since the last flush, called before Rendering::Update.
+		*/
+		void Flush();
+
+		/*
+		Replaces the texture, waits for the device to be idle as frames in flight may sample the previous one.
+		*/
+		void ReplaceTexture(ptr<const u8> _textureData, u32 _width, u32 _height);
 		
 
 	protected:
 
 		void CreateDescriptorsLayout();
 
-		VertexBuffer vertBuffer;
+		EBufferUpdate update = EBufferUpdate::Static;
 
-		IndexBuffer indexBuffer;
+		GeometryRange geometry;   // Static, no pool when dynamic.
 
-		DynamicArray<Byte> uniformData;
+		// Dynamic, bound by the renderable itself.
+		VertexBuffer dynamicVertices;
+		IndexBuffer  dynamicIndices ;
 
-		DynamicArray<UniformBuffer> uniformBuffers;
+		DynamicArray<Byte> uniformData;   // Pushed to the frame's uniform arena when recorded.
 
 		TextureImage textureImage;
 
-		DynamicArray<DescriptorSet> descriptors;
+		BindlessIndices bindless;   // Where the texture is in the descriptor arrays, when enabled.
+
+		DynamicArray<DescriptorSet> descriptors;   // One, the uniforms are selected by dynamic offset.
 												
 		//ptr<const DescriptorSetLayout> descriptorsLayout;
 
@@ -480,12 +649,13 @@ namespace HAL::GPU::Vulkan
 			const DynamicArray<u32> _indicies, 
 			ptr<const u8> _textureData,
 			u32 _width, u32 _height,
-			ptr<const AShader> _shader
+			ptr<const AShader> _shader,
+			EBufferUpdate      _update = EBufferUpdate::Static
 		)
 		{
 			SPtr< TModelRenderable<VertexType>> newRenderable = MakeSPtr< TModelRenderable<VertexType>>();
 
-			newRenderable->Create(_verticies, _indicies, _textureData, _width, _height, _shader);
+			newRenderable->Create(_verticies, _indicies, _textureData, _width, _height, _shader, _update);
 
 			renderables.push_back(move(newRenderable));
 
@@ -10,7 +10,7 @@ namespace HAL::GPU::Vulkan
 	template<typename VertexType>
 	void TPrimitiveRenderable<VertexType>::Create(const DynamicArray<VertexType>& _verticies, ptr<const AShader> _shader)
 	{
-		vertBuffer.Create(_verticies.data(), _verticies.size(), 0);
+		vertBuffer.Create(_verticies);
 
 		shader = _shader;
 	}
@@ -18,16 +18,11 @@ namespace HAL::GPU::Vulkan
 	template<typename VertexType>
 	void TPrimitiveRenderable<VertexType>::RecordRender(const CommandBuffer& _commandBuffer)
 	{
-		unbound DynamicArray<Buffer::Handle> handles;
+		Buffer::Handle handle = vertBuffer.GetBuffer();
 
-		if (handles.empty())
-		{
-			Buffer::Handle handle = vertBuffer.GetBuffer();
-
-			handles.push_back(handle);
-		}
+		DeviceSize offset = vertBuffer.GetOffset();
 
-		_commandBuffer.BindVertexBuffers(0, 1, handles.data());
+		_commandBuffer.BindVertexBuffers(0, 1, &handle, &offset);
 
 		_commandBuffer.Draw(0, 3, 0, 1);
 	}
@@ -91,15 +86,29 @@ namespace HAL::GPU::Vulkan
 		const DynamicArray<u32> _indicies, 
 		ptr<const u8> _textureData,
 		u32 _width, u32 _height,
-		ptr<const AShader> _shader
+		ptr<const AShader> _shader,
+		EBufferUpdate      _update
 	)
 	{
-		vertBuffer.Create(_verticies.data(), _verticies.size(), 0);
+		update = _update;
+
+		if (update == EBufferUpdate::Static)
+		{
+			geometry = Geometry::Allocate(_verticies, _indicies);
+		}
+		else
+		{
+			if (dynamicVertices.Create(_verticies, EBufferUpdate::Dynamic) != EResult::Success)
+				throw RuntimeError("Failed to create the dynamic vertex buffer.");
 
-		indexBuffer.Create(_indicies.data(), _indicies.size(), 0);
+			if (dynamicIndices.Create(_indicies.data(), _indicies.size(), sizeof(u32)) != EResult::Success)
+				throw RuntimeError("Failed to create the dynamic index buffer.");
+		}
 
 		textureImage.Create(_textureData, _width, _height);
 
+		if (Bindless::IsEnabled()) bindless.Texture = Bindless::Register(textureImage);
+
 		shader = _shader;
 
 		CreateDescriptorsLayout();
@@ -108,24 +117,10 @@ namespace HAL::GPU::Vulkan
 	}
 
 	template<typename VertexType>
-	void TModelRenderable<VertexType>::RecordRender(u32 _index, const CommandBuffer& _commandBuffer, const PipelineLayout& _pipelineLayout)
+	void TModelRenderable<VertexType>::RecordRender(UniformArena& _uniforms, const CommandBuffer& _commandBuffer, const PipelineLayout& _pipelineLayout)
 	{
-		unbound DynamicArray<Buffer::Handle> handles;
-
-		if (handles.empty())
-		{
-			Buffer::Handle handle = vertBuffer.GetBuffer();
-
-			handles.push_back(handle);
-		}
-
-		DeviceSize offsets = 0;
-
-		_commandBuffer.BindVertexBuffers(0, 1, handles.data(), &offsets);
-
-		_commandBuffer.BindIndexBuffer(indexBuffer.GetBuffer(), 0, EIndexType::uInt32);
-
-		uniformBuffers[_index].Write(uniformData.data());
+		// The geometry pool is bound by the render context.
+		u32 uniformOffset = _uniforms.Push(uniformData.data(), uniformData.size());
 
 		_commandBuffer.BindDescriptorSets
 		(
@@ -133,17 +128,30 @@ namespace HAL::GPU::Vulkan
 			_pipelineLayout,
 			0,
 			1,
-			descriptors[_index]
-		);
-
-		_commandBuffer.DrawIndexed
-		(
-			SCast<u32>(indexBuffer.GetSize()),
+			descriptors[0],
 			1,
-			0,
-			0,
-			0
+			&uniformOffset
 		);
+
+		if (Bindless::IsEnabled()) Bindless::Push(_commandBuffer, _pipelineLayout, bindless);
+
+		if (update == EBufferUpdate::Static)
+		{
+			Geometry::Draw(_commandBuffer, geometry);
+
+			return;
+		}
+
+		// From the device copy of the vertices picked by the last flush.
+		Buffer::Handle handle = dynamicVertices.GetBuffer();
+
+		DeviceSize offset = dynamicVertices.GetOffset();
+
+		_commandBuffer.BindVertexBuffers(0, 1, &handle, &offset);
+
+		_commandBuffer.BindIndexBuffer(dynamicIndices.GetBuffer(), 0, EIndexType::uInt32);
+
+		_commandBuffer.DrawIndexed(dynamicIndices.GetSize(), 1, 0, 0, 0);
 	}
 
 	template<typename VertexType>
@@ -186,6 +194,12 @@ namespace HAL::GPU::Vulkan
 		return shader;
 	}
 
+	template<typename VertexType>
+	u32 TModelRenderable<VertexType>::GetGeometryPool() const
+	{
+		return geometry.Pool;
+	}
+
 	template<typename VertexType>
 	ptr<const DescriptorSetLayout> TModelRenderable<VertexType>::GetDescriptorsLayout() const
 	{
@@ -193,37 +207,29 @@ namespace HAL::GPU::Vulkan
 	}
 
 	template<typename VertexType>
-	void TModelRenderable<VertexType>::CreateDescriptorSets(u32 _count, const DescriptorPool& _descriptorPool)
+	void TModelRenderable<VertexType>::CreateDescriptorSets(const DescriptorPool& _descriptorPool, const UniformArena& _uniforms)
 	{
-		uniformBuffers.resize(_count);
-
-		for (auto& uniformBuffer : uniformBuffers)
-		{
-			uniformBuffer.Create(shader->GetUniformSize());
-		}
-
-		DynamicArray<DescriptorSetLayout::Handle> layouts (_count, descriptorsLayout);
+		DescriptorSetLayout::Handle layout = descriptorsLayout;
 
 		DescriptorPool::AllocateInfo allocInfo;
 
 		allocInfo.DescriptorPool     = _descriptorPool;
-		allocInfo.DescriptorSetCount = _count;
-		allocInfo.SetLayouts         = layouts.data();
+		allocInfo.DescriptorSetCount = 1;
+		allocInfo.SetLayouts         = &layout;
 
 		if (_descriptorPool.Allocate(allocInfo, descriptors) != EResult::Success)
 		{
 			throw RuntimeError("Failed to allocate descriptor sets.");
 		}
 
-		for (uDM index = 0; index < _count; index++)
+		for (uDM index = 0; index < descriptors.size(); index++)
 		{
 			DescriptorSet::BufferInfo bufferInfo;
 
-			auto& buffer = uniformBuffers[index].GetBuffer();
-
-			bufferInfo.Buffer = buffer;
-			bufferInfo.Offset = 0      ;
-			bufferInfo.Range  = buffer.GetSize();
+			// Where the uniforms are in the arena is given by the dynamic offset when bound.
+			bufferInfo.Buffer = _uniforms.GetBuffer();
+			bufferInfo.Offset = 0                       ;
+			bufferInfo.Range  = shader->GetUniformSize();
 
 
 			DescriptorSet::ImageInfo imageInfo{};
@@ -235,12 +241,15 @@ namespace HAL::GPU::Vulkan
 
 			StaticArray<DescriptorSet::Write, 2> descriptorWrites;
 
+			// The texture is in the descriptor arrays instead.
+			u32 writeCount = Bindless::IsEnabled() ? 1 : 2;
+
 			descriptorWrites[0].DstSet          = descriptors[index];
 			descriptorWrites[0].DstBinding      = 0                    ;
 			descriptorWrites[0].DstArrayElement = 0                    ;
 
-			descriptorWrites[0].DescriptorType  = EDescriptorType::UniformBuffer;
-			descriptorWrites[0].DescriptorCount = 1                             ;
+			descriptorWrites[0].DescriptorType  = EDescriptorType::UniformBufferDynamic;
+			descriptorWrites[0].DescriptorCount = 1                                    ;
 
 			descriptorWrites[0].BufferInfo      = &bufferInfo;
 			descriptorWrites[0].ImageInfo       = nullptr    ; // Optional
@@ -257,7 +266,35 @@ namespace HAL::GPU::Vulkan
 			descriptorWrites[1].ImageInfo       = &imageInfo; // Optional
 			descriptorWrites[1].TexelBufferView = nullptr   ; // Optional
 
-			descriptors[index].Update(SCast<u32>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);	
+			descriptors[index].Update(writeCount, descriptorWrites.data(), 0, nullptr);	
+		}
+	}
+
+	template<typename VertexType>
+	void TModelRenderable<VertexType>::RebindUniforms(const UniformArena& _uniforms)
+	{
+		DescriptorSet::BufferInfo bufferInfo;
+
+		bufferInfo.Buffer = _uniforms.GetBuffer();
+		bufferInfo.Offset = 0                       ;
+		bufferInfo.Range  = shader->GetUniformSize();
+
+		for (auto& descriptor : descriptors)
+		{
+			DescriptorSet::Write write;
+
+			write.DstSet          = descriptor;
+			write.DstBinding      = 0         ;
+			write.DstArrayElement = 0         ;
+
+			write.DescriptorType  = EDescriptorType::UniformBufferDynamic;
+			write.DescriptorCount = 1                                    ;
+
+			write.BufferInfo      = &bufferInfo;
+			write.ImageInfo       = nullptr    ;
+			write.TexelBufferView = nullptr    ;
+
+			descriptor.Update(1, &write, 0, nullptr);
 		}
 	}
 
@@ -271,6 +308,76 @@ namespace HAL::GPU::Vulkan
 		uniformData.assign(_dataBytes, endAddress);
 	}
 
+	template<typename VertexType>
+	void TModelRenderable<VertexType>::ReplaceGeometry(const DynamicArray<VertexType>& _verticies, const DynamicArray<u32>& _indicies)
+	{
+		if (update != EBufferUpdate::Static) throw RuntimeError("TModelRenderable: Geometry replaced on a dynamic renderable.");
+
+		GeometryRange previous = geometry;
+
+		geometry = Geometry::Allocate(_verticies, _indicies);
+
+		Geometry::Free(previous);
+	}
+
+	template<typename VertexType>
+	void TModelRenderable<VertexType>::WriteVertices(DeviceSize _first, ptr<const VertexType> _vertices, DeviceSize _count)
+	{
+		dynamicVertices.Write(_first, _vertices, _count);
+	}
+
+	template<typename VertexType>
+	void TModelRenderable<VertexType>::Flush()
+	{
+		dynamicVertices.Flush();
+	}
+
+	template<typename VertexType>
+	void TModelRenderable<VertexType>::ReplaceTexture(ptr<const u8> _textureData, u32 _width, u32 _height)
+	{
+		GPU_Comms::GetEngagedDevice().WaitUntilIdle();
+
+		if (Bindless::IsEnabled()) Bindless::Release_Texture(bindless.Texture);
+
+		textureImage.Destroy();
+
+		textureImage.Create(_textureData, _width, _height);
+
+		if (Bindless::IsEnabled())
+		{
+			bindless.Texture = Bindless::Register(textureImage);
+
+			return;
+		}
+
+		// Not yet added to a render context, the sets are written with the new texture when they are.
+		if (descriptors.empty()) return;
+
+		DescriptorSet::ImageInfo imageInfo{};
+
+		imageInfo.ImageLayout = EImageLayout::Shader_ReadonlyOptimal;
+		imageInfo.ImageView   = textureImage.GetView();
+		imageInfo.Sampler     = textureImage.GetSampler();
+
+		for (auto& descriptor : descriptors)
+		{
+			DescriptorSet::Write write;
+
+			write.DstSet          = descriptor;
+			write.DstBinding      = 1         ;
+			write.DstArrayElement = 0         ;
+
+			write.DescriptorType  = EDescriptorType::CombinedImageSampler;
+			write.DescriptorCount = 1                                    ;
+
+			write.BufferInfo      = nullptr   ;
+			write.ImageInfo       = &imageInfo;
+			write.TexelBufferView = nullptr   ;
+
+			descriptor.Update(1, &write, 0, nullptr);
+		}
+	}
+
 	// Private
 
 	template<typename VertexType>
@@ -279,7 +386,7 @@ namespace HAL::GPU::Vulkan
 		DescriptorSetLayout::Binding uboLayoutBinding;
 
 		uboLayoutBinding.BindingID = 0;
-		uboLayoutBinding.Type      = EDescriptorType::UniformBuffer;
+		uboLayoutBinding.Type      = EDescriptorType::UniformBufferDynamic;
 		uboLayoutBinding.Count     = 1;
 
 		uboLayoutBinding.StageFlags = EShaderStageFlag::Vertex;
@@ -301,7 +408,8 @@ namespace HAL::GPU::Vulkan
 
 		DescriptorSetLayout::CreateInfo layoutInfo;
 
-		layoutInfo.BindingCount = SCast<ui32>(bindings.size());
+		// With the descriptor arrays the sampler is selected by index, only the uniforms stay in the set.
+		layoutInfo.BindingCount = Bindless::IsEnabled() ? 1 : SCast<ui32>(bindings.size());
 		layoutInfo.Bindings     = bindings.data();
 
 		if (descriptorsLayout.Create(GPU_Comms::GetEngagedDevice(), layoutInfo) != EResult::Success)
@@ -3,9 +3,14 @@
 
 
 
-#include "Core/IO/Basic_FileIO.hpp"
+#include "Core/IO/DerivedDataCache.hpp"
+#include "Core/IO/FileWatcher.hpp"
+#include "Core/IO/VFS.hpp"
+#include "GPUVK_Rendering.hpp"
 #include "HAL_Backend.hpp"
 
+#include <cstring>
+
 
 
 namespace HAL::GPU::Vulkan
@@ -26,6 +31,21 @@ namespace HAL::GPU::Vulkan
 
 #pragma region BasicShader
 
+	// Private
+
+	StaticData()
+
+		// Created shaders, recompiled when one of their sources changes.
+		DynamicArray< ptr<BasicShader>> Watched;
+
+		Core::IO::SubscriptionID SourceChanges = 0;
+
+	void CreateModule(const SPIR_V::Bytecode_Buffer& _bytecode, ShaderModule& _module);
+
+	void Reload_ChangedShaders(const DynamicArray<Core::IO::FileChange>& _changes);
+
+	// Public
+
 	BasicShader::BasicShader()
 	{
 	}
@@ -43,83 +63,165 @@ namespace HAL::GPU::Vulkan
 
 	void BasicShader::Create(const Path& _vertShader, const Path& _fragShader)
 	{
-		EResult result;
-
-		ShaderModule::CreateInfo info;
-
-		SPIR_V::Bytecode_Buffer bytecode;
-
-		// Vertex
-
-		auto& vertexModule = shaderModules    [0];
-		auto& vertexStage  = shaderStageInfos [0];
+		SPIR_V::Bytecode_Buffer bytecode[2];
 
 		glslang::InitializeProcess();
 
-		if (! SPIR_V::CompileGLSL(_vertShader, EShaderStageFlag::Vertex, bytecode))
+		if (! SPIR_V::CompileGLSL(_vertShader, EShaderStageFlag::Vertex  , bytecode[0]) ||
+			! SPIR_V::CompileGLSL(_fragShader, EShaderStageFlag::Fragment, bytecode[1]))
 		{
 			throw RuntimeError("Failed to compile GLSL to SPIR-V");
 		}
 
-		info.CodeSize = bytecode.size() * sizeof(u32);
-		info.Code     = bytecode.data();
+		glslang::FinalizeProcess();
+
+		CreateModule(bytecode[0], shaderModules[0]);
+		CreateModule(bytecode[1], shaderModules[1]);
+
+		sources[0] = _vertShader;
+		sources[1] = _fragShader;
 
-		if (vertexModule.Create(GPU_Comms::GetEngagedDevice(), info) != EResult::Success)
+		shaderStageInfos.resize(2);
+
+		shaderStageInfos[0].Module = shaderModules[0];
+		shaderStageInfos[0].Stage  = EShaderStageFlag::Vertex;
+
+		shaderStageInfos[1].Module = shaderModules[1];
+		shaderStageInfos[1].Stage  = EShaderStageFlag::Fragment;
+
+		if (std::find(Watched.begin(), Watched.end(), this) == Watched.end()) Watched.push_back(this);
+
+		if (SourceChanges == 0) SourceChanges = Core::IO::FileWatcher_Subscribe(Reload_ChangedShaders);
+	}
+
+	void BasicShader::Create(const Path& _vertShader, const Path& _fragShader, DeviceSize _size)
+	{
+		Create(_vertShader, _fragShader);
+
+		uboSize = _size;
+	}
+
+	void BasicShader::Destroy()
+	{
+		Watched.erase(std::remove(Watched.begin(), Watched.end(), this), Watched.end());
+
+		if (Watched.empty() && SourceChanges != 0)
 		{
-			throw RuntimeError("Failed to create vertex shader module.");
+			Core::IO::FileWatcher_Unsubscribe(SourceChanges);
+
+			SourceChanges = 0;
 		}
 
-		bytecode.clear();
+		if (shaderStageInfos.empty()) return;
 
-		vertexStage.Module = vertexModule;
-		vertexStage.Stage  = EShaderStageFlag::Vertex;
+		shaderModules[0].Destroy();
+		shaderModules[1].Destroy();
 
+		shaderStageInfos.clear();
+	}
 
-		// Fragment
+	bool BasicShader::Reload()
+	{
+		SPIR_V::Bytecode_Buffer bytecode[2];
 
-		auto& fragModule = shaderModules   [1];
-		auto& fragStage  = shaderStageInfos[1];
+		bool compiled = false;
+
+		glslang::InitializeProcess();
 
-		if (!SPIR_V::CompileGLSL(_fragShader, EShaderStageFlag::Fragment, bytecode))
+		try
 		{
-			throw RuntimeError("Failed to compile GLSL to SPIR-V");
+			compiled =
+				SPIR_V::CompileGLSL(sources[0], EShaderStageFlag::Vertex  , bytecode[0]) &&
+				SPIR_V::CompileGLSL(sources[1], EShaderStageFlag::Fragment, bytecode[1]);
+		}
+		catch (std::exception& _error)
+		{
+			// Removed or unreadable while it was being saved.
+			Log_Error(String(_error.what()));
 		}
 
-		info.CodeSize = bytecode.size() * sizeof(u32);
-		info.Code     = bytecode.data();
+		glslang::FinalizeProcess();
 
-		if (fragModule.Create(GPU_Comms::GetEngagedDevice(), info) != EResult::Success)
+		if (!compiled)
 		{
-			throw RuntimeError("Failed to create fragment shader module.");
+			Log_Error("Shader reload failed, keeping the previous modules: " + sources[0].generic_string() + ", " + sources[1].generic_string());
+
+			return false;
 		}
 
-		bytecode.clear();
-		
-		fragStage.Module = fragModule;
-		fragStage.Stage  = EShaderStageFlag::Fragment;
+		ShaderModule modules[2];
 
+		CreateModule(bytecode[0], modules[0]);
+		CreateModule(bytecode[1], modules[1]);
 
-		glslang::FinalizeProcess();
+		// The pipelines only need the modules while they are created.
+		for (u32 stage = 0; stage < 2; stage++)
+		{
+			shaderModules[stage].Destroy();
+
+			shaderModules   [stage]        = modules[stage];
+			shaderStageInfos[stage].Module = shaderModules[stage];
+		}
+
+		Rendering::Rebuild_Pipelines(*this);
+
+		Log("Shader reloaded: " + sources[0].generic_string() + ", " + sources[1].generic_string());
+
+		return true;
 	}
 
-	void BasicShader::Create(const Path& _vertShader, const Path& _fragShader, DeviceSize _size)
+	bool BasicShader::UsesSource(StringView _virtualPath) const
 	{
-		Create(_vertShader, _fragShader);
+		for (auto& source : sources)
+		{
+			if (!source.empty() && Core::IO::PackNormalizePath(source.generic_string()) == _virtualPath) return true;
+		}
 
-		uboSize = _size;
+		return false;
 	}
 
 	using ShaderStageInfo = BasicShader::ShaderStageInfo;
 
 	const DynamicArray<ShaderStageInfo>& BasicShader::GetShaderStageInfos() const
 	{
-		unbound DynamicArray<ShaderStageInfo> shaderStagesExport =
+		// A member, pipelines are matched to their shader by the address of its stages.
+		return shaderStageInfos;
+	}
+
+	// Private
+
+	void CreateModule(const SPIR_V::Bytecode_Buffer& _bytecode, ShaderModule& _module)
+	{
+		ShaderModule::CreateInfo info;
+
+		info.CodeSize = _bytecode.size() * sizeof(u32);
+		info.Code     = _bytecode.data();
+
+		if (_module.Create(GPU_Comms::GetEngagedDevice(), info) != EResult::Success)
+		{
+			throw RuntimeError("Failed to create shader module.");
+		}
+	}
+
+	void Reload_ChangedShaders(const DynamicArray<Core::IO::FileChange>& _changes)
+	{
+		DynamicArray< ptr<BasicShader>> changed;
+
+		for (auto& change : _changes)
 		{
-			shaderStageInfos[0],
-			shaderStageInfos[1]
-		};
+			String virtualPath;
+
+			if (!Core::IO::VFS_ToVirtualPath(change.File, virtualPath)) continue;
+
+			for (auto shader : Watched)
+			{
+				if (shader->UsesSource(virtualPath) && std::find(changed.begin(), changed.end(), shader) == changed.end())
+					changed.push_back(shader);
+			}
+		}
 
-		return shaderStagesExport;
+		// Once per shader for the whole batch, a pair saved together is compiled once.
+		for (auto shader : changed) shader->Reload();
 	}
 
 #pragma endregion BasicShader
@@ -264,9 +366,8 @@ namespace HAL::GPU::Vulkan
 				doneOnce = true;
 			}
 
-			auto shaderCode = Core::IO::BufferFile(_path);
-
-			shaderCode.push_back('\0');
+			// Virtual path, packed shaders compile like loose ones. The length is passed so no terminated copy is needed.
+			DynamicArray<u8> shaderCode = Core::IO::VFS_Read(_path.generic_string());
 
 			MessageFlags messageOptions;
 
@@ -274,6 +375,22 @@ namespace HAL::GPU::Vulkan
 
 			EShMessages messages = (EShMessages)(EShMsgSpvRules | EShMsgVulkanRules);
 
+			// Keyed by the source, the stage and the compile settings. Included sources are not tracked (none are used yet).
+			Core::IO::DerivedDataKey cacheKey("SPIR-V", 1);
+
+			cacheKey.Add(shaderCode.data(), shaderCode.size()).AddValue(_type).AddValue(messages).AddValue(Hardcoded_Resource);
+
+			DynamicArray<u8> cached;
+
+			if (Core::IO::DDC_Get(cacheKey, cached))
+			{
+				_bytecode.resize(cached.size() / sizeof(_bytecode[0]));
+
+				memcpy(_bytecode.data(), cached.data(), _bytecode.size() * sizeof(_bytecode[0]));
+
+				return true;
+			}
+
 			EStage stage = GetStageType(_type);
 
 			UPtr<LinkerUnit> linker = MakeUPtr<LinkerUnit>();
@@ -281,10 +398,12 @@ namespace HAL::GPU::Vulkan
 			UPtr<ShaderUnit> shader = MakeUPtr<ShaderUnit>( EShLanguage(stage));
 
 			RoCStr strings[numShaders];
+			int    lengths[numShaders];
 			
-			strings[0] = shaderCode.data();
+			strings[0] = RCast<const char>(shaderCode.data());
+			lengths[0] = int(shaderCode.size());
 
-			shader->setStrings(strings, numShaders);
+			shader->setStringsWithLengths(strings, lengths, numShaders);
 
 			if (! shader->parse(getPtr(Hardcoded_Resource), 100, false, 
 				//(EShMessages)u32(messageOptions)))
@@ -308,6 +427,8 @@ namespace HAL::GPU::Vulkan
 
 			glslang::GlslangToSpv(dref(linker->getIntermediate( EShLanguage(stage))), _bytecode);
 
+			Core::IO::DDC_Put(cacheKey, _bytecode.data(), _bytecode.size() * sizeof(_bytecode[0]));
+
 			return true;
 		}
 	}
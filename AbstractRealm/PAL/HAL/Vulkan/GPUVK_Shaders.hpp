@@ -37,7 +37,12 @@ namespace HAL::GPU::Vulkan
 		virtual DeviceSize GetUniformSize() const = NULL;
 	};
 
-	// Supports only vertex and fragment shader pair.
+	/*
+	Supports only vertex and fragment shader pair.
+
+	A created shader is recompiled when one of its sources changes on disk (see the file watcher), and the
+	pipelines built from it are rebuilt. A source that fails to compile keeps the previous modules.
+	*/
 	class BasicShader : public AShader
 	{
 	public:
@@ -46,6 +51,11 @@ namespace HAL::GPU::Vulkan
 		 BasicShader(const Path& _vertShader, const Path& _fragShader, DeviceSize _uniformSize);
 		~BasicShader();
 
+		// Watched for changes by address.
+		BasicShader(const BasicShader&) = delete;
+
+		BasicShader& operator=(const BasicShader&) = delete;
+
 		 // Mitigating stuff...
 		 
 
@@ -53,7 +63,18 @@ namespace HAL::GPU::Vulkan
 
 		void Create(const Path& _vertShader, const Path& _fragShader, DeviceSize _uniformSize);
 
-		//void Destroy();
+		/*
+		Destroys the modules and stops watching the sources. The pipelines built from it are not affected.
+		*/
+		void Destroy();
+
+		/*
+		Recompiles both stages and rebuilds the pipelines using them, waits for the device to be idle.
+		Returns false, keeping the current modules, if a stage fails to compile.
+		*/
+		bool Reload();
+
+		bool UsesSource(StringView _virtualPath) const;
 
 		const DynamicArray<ShaderStageInfo>& GetShaderStageInfos() const override;
 
@@ -62,8 +83,11 @@ namespace HAL::GPU::Vulkan
 
 	protected:
 
-		ShaderModule    shaderModules[2];
-		ShaderStageInfo shaderStageInfos[2];   // One for vertex and for fragment.
+		Path sources[2];   // Virtual paths.
+
+		ShaderModule shaderModules[2];
+
+		DynamicArray<ShaderStageInfo> shaderStageInfos;   // One for vertex and for fragment.
 
 		DeviceSize uboSize = 0;
 	};
@@ -143,7 +167,7 @@ namespace HAL::GPU::Vulkan
 			ptr<LinkerUnit> linker;
 		};*/
 
-		// Compiles GLSL to SPIR-V Bytecode.
+		// Compiles GLSL to SPIR-V Bytecode, _path is a virtual (VFS) path.
 		// Note this is hardcoded to only link one shader for now.
 		bool CompileGLSL(const Path& _path, const EShaderStageFlag _type, Bytecode_Buffer& _bytecode);
 	}
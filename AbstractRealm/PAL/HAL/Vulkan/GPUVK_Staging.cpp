@@ -0,0 +1,481 @@
+// Parent Header
+#include "GPUVK_Staging.hpp"
+
+
+
+#include "GPUVK_Barriers.hpp"
+
+
+
+
+namespace HAL::GPU::Vulkan
+{
+	// Private
+
+	/*
+	A one off staging buffer for an upload too large for the ring, released with its batch.
+	*/
+	struct OversizedStaging
+	{
+		Buffer           Source    ;
+		MemoryAllocation Allocation;
+	};
+
+	struct StagingBatch
+	{
+		ptr<CommandPool>         Pool     = nullptr;
+		ptr<const CommandBuffer> Commands = nullptr;
+
+		// Graphics side of the batch, only used with a dedicated transfer queue.
+		ptr<CommandPool>         AcquirePool = nullptr;
+		ptr<const CommandBuffer> Acquire     = nullptr;
+
+		Semaphore Copied;   // Signaled by the transfer queue, waited on by the acquire.
+		Fence     Done  ;
+
+		bool Recording = false;
+		bool InFlight  = false;
+
+		DeviceSize Bytes = 0;   // Ring space held until the batch completes.
+
+		BarrierBatch Releases;   // Ownership releases at the end of the copies.
+		BarrierBatch Barriers;   // Visibility for the graphics queue, the acquires when the copies ran elsewhere.
+
+		DynamicArray<OversizedStaging> Oversized;
+	};
+
+	struct StagedData
+	{
+		ptr<const Buffer> Source;
+		DeviceSize        Offset;
+	};
+
+	// Buffer to image copies need offsets aligned to the texel size, 16 covers every color format.
+	constexpr DeviceSize CopyAlignment = 16;
+
+	StaticData()
+
+		Buffer           Ring      ;
+		MemoryAllocation RingMemory;
+
+		DeviceSize RingSize = 0;
+		DeviceSize Head     = 0;   // Next byte written.
+		DeviceSize Used     = 0;   // Bytes held by recorded and in flight batches, including skipped tails.
+
+		// Used in order, so the ring space of the oldest batch is always the next to be released.
+		DynamicArray<StagingBatch> Batches;
+
+		uDM Current = 0;
+
+		bool Dedicated = false;   // Copies go through the transfer queue.
+
+		u32 TransferFamily = 0;
+		u32 GraphicsFamily = 0;
+
+
+
+	// Forwards
+
+	StagedData Stage(ptr<const void> _data, DeviceSize _size);
+
+	void Begin(StagingBatch& _batch);
+
+	void Retire(StagingBatch& _batch);
+
+	void RetireOldest();
+
+
+
+	// Public
+
+	void Staging_Maker<Meta::EGPU_Engage::Single>::Prepare()
+	{
+		RingSize = Meta::GPU_StagingSize;
+
+		Buffer::CreateInfo info {};
+
+		info.Size        = RingSize;
+		info.SharingMode = ESharingMode::Exclusive;
+
+		info.Usage.Set(EBufferUsage::TransferSource);
+
+		if (Ring.Create(GPU_Comms::GetEngagedDevice(), info) != EResult::Success)
+			throw RuntimeError("Failed to create the staging ring.");
+
+		EResult result = AllocateMemory
+		(
+			Ring.GetMemoryRequirements(),
+			Memory::PropertyFlags(EMemoryPropertyFlag::HostVisible, EMemoryPropertyFlag::HostCoherent),
+			EResourceTiling::Linear,
+			RingMemory
+		);
+
+		if (result != EResult::Success)
+			throw RuntimeError("Failed to allocate the staging ring.");
+
+		Ring.BindMemory(RingMemory.GetMemory(), RingMemory.Offset);
+
+		// Mapped now so the first upload does not pay for it.
+		RingMemory.GetMapped();
+
+		Dedicated = GPU_Comms::HasDedicatedTransfer();
+
+		GraphicsFamily = GPU_Comms::GetGraphicsQueue().GetFamilyIndex();
+		TransferFamily = Dedicated ? GPU_Comms::GetTransferQueue().GetFamilyIndex() : GraphicsFamily;
+
+		Batches.resize(Meta::GPU_StagingBatches);
+
+		for (auto& batch : Batches)
+		{
+			batch.Pool     = Deck::RequestCommandPools(1, Dedicated ? EQueueFlag::Transfer : EQueueFlag::Graphics);
+			batch.Commands = &batch.Pool->RequestBuffer();
+
+			if (Dedicated)
+			{
+				batch.AcquirePool = Deck::RequestCommandPools(1);
+				batch.Acquire     = &batch.AcquirePool->RequestBuffer();
+
+				Semaphore::CreateInfo semaphoreInfo;
+
+				batch.Copied.Create(GPU_Comms::GetEngagedDevice(), semaphoreInfo);
+			}
+
+			Fence::CreateInfo fenceInfo;
+
+			batch.Done.Create(GPU_Comms::GetEngagedDevice(), fenceInfo);
+		}
+
+		Head    = 0;
+		Used    = 0;
+		Current = 0;
+	}
+
+	void Staging_Maker<Meta::EGPU_Engage::Single>::Wipe()
+	{
+		WaitForUploads();
+
+		for (auto& batch : Batches)
+		{
+			if (Dedicated) batch.Copied.Destroy();
+
+			batch.Done.Destroy();
+		}
+
+		// The command pools are destroyed with the deck.
+		Batches.clear();
+
+		Ring.Destroy();
+
+		FreeMemory(RingMemory);
+	}
+
+	void Staging_Maker<Meta::EGPU_Engage::Single>::Upload(const Buffer& _destination, DeviceSize _offset, ptr<const void> _data, DeviceSize _size)
+	{
+		if (_size == 0) return;
+
+		StagedData staged = Stage(_data, _size);
+
+		const CommandBuffer& commands = Record();
+
+		Buffer::CopyInfo copyInfo {};
+
+		copyInfo.SourceOffset      = staged.Offset;
+		copyInfo.DestinationOffset = _offset      ;
+		copyInfo.Size              = _size        ;
+
+		commands.CopyBuffer(dref(staged.Source), _destination, 1, &copyInfo);
+
+		Buffer::Memory_Barrier barrier {};
+
+		barrier.SrcQueueFamilyIndex = QueueFamily_Ignored;
+		barrier.DstQueueFamilyIndex = QueueFamily_Ignored;
+
+		barrier.Buffer = _destination;
+		barrier.Offset = _offset     ;
+		barrier.Size   = _size       ;
+
+		barrier.SrcAccessMask.Set(EAccessFlag::TransferWrite);
+		// Transfers as well: the defragmenter copies the buffers and later uploads rewrite them.
+		barrier.DstAccessMask.Set
+		(
+			EAccessFlag::VertexAttributeRead, EAccessFlag::IndexRead, EAccessFlag::UniformRead, EAccessFlag::ShaderRead,
+			EAccessFlag::TransferRead, EAccessFlag::TransferWrite
+		);
+
+		if (Dedicated)
+		{
+			// The same barrier releases and acquires, each side ignores the access mask of the other.
+			barrier.SrcQueueFamilyIndex = TransferFamily;
+			barrier.DstQueueFamilyIndex = GraphicsFamily;
+
+			Batches[Current].Releases.Add(barrier, EPipelineStageFlag::Transfer, EPipelineStageFlag::BottomOfPipe);
+		}
+
+		Batches[Current].Barriers.Add
+		(
+			barrier,
+			Dedicated ? EPipelineStageFlag::TopOfPipe : EPipelineStageFlag::Transfer,
+			Pipeline::StageFlags(EPipelineStageFlag::VertexInput, EPipelineStageFlag::VertexShader, EPipelineStageFlag::FragementShader, EPipelineStageFlag::Transfer)
+		);
+	}
+
+	void Staging_Maker<Meta::EGPU_Engage::Single>::Upload(const Image& _destination, CommandBuffer::BufferImageRegion _region, ptr<const void> _data, DeviceSize _size)
+	{
+		StagedData staged = Stage(_data, _size);
+
+		const CommandBuffer& commands = Record();
+
+		_region.BufferOffset = staged.Offset;
+
+		commands.CopyBufferToImage(dref(staged.Source), _destination, EImageLayout::TransferDestination_Optimal, 1, &_region);
+
+		if (!Dedicated) return;
+
+		// The whole image goes to the graphics queue, its mipmaps are generated there.
+		Image::Memory_Barrier barrier {};
+
+		barrier.OldLayout = EImageLayout::TransferDestination_Optimal;
+		barrier.NewLayout = EImageLayout::TransferDestination_Optimal;
+
+		barrier.SrcQueueFamilyIndex = TransferFamily;
+		barrier.DstQueueFamilyIndex = GraphicsFamily;
+
+		barrier.Image = _destination;
+
+		barrier.SubresourceRange.AspectMask.Set(EImageAspect::Color);
+
+		barrier.SubresourceRange.BaseMipLevel   = 0                              ;
+		barrier.SubresourceRange.LevelCount     = _destination.GetMipmapLevels();
+		barrier.SubresourceRange.BaseArrayLayer = 0                              ;
+		barrier.SubresourceRange.LayerCount     = 1                              ;
+
+		barrier.SrcAccessMask.Set(EAccessFlag::TransferWrite);
+		barrier.DstAccessMask.Set(EAccessFlag::TransferRead, EAccessFlag::TransferWrite, EAccessFlag::ShaderRead);
+
+		Batches[Current].Releases.Add(barrier, EPipelineStageFlag::Transfer, EPipelineStageFlag::BottomOfPipe);
+
+		// Recorded now so it precedes whatever is recorded after the upload.
+		Batches[Current].Acquire->SubmitPipelineBarrier
+		(
+			EPipelineStageFlag::TopOfPipe,
+			Pipeline::StageFlags(EPipelineStageFlag::Transfer, EPipelineStageFlag::FragementShader),
+			0,
+			1, &barrier
+		);
+	}
+
+	const CommandBuffer& Staging_Maker<Meta::EGPU_Engage::Single>::Record()
+	{
+		StagingBatch& batch = Batches[Current];
+
+		if (!batch.Recording) Begin(batch);
+
+		return dref(batch.Commands);
+	}
+
+	const CommandBuffer& Staging_Maker<Meta::EGPU_Engage::Single>::RecordAfterUpload()
+	{
+		StagingBatch& batch = Batches[Current];
+
+		if (!batch.Recording) Begin(batch);
+
+		return Dedicated ? dref(batch.Acquire) : dref(batch.Commands);
+	}
+
+	void Staging_Maker<Meta::EGPU_Engage::Single>::Submit()
+	{
+		StagingBatch& batch = Batches[Current];
+
+		if (!batch.Recording) return;
+
+		batch.Releases.Flush(dref(batch.Commands));
+
+		// Makes the copies visible to whatever is submitted after the batch on the graphics queue.
+		batch.Barriers.Flush(Dedicated ? dref(batch.Acquire) : dref(batch.Commands));
+
+		if (batch.Commands->EndRecord() != EResult::Success)
+			throw RuntimeError("Failed to end the staging batch.");
+
+		CommandBuffer::SubmitInfo submitInfo;
+
+		submitInfo.CommandBufferCount = 1;
+		submitInfo.CommandBuffers     = dref(batch.Commands);
+
+		if (Dedicated)
+		{
+			submitInfo.SignalSemaphoreCount = 1           ;
+			submitInfo.SignalSemaphores     = batch.Copied;
+
+			if (GPU_Comms::GetTransferQueue().SubmitToQueue(1, submitInfo, Null<Fence::Handle>) != EResult::Success)
+				throw RuntimeError("Failed to submit the staging batch to the transfer queue.");
+
+			if (batch.Acquire->EndRecord() != EResult::Success)
+				throw RuntimeError("Failed to end the staging acquire.");
+
+			// The acquires start with the wait, nothing on the graphics queue before them is held back.
+			Pipeline::StageFlags waitStage(EPipelineStageFlag::Transfer, EPipelineStageFlag::VertexInput, EPipelineStageFlag::VertexShader, EPipelineStageFlag::FragementShader);
+
+			submitInfo = CommandBuffer::SubmitInfo();
+
+			submitInfo.WaitSemaphoreCount = 1           ;
+			submitInfo.WaitSemaphores     = batch.Copied;
+			submitInfo.WaitDstStageMask   = &waitStage  ;
+
+			submitInfo.CommandBufferCount = 1;
+			submitInfo.CommandBuffers     = dref(batch.Acquire);
+		}
+
+		batch.Done.Reset();
+
+		if (GPU_Comms::GetGraphicsQueue().SubmitToQueue(1, submitInfo, batch.Done) != EResult::Success)
+			throw RuntimeError("Failed to submit the staging batch.");
+
+		batch.Recording = false;
+		batch.InFlight  = true ;
+
+		Current = (Current + 1) % Batches.size();
+	}
+
+	void Staging_Maker<Meta::EGPU_Engage::Single>::WaitForUploads()
+	{
+		Submit();
+
+		for (auto& batch : Batches)
+		{
+			if (batch.InFlight) Retire(batch);
+		}
+	}
+
+
+
+	// Private
+
+	StagedData Stage(ptr<const void> _data, DeviceSize _size)
+	{
+		if (_size > RingSize / 2)
+		{
+			// Would stall the ring for everything else, gets a buffer of its own.
+			OversizedStaging staging;
+
+			Buffer::CreateInfo info {};
+
+			info.Size        = _size;
+			info.SharingMode = ESharingMode::Exclusive;
+
+			info.Usage.Set(EBufferUsage::TransferSource);
+
+			if (staging.Source.Create(GPU_Comms::GetEngagedDevice(), info) != EResult::Success)
+				throw RuntimeError("Failed to create an oversized staging buffer.");
+
+			EResult result = AllocateMemory
+			(
+				staging.Source.GetMemoryRequirements(),
+				Memory::PropertyFlags(EMemoryPropertyFlag::HostVisible, EMemoryPropertyFlag::HostCoherent),
+				EResourceTiling::Linear,
+				staging.Allocation
+			);
+
+			if (result != EResult::Success)
+				throw RuntimeError("Failed to allocate an oversized staging buffer.");
+
+			staging.Source.BindMemory(staging.Allocation.GetMemory(), staging.Allocation.Offset);
+
+			staging.Allocation.WriteToGPU(0, _size, _data);
+
+			StagingBatch& batch = Batches[Current];
+
+			if (!batch.Recording) Begin(batch);
+
+			batch.Oversized.push_back(staging);
+
+			return { getPtr(batch.Oversized.back().Source), 0 };
+		}
+
+		DeviceSize aligned = (Head + CopyAlignment - 1) / CopyAlignment * CopyAlignment;
+
+		DeviceSize offset = aligned + _size <= RingSize ? aligned : 0;
+
+		// What the write takes from the ring: alignment padding, or the tail skipped to wrap around.
+		DeviceSize consumed = offset == 0 && Head != 0 ? RingSize - Head + _size : offset - Head + _size;
+
+		while (Used + consumed > RingSize) RetireOldest();
+
+		StagingBatch& batch = Batches[Current];
+
+		if (!batch.Recording) Begin(batch);
+
+		RingMemory.WriteToGPU(offset, _size, _data);
+
+		Head = offset + _size;
+
+		Used        += consumed;
+		batch.Bytes += consumed;
+
+		return { getPtr(Ring), offset };
+	}
+
+	void Begin(StagingBatch& _batch)
+	{
+		// Its previous use must be done before the command buffer is recorded again.
+		if (_batch.InFlight) Retire(_batch);
+
+		_batch.Pool->Reset(0);
+
+		CommandBuffer::BeginInfo beginInfo;
+
+		beginInfo.Flags = ECommandBufferUsageFlag::OneTimeSubmit;
+
+		if (_batch.Commands->BeginRecord(beginInfo) != EResult::Success)
+			throw RuntimeError("Failed to begin the staging batch.");
+
+		if (Dedicated)
+		{
+			_batch.AcquirePool->Reset(0);
+
+			if (_batch.Acquire->BeginRecord(beginInfo) != EResult::Success)
+				throw RuntimeError("Failed to begin the staging acquire.");
+		}
+
+		_batch.Recording = true;
+	}
+
+	void Retire(StagingBatch& _batch)
+	{
+		_batch.Done.WaitFor(UInt64Max);
+
+		Used -= _batch.Bytes;
+
+		_batch.Bytes    = 0;
+		_batch.InFlight = false;
+
+		for (auto& staging : _batch.Oversized)
+		{
+			staging.Source.Destroy();
+
+			FreeMemory(staging.Allocation);
+		}
+
+		_batch.Oversized.clear();
+	}
+
+	void RetireOldest()
+	{
+		// Batches after the current one were submitted earliest.
+		for (uDM index = 1; index <= Batches.size(); index++)
+		{
+			StagingBatch& batch = Batches[(Current + index) % Batches.size()];
+
+			if (batch.InFlight)
+			{
+				Retire(batch);
+
+				return;
+			}
+		}
+
+		// Nothing in flight, the ring is held by the batch being recorded.
+		Staging::Submit();
+
+		RetireOldest();
+	}
+}
@@ -0,0 +1,79 @@
+/*
+Staging
+
+Host to device uploads through a persistently mapped ring buffer.
+
+Uploads are copied into the ring and their copies recorded into the current batch, a single command buffer
+submitted once per frame with a fence. The ring space of a batch is reused once its fence signals, so loading
+many resources costs one submission instead of a full queue stall each.
+
+When the device has a dedicated transfer queue the copies are submitted to it, so they overlap rendering.
+Ownership of the destinations is released by the transfer queue and acquired on the graphics queue by a
+second command buffer, which waits on the copies with a semaphore and signals the batch's fence.
+*/
+
+
+
+#pragma once
+
+
+
+#include "GPUVK_Resources.hpp"
+#include "GPUVK_PayloadDeck.hpp"
+
+
+
+namespace HAL::GPU::Vulkan
+{
+	template<Meta::EGPU_Engage>
+	class Staging_Maker;
+
+	template<>
+	class Staging_Maker<Meta::EGPU_Engage::Single>
+	{
+	public:
+
+		unbound void Prepare();
+
+		/*
+		Waits for the uploads in flight and releases the ring.
+		*/
+		unbound void Wipe();
+
+		/*
+		Copies _data into _destination at _offset.
+		The copy is visible to vertex input and shaders of anything submitted after the batch.
+		*/
+		unbound void Upload(const Buffer& _destination, DeviceSize _offset, ptr<const void> _data, DeviceSize _size);
+
+		/*
+		Copies _data into _destination, which must be in the transfer destination layout.
+		The region's buffer offset is filled in by the ring.
+		*/
+		unbound void Upload(const Image& _destination, CommandBuffer::BufferImageRegion _region, ptr<const void> _data, DeviceSize _size);
+
+		/*
+		The command buffer the copies of the current batch are recorded in, for the layout transitions that go with an upload.
+		May belong to the transfer queue: only transfer commands can be recorded in it.
+		*/
+		unbound const CommandBuffer& Record();
+
+		/*
+		A graphics queue command buffer executed once the copies of the current batch are done,
+		and the destinations acquired by the graphics queue. For work on the uploaded data, like blitting mipmaps.
+		*/
+		unbound const CommandBuffer& RecordAfterUpload();
+
+		/*
+		Submits the current batch. Called once per frame before rendering.
+		*/
+		unbound void Submit();
+
+		/*
+		Submits the current batch and blocks until every upload completed.
+		*/
+		unbound void WaitForUploads();
+	};
+
+	using Staging = Staging_Maker<Meta::GPU_Engagement>;
+}
@@ -9,12 +9,19 @@
 
 // Engine
 #include "HAL_Backend.hpp"
+#include "GPUVK_Bindless.hpp"
 #include "GPUVK_Comms.hpp"
+#include "GPUVK_Defragmenter.hpp"
+#include "GPUVK_Geometry.hpp"
 #include "GPUVK_PayloadDeck.hpp"
 #include "GPUVK_Pipeline.hpp"
 #include "GPUVK_Rendering.hpp"
+#include "GPUVK_Staging.hpp"
 
 
+#include "Core/IO/FileWatcher.hpp"
+#include "Core/IO/Streaming.hpp"
+#include "Core/IO/VFS.hpp"
 #include "Dev/Console.hpp"
 
 #if VulkanAPI_Interface == VaultedVulkan_Interface
@@ -38,16 +45,41 @@
 				ptr<ARenderable> TriangleDemo_Renderable;
 				ptr<ARenderable> ModelWTexur_Renderable;
 
-				using ImageBytes = stbi_uc;
+				// Beside the model, its vertices are rewritten every frame through a dynamic vertex buffer.
+				ptr<ARenderable> DebugQuad_Renderable;
 
-				ImageBytes* ModelWTxtur_TxtImage;
+				DynamicArray<Vertex_WTexture> DebugQuad_Verticies;
 
-				int Model_TxtWidth, Model_TxtHeight, Model_TxtChannels;
+				DynamicArray<u8> ModelWTxtur_TxtImage;
+
+				u32 Model_TxtWidth, Model_TxtHeight;
+
+				// Streamed in, the renderable is created once both are resident.
+				Core::IO::StreamAssetID ModelWTxtur_ModelAsset   = Core::IO::InvalidStreamAsset;
+				Core::IO::StreamAssetID ModelWTxtur_TextureAsset = Core::IO::InvalidStreamAsset;
+
+				// Bounds of the demo model, for its streaming hint.
+				constexpr f32 ModelWTxtur_Radius = 1.0f;
+
+				// Reloads the model and texture when their sources change on disk.
+				Core::IO::SubscriptionID ModelWTxtur_SourceChanges = 0;
 
 
 
 			void SetRenderContext();
 
+			void OnModelStreamed(Core::IO::StreamAssetID _asset, DynamicArray<u8>&& _source);
+
+			void OnTextureStreamed(Core::IO::StreamAssetID _asset, DynamicArray<u8>&& _source);
+
+			void CreateModelRenderable();
+
+			void CreateDebugQuad();
+
+			void UpdateDebugQuad(f32 _time, UniformBufferObject _ubo);
+
+			void Reload_ChangedAssets(const DynamicArray<Core::IO::FileChange>& _changes);
+
 			void Start_GPUVK_Demo(ptr<OSAL::Window> _window)
 			{
 				GPUVKDemo_Surface = getPtr(Rendering::Request_Surface(_window));
@@ -63,23 +95,29 @@
 				ModelWTxtur_Shader.Create
 				(
 					String(Renderer::Shader::Paths::VKTut) + "VertexShaderV5.vert",
-					String(Renderer::Shader::Paths::VKTut) + "FragmentShaderV5.frag",
+					String(Renderer::Shader::Paths::VKTut) + (Bindless::IsEnabled() ? "FragmentShaderV5_Bindless.frag" : "FragmentShaderV5.frag"),
 					sizeof(UniformBufferObject)
 				);
 
-				LoadModel(VikingRoom_ModelPath);
+				// Read on the IO workers, decoded and uploaded on the master cycler when they complete.
+				Core::IO::StreamAsset model;
 
-				ModelWTxtur_TxtImage = stbi_load(VikingRoom_TexturePath.c_str(), &Model_TxtWidth, &Model_TxtHeight, &Model_TxtChannels, STBI_rgb_alpha);
+				model.Path     = VikingRoom_ModelPath;
+				model.OnLoaded = OnModelStreamed;
 
-				ModelWTexur_Renderable = GPU_Resources::Request_Renderable
-				(
-					ModelVerticies,
-					ModelIndicies,
-					ModelWTxtur_TxtImage, Model_TxtWidth, Model_TxtHeight,
-					getPtr(ModelWTxtur_Shader)
-				);
+				Core::IO::StreamAsset texture;
 
-				GPUVKDemo_Context->AddRenderable(ModelWTexur_Renderable);
+				texture.Path     = VikingRoom_TexturePath;
+				texture.OnLoaded = OnTextureStreamed;
+
+				ModelWTxtur_ModelAsset   = Core::IO::Streaming_Register(move(model  ));
+				ModelWTxtur_TextureAsset = Core::IO::Streaming_Register(move(texture));
+
+				// In view from the first frame.
+				Core::IO::Streaming_Require(ModelWTxtur_ModelAsset  );
+				Core::IO::Streaming_Require(ModelWTxtur_TextureAsset);
+
+				ModelWTxtur_SourceChanges = Core::IO::FileWatcher_Subscribe(Reload_ChangedAssets);
 
 				//AddTestCallback();
 
@@ -111,7 +149,21 @@
 			{
 				Log("Stopping Clear Color Demo...");
 
-				stbi_image_free(ModelWTxtur_TxtImage);
+				Core::IO::FileWatcher_Unsubscribe(ModelWTxtur_SourceChanges);
+
+				ModelWTxtur_SourceChanges = 0;
+
+				Core::IO::Streaming_Unregister(ModelWTxtur_ModelAsset  );
+				Core::IO::Streaming_Unregister(ModelWTxtur_TextureAsset);
+
+				ModelWTxtur_ModelAsset   = Core::IO::InvalidStreamAsset;
+				ModelWTxtur_TextureAsset = Core::IO::InvalidStreamAsset;
+
+				ModelWTxtur_TxtImage = DynamicArray<u8>();
+
+				DebugQuad_Verticies = DynamicArray<Vertex_WTexture>();
+
+				ModelWTxtur_Shader.Destroy();
 
 				Rendering::Retire_RenderContext(GPUVKDemo_Context);
 				Rendering::Retire_SwapChain    (GPUVKDemo_Swap   );
@@ -161,16 +213,176 @@
 
 				ubo.ModelSpace = glm::rotate(glm::mat4(1.0f), time * glm::radians(25.0f), glm::vec3(0.0f, 0.0f, 0.5f));
 
-				ubo.Viewport = glm::lookAt(glm::vec3(1.7f, 1.7f, 1.7f), glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f));   // The default
+				glm::vec3 eye(1.7f, 1.7f, 1.7f);
+
+				ubo.Viewport = glm::lookAt(eye, glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f));   // The default
 				//ubo.Viewport = glm::lookAt(glm::vec3(0.5f, 0.5f, 0.0f), glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f)); crying cat
 
-				ubo.Projection = glm::perspective(glm::radians(45.0f), GPUVKDemo_Swap->GetExtent().Width / (float) GPUVKDemo_Swap->GetExtent().Height, 0.1f, 10.0f);
+				f32 fieldOfView = glm::radians(45.0f);
+
+				ubo.Projection = glm::perspective(fieldOfView, GPUVKDemo_Swap->GetExtent().Width / (float) GPUVKDemo_Swap->GetExtent().Height, 0.1f, 10.0f);
 
 				ubo.Projection[1][1] *= -1;
 
+				// What the camera sees of the model decides how much its assets matter to the streamer.
+				Core::IO::StreamHint hint;
+
+				hint.Distance   = glm::length(eye);
+				hint.ScreenSize = std::min(ModelWTxtur_Radius / (hint.Distance * std::tan(fieldOfView * 0.5f)), 1.0f);
+
+				Core::IO::Streaming_Hint(ModelWTxtur_ModelAsset  , hint);
+				Core::IO::Streaming_Hint(ModelWTxtur_TextureAsset, hint);
+
+				// Not streamed in yet.
+				if (ModelWTexur_Renderable == nullptr) return;
+
 				const void* address = &ubo;
 
 				ModelWTexur_Renderable->UpdateUniforms(address, sizeof(ubo));
+
+				UpdateDebugQuad(time, ubo);
+			}
+
+			void UpdateDebugQuad(f32 _time, UniformBufferObject _ubo)
+			{
+				if (DebugQuad_Renderable == nullptr) return;
+
+				// Pulses in place, only the corners move.
+				f32 scale = 0.25f + 0.1f * std::sin(_time * 2.0f);
+
+				for (uDM index = 0; index < DebugQuad_Verticies.size(); index++)
+				{
+					DebugQuad_Verticies[index].Position.X = SquareVerticies[index].Position.X * 2.0f * scale;
+					DebugQuad_Verticies[index].Position.Y = SquareVerticies[index].Position.Y * 2.0f * scale;
+				}
+
+				ptr<TModelRenderable<Vertex_WTexture>> quad = SCast<TModelRenderable<Vertex_WTexture>>(DebugQuad_Renderable);
+
+				quad->WriteVertices(0, DebugQuad_Verticies.data(), DebugQuad_Verticies.size());
+
+				// Before Rendering::Update submits the upload.
+				quad->Flush();
+
+				_ubo.ModelSpace = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+
+				const void* address = &_ubo;
+
+				DebugQuad_Renderable->UpdateUniforms(address, sizeof(_ubo));
+			}
+
+			void OnModelStreamed(Core::IO::StreamAssetID /* _asset */, DynamicArray<u8>&& _source)
+			{
+				try
+				{
+					ModelVerticies.clear();
+					ModelIndicies .clear();
+
+					LoadModel(_source);
+				}
+				catch (std::exception& _error)
+				{
+					Log_Error(String("Demo model: ") + _error.what());
+
+					return;
+				}
+
+				if (ModelWTexur_Renderable != nullptr)
+				{
+					SCast<TModelRenderable<Vertex_WTexture>>(ModelWTexur_Renderable)->ReplaceGeometry(ModelVerticies, ModelIndicies);
+
+					return;
+				}
+
+				CreateModelRenderable();
+			}
+
+			void OnTextureStreamed(Core::IO::StreamAssetID /* _asset */, DynamicArray<u8>&& _source)
+			{
+				try
+				{
+					ModelWTxtur_TxtImage = LoadTexture(_source, Model_TxtWidth, Model_TxtHeight);
+				}
+				catch (std::exception& _error)
+				{
+					Log_Error(String("Demo texture: ") + _error.what());
+
+					return;
+				}
+
+				if (ModelWTexur_Renderable != nullptr)
+				{
+					SCast<TModelRenderable<Vertex_WTexture>>(ModelWTexur_Renderable)->ReplaceTexture(ModelWTxtur_TxtImage.data(), Model_TxtWidth, Model_TxtHeight);
+
+					if (DebugQuad_Renderable != nullptr)
+						SCast<TModelRenderable<Vertex_WTexture>>(DebugQuad_Renderable)->ReplaceTexture(ModelWTxtur_TxtImage.data(), Model_TxtWidth, Model_TxtHeight);
+
+					return;
+				}
+
+				CreateModelRenderable();
+			}
+
+			void CreateModelRenderable()
+			{
+				if (ModelWTexur_Renderable != nullptr || ModelVerticies.empty() || ModelWTxtur_TxtImage.empty()) return;
+
+				ModelWTexur_Renderable = GPU_Resources::Request_Renderable
+				(
+					ModelVerticies,
+					ModelIndicies,
+					ModelWTxtur_TxtImage.data(), Model_TxtWidth, Model_TxtHeight,
+					getPtr(ModelWTxtur_Shader)
+				);
+
+				GPUVKDemo_Context->AddRenderable(ModelWTexur_Renderable);
+
+				CreateDebugQuad();
+			}
+
+			void CreateDebugQuad()
+			{
+				// The front face of the square.
+				DebugQuad_Verticies.assign(SquareVerticies.begin(), SquareVerticies.begin() + 4);
+
+				DynamicArray<u32> indices(SquareIndices.begin(), SquareIndices.begin() + 6);
+
+				DebugQuad_Renderable = GPU_Resources::Request_Renderable
+				(
+					DebugQuad_Verticies,
+					indices,
+					ModelWTxtur_TxtImage.data(), Model_TxtWidth, Model_TxtHeight,
+					getPtr(ModelWTxtur_Shader),
+					EBufferUpdate::Dynamic
+				);
+
+				GPUVKDemo_Context->AddRenderable(DebugQuad_Renderable);
+			}
+
+			void Reload_ChangedAssets(const DynamicArray<Core::IO::FileChange>& _changes)
+			{
+				bool modelChanged = false, textureChanged = false;
+
+				for (auto& change : _changes)
+				{
+					String virtualPath;
+
+					if (change.Change == Core::IO::EFileChange::Removed || !Core::IO::VFS_ToVirtualPath(change.File, virtualPath)) continue;
+
+					modelChanged   |= virtualPath == Core::IO::PackNormalizePath(VikingRoom_ModelPath  );
+					textureChanged |= virtualPath == Core::IO::PackNormalizePath(VikingRoom_TexturePath);
+				}
+
+				// Read here rather than streamed, the resident copies are the ones being replaced.
+				try
+				{
+					if (modelChanged  ) OnModelStreamed  (ModelWTxtur_ModelAsset  , Core::IO::VFS_Read(VikingRoom_ModelPath  ));
+					if (textureChanged) OnTextureStreamed(ModelWTxtur_TextureAsset, Core::IO::VFS_Read(VikingRoom_TexturePath));
+				}
+				catch (std::exception& _error)
+				{
+					// Still being written, the next change reloads it.
+					Log_Error(String("Demo asset reload: ") + _error.what());
+				}
 			}
 
 			// GPU_HAL
@@ -186,12 +398,30 @@
 				GPU_Comms::EngageMostSuitableDevice();
 
 				Deck::Prepare();
+
+				Staging::Prepare();
+
+				Bindless::Prepare();
+
+				Defragmenter::Prepare();
 			}
 
 			void Cease_GPUComms()
 			{
+				Defragmenter::Wipe();
+
+				Bindless::Wipe();
+
+				Staging::Wipe();
+
+				// Uploads into the pools may be in flight until staging is wiped.
+				Geometry::Wipe();
+
 				Deck::Wipe();
 
+				// Whatever is still bound goes with the device.
+				WipeMemory();
+
 				GPU_Comms::Cease();	
 			}
 
@@ -7,6 +7,12 @@
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb/stb_image.h"
 
+#include "Core/IO/DerivedDataCache.hpp"
+#include "Core/IO/VFS.hpp"
+
+#include <cstring>
+#include <sstream>
+
 
 
 namespace HAL::GPU::Vulkan
@@ -36,7 +42,8 @@ namespace HAL::GPU::Vulkan
 
 
 
-	void LoadModel(String _modelPath)
+	// Cooked: [vertex count (u64)][vertices][indices], the indices start at 0.
+	DynamicArray<u8> CookModel(const DynamicArray<u8>& _source)
 	{
 		tinyobj::attrib_t attrib;
 
@@ -46,9 +53,15 @@ namespace HAL::GPU::Vulkan
 
 		String warning, error;
 
-		if (!tinyobj::LoadObj(&attrib, &shapes, &materials, &warning, &error, _modelPath.c_str()))
+		// Parsed from memory, materials are not used so no material reader is given.
+		std::istringstream stream(String(RCast<const char>(_source.data()), _source.size()));
+
+		if (!tinyobj::LoadObj(&attrib, &shapes, &materials, &warning, &error, &stream))
 			throw RuntimeError(warning + error);
 
+		DynamicArray<Vertex_WTexture> vertices;
+		DynamicArray<u32>             indices ;
+
 		for (const auto& shape : shapes)
 		{
 			for (const auto& index : shape.mesh.indices)
@@ -70,9 +83,103 @@ namespace HAL::GPU::Vulkan
 
 				vertex.Color = { 1.0f, 1.0f, 1.0f };
 
-				ModelVerticies.push_back(vertex);
-				ModelIndicies.push_back(SCast<u32>(ModelIndicies.size()));
+				vertices.push_back(vertex);
+				indices .push_back(SCast<u32>(indices.size()));
 			}
 		}
+
+		u64 vertexCount = vertices.size();
+
+		DynamicArray<u8> cooked(sizeof(vertexCount) + vertices.size() * sizeof(Vertex_WTexture) + indices.size() * sizeof(u32));
+
+		ptr<u8> cursor = cooked.data();
+
+		memcpy(cursor, &vertexCount    , sizeof(vertexCount)                      ); cursor += sizeof(vertexCount);
+		memcpy(cursor, vertices.data(), vertices.size() * sizeof(Vertex_WTexture)); cursor += vertices.size() * sizeof(Vertex_WTexture);
+		memcpy(cursor, indices .data(), indices .size() * sizeof(u32)            );
+
+		return cooked;
+	}
+
+	void LoadModel(const String& _modelPath)
+	{
+		LoadModel(Core::IO::VFS_Read(_modelPath));
+	}
+
+	void LoadModel(const DynamicArray<u8>& _source)
+	{
+		Core::IO::DerivedDataKey cacheKey("OBJ Vertices", 1);
+
+		cacheKey.Add(_source.data(), _source.size()).AddValue(sizeof(Vertex_WTexture));
+
+		DynamicArray<u8> cooked = Core::IO::DDC_GetOrCook(cacheKey, [&_source]() { return CookModel(_source); });
+
+		u64 vertexCount;
+
+		memcpy(&vertexCount, cooked.data(), sizeof(vertexCount));
+
+		uDM vertexBytes = uDM(vertexCount) * sizeof(Vertex_WTexture);
+		uDM indexCount  = (cooked.size() - sizeof(vertexCount) - vertexBytes) / sizeof(u32);
+
+		uDM firstVertex = ModelVerticies.size();
+		uDM firstIndex  = ModelIndicies .size();
+
+		ModelVerticies.resize(firstVertex + uDM(vertexCount));
+		ModelIndicies .resize(firstIndex  + indexCount);
+
+		memcpy(ModelVerticies.data() + firstVertex, cooked.data() + sizeof(vertexCount)              , vertexBytes             );
+		memcpy(ModelIndicies .data() + firstIndex , cooked.data() + sizeof(vertexCount) + vertexBytes, indexCount * sizeof(u32));
+
+		// Indices are relative to the model, the vertices continue from the ones already loaded.
+		for (uDM index = firstIndex; index < ModelIndicies.size(); index++) ModelIndicies[index] += SCast<u32>(firstVertex);
+	}
+
+	DynamicArray<u8> LoadTexture(const String& _texturePath, u32& _width, u32& _height)
+	{
+		return LoadTexture(Core::IO::VFS_Read(_texturePath), _width, _height);
+	}
+
+	DynamicArray<u8> LoadTexture(const DynamicArray<u8>& _source, u32& _width, u32& _height)
+	{
+		Core::IO::DerivedDataKey cacheKey("Texture RGBA8", 1);
+
+		cacheKey.Add(_source.data(), _source.size());
+
+		// Cooked: [width (u32)][height (u32)][RGBA8 pixels].
+		DynamicArray<u8> cooked = Core::IO::DDC_GetOrCook
+		(
+			cacheKey,
+
+			[&_source]()
+			{
+				int width, height, channels;
+
+				ptr<stbi_uc> pixels = stbi_load_from_memory(_source.data(), int(_source.size()), &width, &height, &channels, STBI_rgb_alpha);
+
+				if (pixels == nullptr) throw RuntimeError(String("Failed to load texture: ") + stbi_failure_reason());
+
+				u32 dimensions[2] = { u32(width), u32(height) };
+
+				DynamicArray<u8> result(sizeof(dimensions) + uDM(width) * uDM(height) * 4);
+
+				memcpy(result.data()                     , dimensions, sizeof(dimensions)                 );
+				memcpy(result.data() + sizeof(dimensions), pixels    , result.size() - sizeof(dimensions));
+
+				stbi_image_free(pixels);
+
+				return result;
+			}
+		);
+
+		u32 dimensions[2];
+
+		memcpy(dimensions, cooked.data(), sizeof(dimensions));
+
+		_width  = dimensions[0];
+		_height = dimensions[1];
+
+		cooked.erase(cooked.begin(), cooked.begin() + sizeof(dimensions));
+
+		return cooked;
 	}
 }
\ No newline at end of file
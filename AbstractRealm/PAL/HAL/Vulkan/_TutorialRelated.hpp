@@ -222,7 +222,25 @@ namespace HAL::GPU
 		//)
 
 
-			void LoadModel(String _modelPath);
+			/*
+			Appends the OBJ model at _modelPath (a virtual path) to ModelVerticies and ModelIndicies.
+			*/
+			void LoadModel(const String& _modelPath);
+
+			/*
+			Same, from the contents of the OBJ file.
+			*/
+			void LoadModel(const DynamicArray<u8>& _source);
+
+			/*
+			Decodes the image at _texturePath (a virtual path) to RGBA8 (through the derived data cache).
+			*/
+			DynamicArray<u8> LoadTexture(const String& _texturePath, u32& _width, u32& _height);
+
+			/*
+			Same, from the contents of the image file.
+			*/
+			DynamicArray<u8> LoadTexture(const DynamicArray<u8>& _source, u32& _width, u32& _height);
 			
 	}
 }
\ No newline at end of file
@@ -10,6 +10,9 @@ Operating System Abstraction Layer
 
 #include "OSAL_Platform.hpp"
 #include "OSAL_Console.hpp"
+#include "OSAL_FileMapping.hpp"
+#include "OSAL_FileWatch.hpp"
+#include "OSAL_FileWrite.hpp"
 #include "OSAL_Hardware.hpp"
 #include "OSAL_Timing.hpp"
 #include "OSAL_Threading.hpp"
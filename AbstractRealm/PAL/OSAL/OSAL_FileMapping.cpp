@@ -0,0 +1,211 @@
+// Parent Header
+#include "OSAL_FileMapping.hpp"
+
+
+
+#ifndef _WIN32
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+
+
+namespace OSAL
+{
+	// Windows
+
+#ifdef _WIN32
+
+	bool MapFile(const Path& _path, EMapAccess _access, uDM _size, FileMapping& _mapping)
+	{
+		bool readWrite = _access == EMapAccess::ReadWrite;
+
+		_mapping.Access = _access;
+
+		_mapping.File = CreateFileW
+		(
+			_path.c_str(),
+			readWrite ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ,
+			FILE_SHARE_READ,
+			nullptr,
+			readWrite ? OPEN_ALWAYS : OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL,
+			nullptr
+		);
+
+		if (_mapping.File == INVALID_HANDLE_VALUE) return false;
+
+		if (!readWrite)
+		{
+			LARGE_INTEGER fileSize;
+
+			if (!GetFileSizeEx(_mapping.File, &fileSize))
+			{
+				UnmapFile(_mapping);
+
+				return false;
+			}
+
+			_size = uDM(fileSize.QuadPart);
+		}
+
+		// Empty files cannot be mapped, an empty view is still a valid result.
+		if (_size == 0) return true;
+
+		// Mapping with a larger size than the file grows the file.
+		_mapping.Mapping = CreateFileMappingW
+		(
+			_mapping.File,
+			nullptr,
+			readWrite ? PAGE_READWRITE : PAGE_READONLY,
+			DWORD(u64(_size) >> 32),
+			DWORD(u64(_size) & 0xFFFFFFFF),
+			nullptr
+		);
+
+		if (_mapping.Mapping == nullptr)
+		{
+			UnmapFile(_mapping);
+
+			return false;
+		}
+
+		_mapping.Address = MapViewOfFile(_mapping.Mapping, readWrite ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, _size);
+
+		if (_mapping.Address == nullptr)
+		{
+			UnmapFile(_mapping);
+
+			return false;
+		}
+
+		_mapping.Size = _size;
+
+		return true;
+	}
+
+	void UnmapFile(FileMapping& _mapping)
+	{
+		if (_mapping.Address != nullptr) UnmapViewOfFile(_mapping.Address);
+
+		if (_mapping.Mapping != nullptr            ) CloseHandle(_mapping.Mapping);
+		if (_mapping.File    != INVALID_HANDLE_VALUE) CloseHandle(_mapping.File   );
+
+		_mapping = FileMapping();
+	}
+
+	void FlushMapping(const FileMapping& _mapping, uDM _offset, uDM _size)
+	{
+		if (_mapping.Address == nullptr) return;
+
+		FlushViewOfFile(RCast<u8>(_mapping.Address) + _offset, _size);
+	}
+
+	void AdviseMapping(const FileMapping& _mapping, uDM _offset, uDM _size, EMapAdvice _advice)
+	{
+		if (_mapping.Address == nullptr || _advice != EMapAdvice::WillNeed) return;
+
+		// Windows has no equivalent for the access pattern hints, only prefetching.
+		WIN32_MEMORY_RANGE_ENTRY range;
+
+		range.VirtualAddress = RCast<u8>(_mapping.Address) + _offset;
+		range.NumberOfBytes  = _size;
+
+		PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+	}
+
+#else
+
+	// POSIX
+
+	bool MapFile(const Path& _path, EMapAccess _access, uDM _size, FileMapping& _mapping)
+	{
+		bool readWrite = _access == EMapAccess::ReadWrite;
+
+		_mapping.Access = _access;
+
+		_mapping.File = open(_path.c_str(), readWrite ? O_RDWR | O_CREAT : O_RDONLY, 0644);
+
+		if (_mapping.File < 0) return false;
+
+		struct stat fileStatus;
+
+		if (fstat(_mapping.File, &fileStatus) != 0)
+		{
+			UnmapFile(_mapping);
+
+			return false;
+		}
+
+		if (!readWrite)
+		{
+			_size = uDM(fileStatus.st_size);
+		}
+		else if (uDM(fileStatus.st_size) < _size && ftruncate(_mapping.File, off_t(_size)) != 0)
+		{
+			UnmapFile(_mapping);
+
+			return false;
+		}
+
+		if (_size == 0) return true;
+
+		ptr<void> address = mmap(nullptr, _size, readWrite ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, _mapping.File, 0);
+
+		if (address == MAP_FAILED)
+		{
+			UnmapFile(_mapping);
+
+			return false;
+		}
+
+		_mapping.Address = address;
+		_mapping.Size    = _size  ;
+
+		return true;
+	}
+
+	void UnmapFile(FileMapping& _mapping)
+	{
+		if (_mapping.Address != nullptr) munmap(_mapping.Address, _mapping.Size);
+
+		if (_mapping.File >= 0) close(_mapping.File);
+
+		_mapping = FileMapping();
+	}
+
+	void FlushMapping(const FileMapping& _mapping, uDM _offset, uDM _size)
+	{
+		if (_mapping.Address == nullptr) return;
+
+		// msync requires a page aligned address.
+		uDM pageSize = uDM(sysconf(_SC_PAGESIZE));
+		uDM start    = _offset - (_offset % pageSize);
+
+		msync(RCast<u8>(_mapping.Address) + start, _size + (_offset - start), MS_ASYNC);
+	}
+
+	void AdviseMapping(const FileMapping& _mapping, uDM _offset, uDM _size, EMapAdvice _advice)
+	{
+		if (_mapping.Address == nullptr) return;
+
+		int advice = MADV_NORMAL;
+
+		switch (_advice)
+		{
+			case EMapAdvice::Normal    : advice = MADV_NORMAL    ; break;
+			case EMapAdvice::Sequential: advice = MADV_SEQUENTIAL; break;
+			case EMapAdvice::Random    : advice = MADV_RANDOM    ; break;
+			case EMapAdvice::WillNeed  : advice = MADV_WILLNEED  ; break;
+		}
+
+		uDM pageSize = uDM(sysconf(_SC_PAGESIZE));
+		uDM start    = _offset - (_offset % pageSize);
+
+		madvise(RCast<u8>(_mapping.Address) + start, _size + (_offset - start), advice);
+	}
+
+#endif
+}
@@ -0,0 +1,81 @@
+/*
+OSAL_FileMapping
+
+Maps files directly into the address space of the process.
+
+Writes to a read-write mapping land in the page cache, so the OS persists them even if the process dies.
+*/
+
+
+#pragma once
+
+
+
+#include "OSAL_Platform.hpp"
+
+
+
+namespace OSAL
+{
+	using namespace LAL;
+
+
+
+	// Enums
+
+	enum class EMapAccess
+	{
+		ReadOnly,
+		ReadWrite
+	};
+
+	enum class EMapAdvice
+	{
+		Normal    ,
+		Sequential,   // Read ahead aggressively, pages behind the cursor can be dropped.
+		Random    ,   // Don't read ahead.
+		WillNeed      // Prefetch the range now.
+	};
+
+
+
+	// Structs
+
+	struct FileMapping
+	{
+		ptr<void> Address = nullptr;
+		uDM       Size    = 0;
+
+		EMapAccess Access = EMapAccess::ReadOnly;
+
+	#ifdef _WIN32
+		HANDLE File    = INVALID_HANDLE_VALUE;
+		HANDLE Mapping = nullptr;
+	#else
+		int File = -1;
+	#endif
+	};
+
+
+
+	// Functions
+
+	/*
+	Maps the file at _path.
+
+	ReadOnly : The file must exist, _size is ignored and the whole file is mapped.
+	ReadWrite: The file is created if needed and grown to _size.
+	*/
+	bool MapFile(const Path& _path, EMapAccess _access, uDM _size, FileMapping& _mapping);
+
+	void UnmapFile(FileMapping& _mapping);
+
+	/*
+	Schedules the dirty pages within the range to be written back.
+
+	Not required for crash safety (the page cache survives the process), only for power loss.
+	*/
+	void FlushMapping(const FileMapping& _mapping, uDM _offset, uDM _size);
+
+	void AdviseMapping(const FileMapping& _mapping, uDM _offset, uDM _size, EMapAdvice _advice);
+}
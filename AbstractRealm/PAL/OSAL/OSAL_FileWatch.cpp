@@ -0,0 +1,254 @@
+// Parent Header
+#include "OSAL_FileWatch.hpp"
+
+
+
+#ifndef _WIN32
+	#include <cerrno>
+	#include <sys/inotify.h>
+	#include <unistd.h>
+#endif
+
+
+
+namespace OSAL
+{
+	// Windows
+
+#ifdef _WIN32
+
+	sInternal constexpr DWORD WatchFilter =
+		FILE_NOTIFY_CHANGE_FILE_NAME  |
+		FILE_NOTIFY_CHANGE_DIR_NAME   |
+		FILE_NOTIFY_CHANGE_SIZE       |
+		FILE_NOTIFY_CHANGE_LAST_WRITE |
+		FILE_NOTIFY_CHANGE_CREATION   ;
+
+	sInternal bool IssueRead(DirectoryWatch& _watch)
+	{
+		ResetEvent(_watch.Event);
+
+		return ReadDirectoryChangesW
+		(
+			_watch.Directory,
+			_watch.Buffer.data(),
+			DWORD(_watch.Buffer.size() * sizeof(u32)),
+			_watch.Recursive,
+			WatchFilter,
+			nullptr,
+			&_watch.Overlapped,
+			nullptr
+		);
+	}
+
+	bool WatchDirectory(const Path& _directory, bool _recursive, DirectoryWatch& _watch)
+	{
+		_watch.Root      = _directory;
+		_watch.Recursive = _recursive;
+
+		_watch.Directory = CreateFileW
+		(
+			_directory.c_str(),
+			FILE_LIST_DIRECTORY,
+			FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+			nullptr,
+			OPEN_EXISTING,
+			FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED,
+			nullptr
+		);
+
+		if (_watch.Directory == INVALID_HANDLE_VALUE) return false;
+
+		_watch.Event = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+
+		_watch.Overlapped        = {};
+		_watch.Overlapped.hEvent = _watch.Event;
+
+		_watch.Buffer.resize(16 * 1024);   // 64 KB, the limit for network shares.
+
+		if (_watch.Event == nullptr || !IssueRead(_watch))
+		{
+			CloseWatch(_watch);
+
+			return false;
+		}
+
+		return true;
+	}
+
+	void CloseWatch(DirectoryWatch& _watch)
+	{
+		if (_watch.Directory != INVALID_HANDLE_VALUE)
+		{
+			DWORD bytes;
+
+			// The pending read must be done with the buffer before it goes away.
+			if (CancelIoEx(_watch.Directory, &_watch.Overlapped)) GetOverlappedResult(_watch.Directory, &_watch.Overlapped, &bytes, TRUE);
+
+			CloseHandle(_watch.Directory);
+		}
+
+		if (_watch.Event != nullptr) CloseHandle(_watch.Event);
+
+		_watch = DirectoryWatch();
+	}
+
+	bool PollDirectoryChanges(DirectoryWatch& _watch, DynamicArray<DirectoryChange>& _changes)
+	{
+		if (_watch.Directory == INVALID_HANDLE_VALUE) return false;
+
+		DWORD bytes = 0;
+
+		if (!GetOverlappedResult(_watch.Directory, &_watch.Overlapped, &bytes, FALSE))
+		{
+			return GetLastError() == ERROR_IO_INCOMPLETE;
+		}
+
+		// A completed read with nothing in it means the buffer overflowed.
+		if (bytes == 0)
+		{
+			_changes.push_back({ _watch.Root, EDirectoryChange::Overflow });
+		}
+		else
+		{
+			ptr<const u8> cursor = RCast<const u8>(_watch.Buffer.data());
+
+			while (true)
+			{
+				auto& info = *RCast<const FILE_NOTIFY_INFORMATION>(cursor);
+
+				Path file = _watch.Root / std::wstring(info.FileName, info.FileNameLength / sizeof(WCHAR));
+
+				switch (info.Action)
+				{
+					case FILE_ACTION_ADDED           :
+					case FILE_ACTION_RENAMED_NEW_NAME: _changes.push_back({ file, EDirectoryChange::Added    }); break;
+					case FILE_ACTION_REMOVED         :
+					case FILE_ACTION_RENAMED_OLD_NAME: _changes.push_back({ file, EDirectoryChange::Removed  }); break;
+					case FILE_ACTION_MODIFIED        : _changes.push_back({ file, EDirectoryChange::Modified }); break;
+				}
+
+				if (info.NextEntryOffset == 0) break;
+
+				cursor += info.NextEntryOffset;
+			}
+		}
+
+		return IssueRead(_watch);
+	}
+
+#else
+
+	// Linux (inotify)
+
+	sInternal constexpr u32 WatchMask =
+		IN_CREATE      |
+		IN_DELETE      |
+		IN_MODIFY      |
+		IN_CLOSE_WRITE |
+		IN_MOVED_FROM  |
+		IN_MOVED_TO    |
+		IN_DELETE_SELF ;
+
+	sInternal void AddWatches(DirectoryWatch& _watch, const Path& _directory)
+	{
+		int descriptor = inotify_add_watch(_watch.Notify, _directory.c_str(), WatchMask);
+
+		if (descriptor >= 0) _watch.Watches[descriptor] = _directory;
+
+		if (!_watch.Recursive) return;
+
+		std::error_code error;
+
+		for (std::filesystem::directory_iterator entry(_directory, error), end; !error && entry != end; entry.increment(error))
+		{
+			std::error_code entryError;
+
+			if (entry->is_directory(entryError) && !entry->is_symlink(entryError)) AddWatches(_watch, entry->path());
+		}
+	}
+
+	bool WatchDirectory(const Path& _directory, bool _recursive, DirectoryWatch& _watch)
+	{
+		_watch.Root      = _directory;
+		_watch.Recursive = _recursive;
+
+		_watch.Notify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+		if (_watch.Notify < 0) return false;
+
+		AddWatches(_watch, _directory);
+
+		if (_watch.Watches.empty())
+		{
+			CloseWatch(_watch);
+
+			return false;
+		}
+
+		return true;
+	}
+
+	void CloseWatch(DirectoryWatch& _watch)
+	{
+		// Closing the instance drops every watch descriptor with it.
+		if (_watch.Notify >= 0) close(_watch.Notify);
+
+		_watch = DirectoryWatch();
+	}
+
+	bool PollDirectoryChanges(DirectoryWatch& _watch, DynamicArray<DirectoryChange>& _changes)
+	{
+		if (_watch.Notify < 0) return false;
+
+		alignas(inotify_event) char buffer[16 * 1024];
+
+		while (true)
+		{
+			ssize_t length = read(_watch.Notify, buffer, sizeof(buffer));
+
+			if (length <= 0) return length == 0 || errno == EAGAIN;
+
+			for (ssize_t offset = 0; offset < length;)
+			{
+				auto& event = *RCast<const inotify_event>(buffer + offset);
+
+				offset += sizeof(inotify_event) + event.len;
+
+				if (event.mask & IN_Q_OVERFLOW)
+				{
+					_changes.push_back({ _watch.Root, EDirectoryChange::Overflow });
+
+					continue;
+				}
+
+				auto directory = _watch.Watches.find(event.wd);
+
+				if (directory == _watch.Watches.end()) continue;
+
+				if (event.mask & (IN_DELETE_SELF | IN_IGNORED))
+				{
+					_watch.Watches.erase(directory);
+
+					continue;
+				}
+
+				Path file = event.len > 0 ? directory->second / event.name : directory->second;
+
+				if (event.mask & IN_ISDIR)
+				{
+					// New directories need their own watch, their contents show up as they are added.
+					if (_watch.Recursive && (event.mask & (IN_CREATE | IN_MOVED_TO))) AddWatches(_watch, file);
+
+					continue;
+				}
+
+				if      (event.mask & (IN_CREATE | IN_MOVED_TO  )) _changes.push_back({ file, EDirectoryChange::Added    });
+				else if (event.mask & (IN_DELETE | IN_MOVED_FROM)) _changes.push_back({ file, EDirectoryChange::Removed  });
+				else                                               _changes.push_back({ file, EDirectoryChange::Modified });
+			}
+		}
+	}
+
+#endif
+}
@@ -0,0 +1,73 @@
+/*
+OSAL_FileWatch
+
+Change notifications for a directory tree (ReadDirectoryChangesW on Windows, inotify elsewhere).
+
+Polling is non-blocking, the caller decides the rate and does any debouncing.
+*/
+
+
+#pragma once
+
+
+
+#include "OSAL_Platform.hpp"
+
+
+
+namespace OSAL
+{
+	using namespace LAL;
+
+
+
+	// Enums
+
+	enum class EDirectoryChange
+	{
+		Added   ,
+		Removed ,
+		Modified,
+		Overflow    // Changes were dropped by the OS, the whole tree has to be rescanned.
+	};
+
+
+
+	// Structs
+
+	struct DirectoryChange
+	{
+		Path             File;
+		EDirectoryChange Change;
+	};
+
+	struct DirectoryWatch
+	{
+		Path Root;
+		bool Recursive = true;
+
+	#ifdef _WIN32
+		HANDLE            Directory  = INVALID_HANDLE_VALUE;
+		HANDLE            Event      = nullptr;
+		OVERLAPPED        Overlapped = {};
+		DynamicArray<u32> Buffer;   // DWORD aligned, as ReadDirectoryChangesW requires.
+	#else
+		int                     Notify = -1;
+		UnorderedMap<int, Path> Watches;   // Watch descriptor -> directory (inotify is not recursive).
+	#endif
+	};
+
+
+
+	// Functions
+
+	bool WatchDirectory(const Path& _directory, bool _recursive, DirectoryWatch& _watch);
+
+	void CloseWatch(DirectoryWatch& _watch);
+
+	/*
+	Appends the changes reported since the last poll to _changes, never blocks.
+	Returns false if the watch is broken (the directory is gone).
+	*/
+	bool PollDirectoryChanges(DirectoryWatch& _watch, DynamicArray<DirectoryChange>& _changes);
+}
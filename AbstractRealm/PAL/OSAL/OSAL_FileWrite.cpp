@@ -0,0 +1,144 @@
+// Parent Header
+#include "OSAL_FileWrite.hpp"
+
+
+
+#ifndef _WIN32
+	#include <cerrno>
+	#include <climits>
+	#include <fcntl.h>
+	#include <sys/uio.h>
+	#include <unistd.h>
+#endif
+
+
+
+namespace OSAL
+{
+	// Windows
+
+#ifdef _WIN32
+
+	bool OpenOutputFile(const Path& _path, OutputFile& _file)
+	{
+		_file.File = CreateFileW
+		(
+			_path.c_str(),
+			GENERIC_WRITE,
+			FILE_SHARE_READ,
+			nullptr,
+			CREATE_ALWAYS,
+			FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+			nullptr
+		);
+
+		return _file.File != INVALID_HANDLE_VALUE;
+	}
+
+	void CloseOutputFile(OutputFile& _file)
+	{
+		if (_file.File != INVALID_HANDLE_VALUE) CloseHandle(_file.File);
+
+		_file = OutputFile();
+	}
+
+	bool WriteGather(OutputFile& _file, ptr<const WriteSpan> _spans, uDM _count)
+	{
+		// WriteFileGather needs unbuffered handles and page sized spans, plain writes are close enough through the cache.
+		for (uDM index = 0; index < _count; index++)
+		{
+			ptr<const u8> data      = RCast<const u8>(_spans[index].Data);
+			uDM           remaining = _spans[index].Size;
+
+			while (remaining > 0)
+			{
+				DWORD chunk = DWORD(std::min<uDM>(remaining, 1u << 30));
+				DWORD written;
+
+				if (!WriteFile(_file.File, data, chunk, &written, nullptr) || written == 0) return false;
+
+				data      += written;
+				remaining -= written;
+			}
+		}
+
+		return true;
+	}
+
+#else
+
+	// POSIX
+
+	bool OpenOutputFile(const Path& _path, OutputFile& _file)
+	{
+		_file.File = open(_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+		return _file.File >= 0;
+	}
+
+	void CloseOutputFile(OutputFile& _file)
+	{
+		if (_file.File >= 0) close(_file.File);
+
+		_file = OutputFile();
+	}
+
+	bool WriteGather(OutputFile& _file, ptr<const WriteSpan> _spans, uDM _count)
+	{
+		StaticArray<iovec, 64> vectors;
+
+		uDM next = 0;   // First span not yet in vectors.
+
+		uDM count = 0, first = 0;
+
+		while (true)
+		{
+			// Refill behind what is still pending.
+			if (first > 0)
+			{
+				std::move(vectors.begin() + first, vectors.begin() + count, vectors.begin());
+
+				count -= first;
+				first  = 0;
+			}
+
+			for (; next < _count && count < vectors.size(); next++)
+			{
+				if (_spans[next].Size == 0) continue;
+
+				vectors[count++] = { const_cast<ptr<void>>(_spans[next].Data), _spans[next].Size };
+			}
+
+			if (count == 0) return true;
+
+			ssize_t written = writev(_file.File, vectors.data(), int(std::min<uDM>(count, IOV_MAX)));
+
+			if (written < 0)
+			{
+				if (errno == EINTR) continue;
+
+				return false;
+			}
+
+			// Partial writes are legal, skip what made it out.
+			for (uDM remaining = uDM(written); remaining > 0;)
+			{
+				if (remaining >= vectors[first].iov_len)
+				{
+					remaining -= vectors[first].iov_len;
+
+					first++;
+				}
+				else
+				{
+					vectors[first].iov_base  = RCast<u8>(vectors[first].iov_base) + remaining;
+					vectors[first].iov_len  -= remaining;
+
+					remaining = 0;
+				}
+			}
+		}
+	}
+
+#endif
+}
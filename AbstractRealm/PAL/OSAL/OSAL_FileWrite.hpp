@@ -0,0 +1,56 @@
+/*
+OSAL_FileWrite
+
+Unbuffered (by the process) sequential file output, the only copy made is into the page cache.
+
+Gathered writes go out as a single system call where the OS supports it (writev).
+*/
+
+
+#pragma once
+
+
+
+#include "OSAL_Platform.hpp"
+
+
+
+namespace OSAL
+{
+	using namespace LAL;
+
+
+
+	// Structs
+
+	struct OutputFile
+	{
+	#ifdef _WIN32
+		HANDLE File = INVALID_HANDLE_VALUE;
+	#else
+		int File = -1;
+	#endif
+	};
+
+	struct WriteSpan
+	{
+		ptr<const void> Data;
+		uDM             Size;
+	};
+
+
+
+	// Functions
+
+	/*
+	Creates the file at _path, an existing one is truncated.
+	*/
+	bool OpenOutputFile(const Path& _path, OutputFile& _file);
+
+	void CloseOutputFile(OutputFile& _file);
+
+	/*
+	Appends the spans, in order. Returns false if not everything could be written.
+	*/
+	bool WriteGather(OutputFile& _file, ptr<const WriteSpan> _spans, uDM _count);
+}
@@ -0,0 +1,280 @@
+// Parent Header
+#include "OSAL_ReadRing.hpp"
+
+
+
+#ifdef __linux__
+	#include <cerrno>
+	#include <cstring>
+	#include <fcntl.h>
+	#include <linux/io_uring.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <sys/syscall.h>
+	#include <unistd.h>
+#endif
+
+
+
+namespace OSAL
+{
+	// Linux (io_uring)
+
+#ifdef __linux__
+
+	// No wrappers in the C library, liburing is not a dependency.
+	sInternal int IOUring_Setup(u32 _entries, io_uring_params& _params)
+	{
+		return int(syscall(__NR_io_uring_setup, _entries, &_params));
+	}
+
+	sInternal int IOUring_Enter(int _ring, u32 _submit, u32 _complete, u32 _flags)
+	{
+		return int(syscall(__NR_io_uring_enter, _ring, _submit, _complete, _flags, nullptr, 0));
+	}
+
+	// The ring indices are shared with the kernel, the tails publish the entries written before them.
+	sInternal u32 LoadAcquire(ptr<const u32> _index)
+	{
+		return __atomic_load_n(_index, __ATOMIC_ACQUIRE);
+	}
+
+	sInternal void StoreRelease(ptr<u32> _index, u32 _value)
+	{
+		__atomic_store_n(_index, _value, __ATOMIC_RELEASE);
+	}
+
+	sInternal ptr<void> MapRing(int _ring, uDM _size, u64 _offset)
+	{
+		ptr<void> address = mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring, off_t(_offset));
+
+		return address == MAP_FAILED ? nullptr : address;
+	}
+
+	sInternal ptr<io_uring_sqe> AcquireEntry(ReadRing& _ring)
+	{
+		u32 tail = *_ring.SubmitTail;
+
+		if (tail - LoadAcquire(_ring.SubmitHead) >= _ring.Depth) return nullptr;
+
+		ptr<io_uring_sqe> entry = RCast<io_uring_sqe>(_ring.Entries) + (tail & _ring.SubmitMask);
+
+		memset(entry, 0, sizeof(io_uring_sqe));
+
+		return entry;
+	}
+
+	sInternal bool PublishEntry(ReadRing& _ring)
+	{
+		u32 tail  = *_ring.SubmitTail;
+		u32 index = tail & _ring.SubmitMask;
+
+		_ring.SubmitArray[index] = index;
+
+		StoreRelease(_ring.SubmitTail, tail + 1);
+
+		while (true)
+		{
+			int submitted = IOUring_Enter(_ring.Ring, 1, 0, 0);
+
+			if (submitted >= 0) return submitted == 1;
+
+			if (errno != EINTR) return false;
+		}
+	}
+
+	bool OpenReadRing(u32 _depth, ReadRing& _ring)
+	{
+		io_uring_params params;
+
+		memset(&params, 0, sizeof(params));
+
+		int ring = IOUring_Setup(_depth, params);
+
+		// Without it on the kernel (or blocked by a seccomp filter) the reads stay blocking.
+		if (ring < 0) return false;
+
+		// Plain reads (IORING_OP_READ) came with the same kernel as reads at the current position.
+		if ((params.features & IORING_FEAT_RW_CUR_POS) == 0)
+		{
+			close(ring);
+
+			return false;
+		}
+
+		_ring.Ring = ring;
+
+		_ring.SubmitSize   = params.sq_off.array + params.sq_entries * sizeof(u32);
+		_ring.CompleteSize = params.cq_off.cqes  + params.cq_entries * sizeof(io_uring_cqe);
+
+		bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+
+		if (singleMap) _ring.SubmitSize = _ring.CompleteSize = std::max(_ring.SubmitSize, _ring.CompleteSize);
+
+		_ring.SubmitMap   = MapRing(ring, _ring.SubmitSize, IORING_OFF_SQ_RING);
+		_ring.CompleteMap = singleMap ? _ring.SubmitMap : MapRing(ring, _ring.CompleteSize, IORING_OFF_CQ_RING);
+
+		_ring.EntriesSize = params.sq_entries * sizeof(io_uring_sqe);
+		_ring.Entries     = MapRing(ring, _ring.EntriesSize, IORING_OFF_SQES);
+
+		if (_ring.SubmitMap == nullptr || _ring.CompleteMap == nullptr || _ring.Entries == nullptr)
+		{
+			CloseReadRing(_ring);
+
+			return false;
+		}
+
+		ptr<u8> submit   = RCast<u8>(_ring.SubmitMap  );
+		ptr<u8> complete = RCast<u8>(_ring.CompleteMap);
+
+		_ring.SubmitHead  =  RCast<u32>(submit + params.sq_off.head     );
+		_ring.SubmitTail  =  RCast<u32>(submit + params.sq_off.tail     );
+		_ring.SubmitArray =  RCast<u32>(submit + params.sq_off.array    );
+		_ring.SubmitMask  = *RCast<u32>(submit + params.sq_off.ring_mask);
+
+		_ring.CompleteHead =  RCast<u32>(complete + params.cq_off.head     );
+		_ring.CompleteTail =  RCast<u32>(complete + params.cq_off.tail     );
+		_ring.CompleteMask = *RCast<u32>(complete + params.cq_off.ring_mask);
+		_ring.Completions  =  complete + params.cq_off.cqes;
+
+		// The completion queue is twice as deep, it cannot overflow while no more than this are in flight.
+		_ring.Depth = params.sq_entries;
+
+		return true;
+	}
+
+	void CloseReadRing(ReadRing& _ring)
+	{
+		if (_ring.Entries != nullptr) munmap(_ring.Entries, _ring.EntriesSize);
+
+		if (_ring.CompleteMap != nullptr && _ring.CompleteMap != _ring.SubmitMap) munmap(_ring.CompleteMap, _ring.CompleteSize);
+
+		if (_ring.SubmitMap != nullptr) munmap(_ring.SubmitMap, _ring.SubmitSize);
+
+		if (_ring.Ring >= 0) close(_ring.Ring);
+
+		_ring = ReadRing();
+	}
+
+	bool OpenRingFile(const Path& _path, ReadRingFile& _file)
+	{
+		_file.File = open(_path.c_str(), O_RDONLY | O_CLOEXEC);
+
+		if (_file.File < 0) return false;
+
+		struct stat status;
+
+		if (fstat(_file.File, &status) != 0)
+		{
+			CloseRingFile(_file);
+
+			return false;
+		}
+
+		_file.Size = u64(status.st_size);
+
+		return true;
+	}
+
+	void CloseRingFile(ReadRingFile& _file)
+	{
+		if (_file.File >= 0) close(_file.File);
+
+		_file = ReadRingFile();
+	}
+
+	bool SubmitRead(ReadRing& _ring, const ReadRingFile& _file, u64 _offset, ptr<void> _destination, u32 _size, u64 _tag)
+	{
+		ptr<io_uring_sqe> entry = AcquireEntry(_ring);
+
+		if (entry == nullptr) return false;
+
+		entry->opcode    = IORING_OP_READ;
+		entry->fd        = _file.File;
+		entry->off       = _offset;
+		entry->addr      = u64(uIntPtr(_destination));
+		entry->len       = _size;
+		entry->user_data = _tag;
+
+		return PublishEntry(_ring);
+	}
+
+	bool WakeReadRing(ReadRing& _ring)
+	{
+		ptr<io_uring_sqe> entry = AcquireEntry(_ring);
+
+		if (entry == nullptr) return false;
+
+		entry->opcode    = IORING_OP_NOP;
+		entry->user_data = ReadRing_WakeTag;
+
+		return PublishEntry(_ring);
+	}
+
+	uDM ReapReads(ReadRing& _ring, DynamicArray<ReadRingCompletion>& _completions, bool _wait)
+	{
+		u32 head = *_ring.CompleteHead;
+
+		if (_wait && head == LoadAcquire(_ring.CompleteTail))
+		{
+			while (IOUring_Enter(_ring.Ring, 0, 1, IORING_ENTER_GETEVENTS) < 0 && errno == EINTR) {}
+		}
+
+		u32 tail = LoadAcquire(_ring.CompleteTail);
+
+		uDM reaped = 0;
+
+		for (; head != tail; head++, reaped++)
+		{
+			const io_uring_cqe& completion = RCast<const io_uring_cqe>(_ring.Completions)[head & _ring.CompleteMask];
+
+			_completions.push_back({ completion.user_data, s64(completion.res) });
+		}
+
+		// Hands the slots back to the kernel.
+		StoreRelease(_ring.CompleteHead, head);
+
+		return reaped;
+	}
+
+#else
+
+	// Elsewhere: no ring, the callers read with blocking calls.
+
+	bool OpenReadRing(u32 /* _depth */, ReadRing& /* _ring */)
+	{
+		return false;
+	}
+
+	void CloseReadRing(ReadRing& _ring)
+	{
+		_ring = ReadRing();
+	}
+
+	bool OpenRingFile(const Path& /* _path */, ReadRingFile& /* _file */)
+	{
+		return false;
+	}
+
+	void CloseRingFile(ReadRingFile& _file)
+	{
+		_file = ReadRingFile();
+	}
+
+	bool SubmitRead(ReadRing& /* _ring */, const ReadRingFile& /* _file */, u64 /* _offset */, ptr<void> /* _destination */, u32 /* _size */, u64 /* _tag */)
+	{
+		return false;
+	}
+
+	bool WakeReadRing(ReadRing& /* _ring */)
+	{
+		return false;
+	}
+
+	uDM ReapReads(ReadRing& /* _ring */, DynamicArray<ReadRingCompletion>& /* _completions */, bool /* _wait */)
+	{
+		return 0;
+	}
+
+#endif
+}
@@ -0,0 +1,110 @@
+/*
+OSAL_ReadRing
+
+Asynchronous file reads through a queue shared with the kernel (io_uring on Linux 5.6 and later).
+
+Reads are submitted without blocking and their completions are reaped in any order, so a single thread
+can keep the device busy instead of a thread per read. Where the OS has no such queue opening a ring fails,
+and the caller reads with blocking calls instead (Windows: IoRing needs Windows 11, it is not used yet).
+
+A ring has one submitter and one reaper at a time, they may be different threads.
+*/
+
+
+#pragma once
+
+
+
+#include "OSAL_Platform.hpp"
+
+
+
+namespace OSAL
+{
+	using namespace LAL;
+
+
+
+	// Structs
+
+	struct ReadRing
+	{
+	#ifdef __linux__
+		int Ring = -1;
+
+		ptr<void> SubmitMap    = nullptr;
+		uDM       SubmitSize   = 0;
+		ptr<void> CompleteMap  = nullptr;   // The same as SubmitMap when the kernel maps both rings at once.
+		uDM       CompleteSize = 0;
+		ptr<void> Entries      = nullptr;   // Submission queue entries.
+		uDM       EntriesSize  = 0;
+
+		ptr<u32> SubmitHead  = nullptr;
+		ptr<u32> SubmitTail  = nullptr;
+		ptr<u32> SubmitArray = nullptr;
+		u32      SubmitMask  = 0;
+
+		ptr<u32>  CompleteHead = nullptr;
+		ptr<u32>  CompleteTail = nullptr;
+		ptr<void> Completions  = nullptr;
+		u32       CompleteMask = 0;
+	#endif
+
+		u32 Depth = 0;   // Reads that can be in flight at once.
+	};
+
+	struct ReadRingFile
+	{
+	#ifdef _WIN32
+		HANDLE File = INVALID_HANDLE_VALUE;
+	#else
+		int File = -1;
+	#endif
+
+		u64 Size = 0;
+	};
+
+	struct ReadRingCompletion
+	{
+		u64 Tag;
+		s64 Result;   // Bytes read, or a negative error code.
+	};
+
+	// Tag of the completion WakeReadRing produces.
+	constexpr u64 ReadRing_WakeTag = 0;
+
+
+
+	// Functions
+
+	/*
+	Returns false if the OS or kernel has no read ring, _ring is then left closed.
+	*/
+	bool OpenReadRing(u32 _depth, ReadRing& _ring);
+
+	/*
+	Only once every submitted read has been reaped.
+	*/
+	void CloseReadRing(ReadRing& _ring);
+
+	bool OpenRingFile(const Path& _path, ReadRingFile& _file);
+
+	void CloseRingFile(ReadRingFile& _file);
+
+	/*
+	Reads _size bytes at _offset of _file into _destination, completing with _tag.
+	Returns false if the ring is full or the submission failed. A read may complete short.
+	*/
+	bool SubmitRead(ReadRing& _ring, const ReadRingFile& _file, u64 _offset, ptr<void> _destination, u32 _size, u64 _tag);
+
+	/*
+	Submits an empty operation, wakes a reaper waiting on the ring.
+	*/
+	bool WakeReadRing(ReadRing& _ring);
+
+	/*
+	Appends the finished reads to _completions, waiting for at least one if _wait is set.
+	Returns the number appended.
+	*/
+	uDM ReapReads(ReadRing& _ring, DynamicArray<ReadRingCompletion>& _completions, bool _wait);
+}
@@ -0,0 +1,27 @@
+#version 450
+
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_EXT_nonuniform_qualifier     : enable
+
+
+
+layout(location = 0) in vec3 FragColor;
+
+layout(location = 1) in vec2 FragTextureCoordinate;
+
+layout(location = 0) out vec4 OutColor;
+
+// Bindless descriptor arrays, see GPUVK_Bindless.hpp.
+layout(set = 1, binding = 0) uniform sampler2D Textures[];
+
+layout(push_constant) uniform BindlessIndices
+{
+    uint Texture;
+    uint Buffer;
+} Indices;
+
+
+void main() 
+{
+    OutColor = texture(Textures[nonuniformEXT(Indices.Texture)], FragTextureCoordinate);
+}
\ No newline at end of file